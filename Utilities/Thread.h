@@ -178,6 +178,9 @@ public:
 	// Get CPU cycles since last time this function was called. First call returns 0.
 	u64 get_cycles();
 
+	// Get total CPU cycles consumed by the thread, in the same units as get_cycles(). Returns 0 on failure.
+	u64 get_cpu_time() const;
+
 	// Wait for the thread (it does NOT change thread state, and can be called from multiple threads)
 	bool join(bool dtor = false) const;
 
@@ -252,6 +255,12 @@ public:
 		return static_cast<thread_base&>(thread).get_cycles();
 	}
 
+	template <typename T>
+	static u64 get_cpu_time(const named_thread<T>& thread)
+	{
+		return static_cast<const thread_base&>(thread).get_cpu_time();
+	}
+
 	template <typename T>
 	static void notify(named_thread<T>& thread)
 	{
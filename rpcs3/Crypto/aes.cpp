@@ -772,6 +772,16 @@ int aes_crypt_cbc( aes_context *ctx,
 
     if( mode == AES_DECRYPT )
     {
+#if defined(__SSE2__) || defined(_M_X64)
+        if( aesni_supports( POLARSSL_AESNI_AES ) )
+        {
+            const size_t done = aesni_crypt_cbc_dec4( ctx, length, iv, input, output );
+            input  += done;
+            output += done;
+            length -= done;
+        }
+#endif
+
         while( length > 0 )
         {
             memcpy( temp, input, 16 );
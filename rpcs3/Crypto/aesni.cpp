@@ -131,6 +131,102 @@ int aesni_crypt_ecb( aes_context *ctx,
     return( 0 );
 }
 
+/*
+ * AES-NI AES-CBC decryption, four independent blocks per round key load.
+ * Unlike CBC encryption, every block only depends on ciphertext, so the
+ * aesdec latency of one block is hidden behind the others.
+ */
+size_t aesni_crypt_cbc_dec4( aes_context *ctx,
+                             size_t length,
+                             unsigned char iv[16],
+                             const unsigned char *input,
+                             unsigned char *output )
+{
+    size_t done = 0;
+    unsigned char cipher[64];
+    unsigned char plain[64];
+    int i;
+
+    for( ; length - done >= 64; done += 64 )
+    {
+        // Keep a copy of the ciphertext, output may alias input
+        memcpy( cipher, input + done, 64 );
+
+#if defined(POLARSSL_HAVE_MSVC_X64_INTRINSICS)
+        __m128i* rk = (__m128i*)ctx->rk;
+        __m128i k = _mm_loadu_si128( rk++ );
+        __m128i a = _mm_xor_si128( _mm_loadu_si128( (__m128i*)cipher + 0 ), k );
+        __m128i b = _mm_xor_si128( _mm_loadu_si128( (__m128i*)cipher + 1 ), k );
+        __m128i c = _mm_xor_si128( _mm_loadu_si128( (__m128i*)cipher + 2 ), k );
+        __m128i d = _mm_xor_si128( _mm_loadu_si128( (__m128i*)cipher + 3 ), k );
+
+        for (i = ctx->nr - 1; i; --i)
+        {
+            k = _mm_loadu_si128( rk++ );
+            a = _mm_aesdec_si128( a, k );
+            b = _mm_aesdec_si128( b, k );
+            c = _mm_aesdec_si128( c, k );
+            d = _mm_aesdec_si128( d, k );
+        }
+
+        k = _mm_loadu_si128( rk );
+        _mm_storeu_si128( (__m128i*)plain + 0, _mm_aesdeclast_si128( a, k ) );
+        _mm_storeu_si128( (__m128i*)plain + 1, _mm_aesdeclast_si128( b, k ) );
+        _mm_storeu_si128( (__m128i*)plain + 2, _mm_aesdeclast_si128( c, k ) );
+        _mm_storeu_si128( (__m128i*)plain + 3, _mm_aesdeclast_si128( d, k ) );
+#else
+        int nr = ctx->nr;
+        const uint32_t* rk = ctx->rk;
+
+        // Volatile, the updated counters are not used afterwards
+        asm volatile( "movdqu    (%1), %%xmm4    \n" // load round key 0
+                      "movdqu    (%2), %%xmm0    \n" // load input
+                      "movdqu    16(%2), %%xmm1  \n"
+                      "movdqu    32(%2), %%xmm2  \n"
+                      "movdqu    48(%2), %%xmm3  \n"
+                      "pxor      %%xmm4, %%xmm0  \n" // round 0
+                      "pxor      %%xmm4, %%xmm1  \n"
+                      "pxor      %%xmm4, %%xmm2  \n"
+                      "pxor      %%xmm4, %%xmm3  \n"
+                      "addq      $16, %1         \n" // point to next round key
+                      "subl      $1, %0          \n" // normal rounds = nr - 1
+
+                      "1:                        \n" // decryption loop
+                      "movdqu    (%1), %%xmm4    \n"
+                      "aesdec    %%xmm4, %%xmm0  \n"
+                      "aesdec    %%xmm4, %%xmm1  \n"
+                      "aesdec    %%xmm4, %%xmm2  \n"
+                      "aesdec    %%xmm4, %%xmm3  \n"
+                      "addq      $16, %1         \n"
+                      "subl      $1, %0          \n"
+                      "jnz       1b              \n"
+                      "movdqu    (%1), %%xmm4    \n" // load round key
+                      "aesdeclast %%xmm4, %%xmm0 \n" // last round
+                      "aesdeclast %%xmm4, %%xmm1 \n"
+                      "aesdeclast %%xmm4, %%xmm2 \n"
+                      "aesdeclast %%xmm4, %%xmm3 \n"
+
+                      "movdqu    %%xmm0, (%3)    \n" // export output
+                      "movdqu    %%xmm1, 16(%3)  \n"
+                      "movdqu    %%xmm2, 32(%3)  \n"
+                      "movdqu    %%xmm3, 48(%3)  \n"
+                      : "+r" (nr), "+r" (rk)
+                      : "r" (cipher), "r" (plain)
+                      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4" );
+#endif /* POLARSSL_HAVE_MSVC_X64_INTRINSICS */
+
+        for( i = 0; i < 16; i++ )
+            output[done + i] = plain[i] ^ iv[i];
+
+        for( i = 16; i < 64; i++ )
+            output[done + i] = plain[i] ^ cipher[i - 16];
+
+        memcpy( iv, cipher + 48, 16 );
+    }
+
+    return( done );
+}
+
 #if defined(POLARSSL_HAVE_MSVC_X64_INTRINSICS)
 static inline void clmul256( __m128i a, __m128i b, __m128i* r0, __m128i* r1 )
 {
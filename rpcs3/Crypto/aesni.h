@@ -61,6 +61,24 @@ int aesni_crypt_ecb( aes_context *ctx,
                      const unsigned char input[16],
                      unsigned char output[16] );
 
+/**
+ * \brief          AES-NI AES-CBC decryption of four blocks at a time
+ *
+ * \param ctx      AES context (decryption round keys)
+ * \param length   length of the input data
+ * \param iv       initialization vector (updated after use)
+ * \param input    buffer holding the input data
+ * \param output   buffer holding the output data (may alias input)
+ *
+ * \return         number of bytes processed, a multiple of 64. The
+ *                 remaining tail is left to the caller.
+ */
+size_t aesni_crypt_cbc_dec4( aes_context *ctx,
+                             size_t length,
+                             unsigned char iv[16],
+                             const unsigned char *input,
+                             unsigned char *output );
+
 /**
  * \brief          GCM multiplication: c = a * b in GF(2^128)
  *
@@ -7,6 +7,7 @@
 #include "utils.h"
 
 #include "Emu/system_utils.hpp"
+#include "Utilities/Thread.h"
 
 #include "util/asm.hpp"
 #include <algorithm>
@@ -882,6 +883,167 @@ bool EDATADecrypter::ReadHeader()
 	return true;
 }
 
+EDATADecrypter::EDATADecrypter(fs::file&& input, u128 dec_key, std::string file_name, bool is_key_final) noexcept
+	: m_edata_file(std::move(input))
+	, edata_file(m_edata_file)
+	, m_file_name(std::move(file_name))
+	, m_is_key_final(is_key_final)
+	, dec_key(dec_key)
+{
+}
+
+EDATADecrypter::EDATADecrypter(const fs::file& input, u128 dec_key, std::string file_name, bool is_key_final) noexcept
+	: m_edata_file(fs::file{})
+	, edata_file(input)
+	, m_file_name(std::move(file_name))
+	, m_is_key_final(is_key_final)
+	, dec_key(dec_key)
+{
+}
+
+EDATADecrypter::~EDATADecrypter()
+{
+	// Join the prefetch thread before the file it reads from goes away
+	m_prefetch_thread.reset();
+}
+
+void EDATADecrypter::finish_prefetch()
+{
+	if (!m_prefetch_state)
+	{
+		return;
+	}
+
+	while (m_prefetch_state == 1)
+	{
+		m_prefetch_state.wait(1);
+	}
+
+	for (decrypted_block& prefetched : m_prefetched_blocks)
+	{
+		if (prefetched.index == umax)
+		{
+			// Decryption failed, leave it to the regular path to report
+			break;
+		}
+
+		if (std::any_of(m_block_cache.begin(), m_block_cache.end(), [&](const decrypted_block& block) { return block.index == prefetched.index; }))
+		{
+			continue;
+		}
+
+		decrypted_block& slot = *std::min_element(m_block_cache.begin(), m_block_cache.end(), FN(x.last_use < y.last_use));
+		std::swap(slot, prefetched);
+		slot.last_use = ++m_cache_clock;
+	}
+
+	m_prefetched_blocks.clear();
+	m_prefetch_start = 0;
+	m_prefetch_end = 0;
+	m_prefetch_state = 0;
+}
+
+void EDATADecrypter::start_prefetch(u32 first_block)
+{
+	if (m_prefetch_state)
+	{
+		return;
+	}
+
+	const auto is_cached = [&](u32 index)
+	{
+		return std::any_of(m_block_cache.begin(), m_block_cache.end(), [&](const decrypted_block& block) { return block.index == index; });
+	};
+
+	u32 start = first_block;
+
+	while (start < total_blocks && is_cached(start))
+	{
+		start++;
+	}
+
+	// Wait until at most half a batch of blocks is left ahead of the reader
+	if (start >= total_blocks || start - first_block >= prefetch_block_count / 2)
+	{
+		return;
+	}
+
+	m_prefetch_start = start;
+	m_prefetch_end = std::min<u32>(start + prefetch_block_count, total_blocks);
+	m_prefetched_blocks.resize(m_prefetch_end - m_prefetch_start);
+
+	if (!m_prefetch_thread)
+	{
+		m_prefetch_thread = std::make_unique<named_thread<std::function<void()>>>("EDAT Prefetch Thread", [this]()
+		{
+			while (thread_ctrl::state() != thread_state::aborting)
+			{
+				if (const u32 state = m_prefetch_state; state != 1)
+				{
+					thread_ctrl::wait_on(m_prefetch_state, state);
+					continue;
+				}
+
+				for (u32 i = 0; i < m_prefetched_blocks.size(); i++)
+				{
+					decrypted_block& block = m_prefetched_blocks[i];
+					block.data.resize(edatHeader.block_size + 16);
+
+					const s64 res = decrypt_block(edata_file, block.data, edatHeader, npdHeader, reinterpret_cast<const u8*>(&dec_key), m_prefetch_start + i, total_blocks, edatHeader.file_size, true);
+
+					if (res < 0)
+					{
+						break;
+					}
+
+					block.index = m_prefetch_start + i;
+					block.size = res;
+				}
+
+				m_prefetch_state = 2;
+				m_prefetch_state.notify_all();
+			}
+		});
+	}
+
+	m_prefetch_state = 1;
+	m_prefetch_state.notify_all();
+}
+
+const EDATADecrypter::decrypted_block* EDATADecrypter::get_block(u32 index)
+{
+	if (m_prefetch_state && index >= m_prefetch_start && index < m_prefetch_end)
+	{
+		finish_prefetch();
+	}
+
+	for (decrypted_block& block : m_block_cache)
+	{
+		if (block.index == index)
+		{
+			block.last_use = ++m_cache_clock;
+			return &block;
+		}
+	}
+
+	// Evict the least recently used block
+	decrypted_block& slot = *std::min_element(m_block_cache.begin(), m_block_cache.end(), FN(x.last_use < y.last_use));
+	slot.index = umax;
+	slot.data.resize(edatHeader.block_size + 16);
+
+	const s64 res = decrypt_block(edata_file, slot.data, edatHeader, npdHeader, reinterpret_cast<const u8*>(&dec_key), index, total_blocks, edatHeader.file_size, true);
+
+	if (res < 0)
+	{
+		return nullptr;
+	}
+
+	slot.index = index;
+	slot.size = res;
+	slot.last_use = ++m_cache_clock;
+	return &slot;
+}
+
 u64 EDATADecrypter::ReadData(u64 pos, u8* data, u64 size)
 {
 	size = std::min<u64>(size, pos > edatHeader.file_size ? 0 : edatHeader.file_size - pos);
@@ -891,6 +1053,8 @@ u64 EDATADecrypter::ReadData(u64 pos, u8* data, u64 size)
 		return 0;
 	}
 
+	std::lock_guard lock(m_cache_mutex);
+
 	// Now we need to offset things to account for the actual 'range' requested
 	const u64 startOffset = pos % edatHeader.block_size;
 
@@ -902,18 +1066,17 @@ u64 EDATADecrypter::ReadData(u64 pos, u8* data, u64 size)
 
 	u64 writeOffset = 0;
 
-	std::vector<u8> data_buf(edatHeader.block_size + 16);
-
 	for (u32 i = starting_block; i < ending_block; i++)
 	{
-		u64 res = decrypt_block(edata_file, data_buf, edatHeader, npdHeader, reinterpret_cast<u8*>(&dec_key), i, total_blocks, edatHeader.file_size, true);
+		const decrypted_block* block = get_block(i);
 
-		if (res == umax)
+		if (!block)
 		{
 			edat_log.error("Error Decrypting data");
 			return 0;
 		}
 
+		const u64 res = block->size;
 		const usz skip_start = (i == starting_block ? startOffset : 0);
 
 		if (skip_start >= res)
@@ -924,11 +1087,19 @@ u64 EDATADecrypter::ReadData(u64 pos, u8* data, u64 size)
 		const usz end_pos = (i != total_blocks - 1 ? edatHeader.block_size : (edatHeader.file_size - 1) % edatHeader.block_size + 1);
 		const usz read_end = std::min<usz>(res, i == ending_block - 1 ? std::min<usz>(end_pos, (startOffset + size - 1) % edatHeader.block_size + 1) : end_pos);
 
-		std::memcpy(data + writeOffset, data_buf.data() + skip_start, read_end - skip_start);
-		std::memset(data_buf.data(), 0, read_end - skip_start);
+		std::memcpy(data + writeOffset, block->data.data() + skip_start, read_end - skip_start);
 
 		writeOffset += read_end - skip_start;
 	}
 
+	// Streaming reads continue in the same or the following block, decrypt ahead of them
+	m_sequential_reads = (starting_block == m_last_block || starting_block == m_last_block + 1) ? m_sequential_reads + 1 : 0;
+	m_last_block = ending_block - 1;
+
+	if (m_sequential_reads >= 2)
+	{
+		start_prefetch(ending_block);
+	}
+
 	return writeOffset;
 }
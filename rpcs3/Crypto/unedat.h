@@ -1,7 +1,13 @@
 #pragma once
 
 #include <array>
+#include <functional>
+#include <memory>
 #include "Utilities/File.h"
+#include "Utilities/mutex.h"
+
+template <typename T>
+class named_thread;
 
 constexpr u32 SDAT_FLAG = 0x01000000;
 constexpr u32 EDAT_COMPRESSED_FLAG = 0x00000001;
@@ -88,24 +94,42 @@ struct EDATADecrypter final : fs::file_base
 
 	u128 dec_key{};
 
-public:
-	EDATADecrypter(fs::file&& input, u128 dec_key = {}, std::string file_name = {}, bool is_key_final = true) noexcept
-		: m_edata_file(std::move(input))
-		, edata_file(m_edata_file)
-		, m_file_name(std::move(file_name))
-		, m_is_key_final(is_key_final)
-		, dec_key(dec_key)
+	struct decrypted_block
 	{
-	}
+		u32 index = umax;
+		u64 size = 0; // Decrypted size, may be smaller than the block size for the last block
+		u64 last_use = 0;
+		std::vector<u8> data;
+	};
+
+	// Small LRU of decrypted blocks, games often read a block in many small pieces
+	static constexpr usz block_cache_size = 16;
+
+	// Blocks decrypted ahead on a worker thread once reads become sequential
+	static constexpr u32 prefetch_block_count = 8;
+
+	shared_mutex m_cache_mutex;
+	std::array<decrypted_block, block_cache_size> m_block_cache{};
+	u64 m_cache_clock = 0;
+	u32 m_last_block = umax;
+	u32 m_sequential_reads = 0;
+
+	// Persistent worker, created on the first streaming read and fed one batch at a time
+	std::unique_ptr<named_thread<std::function<void()>>> m_prefetch_thread;
+	atomic_t<u32> m_prefetch_state = 0; // 0: idle, 1: batch queued, 2: batch done
+	std::vector<decrypted_block> m_prefetched_blocks;
+	u32 m_prefetch_start = 0;
+	u32 m_prefetch_end = 0;
+
+	const decrypted_block* get_block(u32 index);
+	void finish_prefetch();
+	void start_prefetch(u32 first_block);
 
-	EDATADecrypter(const fs::file& input, u128 dec_key = {}, std::string file_name = {}, bool is_key_final = true) noexcept
-		: m_edata_file(fs::file{})
-		, edata_file(input)
-		, m_file_name(std::move(file_name))
-		, m_is_key_final(is_key_final)
-		, dec_key(dec_key)
-	{
-	}
+public:
+	// Defined out of line, the prefetch thread type is incomplete here
+	EDATADecrypter(fs::file&& input, u128 dec_key = {}, std::string file_name = {}, bool is_key_final = true) noexcept;
+	EDATADecrypter(const fs::file& input, u128 dec_key = {}, std::string file_name = {}, bool is_key_final = true) noexcept;
+	~EDATADecrypter() override;
 
 	// false if invalid
 	bool ReadHeader();
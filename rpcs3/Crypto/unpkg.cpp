@@ -1567,6 +1567,91 @@ usz package_reader::decrypt(u64 offset, u64 size, const uchar* key, std::span<u8
 	return std::min<usz>(size, data_span.size());
 }
 
+bool package_reader::get_entries(std::vector<entry_info>& result)
+{
+	result.clear();
+
+	std::vector<PKGEntry> entries;
+
+	if (!m_is_valid || !read_entries(entries))
+	{
+		return false;
+	}
+
+	std::map<std::string, usz, std::less<>> indices;
+
+	for (const PKGEntry& entry : entries)
+	{
+		if (entry.name_size > PKG_MAX_FILENAME_SIZE)
+		{
+			pkg_log.error("PKG name size is too big (size=0x%x, offset=0x%x)", entry.name_size, entry.name_offset);
+			return false;
+		}
+
+		const bool is_psp = (entry.type & PKG_FILE_ENTRY_PSP) != 0u;
+
+		std::string name_buf(entry.name_size + BUF_PADDING, '\0');
+
+		if (decrypt(entry.name_offset, entry.name_size, is_psp ? PKG_AES_KEY2 : m_dec_key.data(), std::span<u8>{reinterpret_cast<u8*>(name_buf.data()), name_buf.size()}) < entry.name_size)
+		{
+			pkg_log.error("PKG name could not be read (size=0x%x, offset=0x%x)", entry.name_size, entry.name_offset);
+			return false;
+		}
+
+		std::string name{fmt::trim_back_sv(name_buf, "\0"sv)};
+
+		if (const auto found = indices.find(name); found != indices.end())
+		{
+			// Same rule as fill_data(): only overwriting entries replace an earlier one
+			if (entry.type & PKG_FILE_ENTRY_OVERWRITE)
+			{
+				result[found->second] = {std::move(name), entry.file_offset, entry.file_size, entry.type};
+			}
+
+			continue;
+		}
+
+		indices.emplace(name, result.size());
+		result.push_back({std::move(name), entry.file_offset, entry.file_size, entry.type});
+	}
+
+	return true;
+}
+
+u64 package_reader::read_data(u64 offset, void* buffer, u64 size, bool is_psp)
+{
+	// The stream cipher works on whole 16-byte blocks
+	static thread_local std::vector<u8> s_buf;
+
+	u64 done = 0;
+
+	while (done < size)
+	{
+		const u64 pos = offset + done;
+		const u64 skip = pos % sizeof(u128);
+		const u64 block_size = std::min<u64>(BUF_SIZE - skip, size - done);
+
+		s_buf.resize(skip + block_size + BUF_PADDING);
+
+		const usz read_size = decrypt(pos - skip, skip + block_size, is_psp ? PKG_AES_KEY2 : m_dec_key.data(), s_buf);
+
+		if (read_size <= skip)
+		{
+			break;
+		}
+
+		std::memcpy(static_cast<u8*>(buffer) + done, s_buf.data() + skip, read_size - skip);
+		done += read_size - skip;
+
+		if (read_size != skip + block_size)
+		{
+			break;
+		}
+	}
+
+	return done;
+}
+
 int package_reader::get_progress(int maximum) const
 {
 	const usz wr = m_written_bytes;
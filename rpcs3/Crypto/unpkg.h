@@ -354,6 +354,15 @@ class package_reader
 	};
 
 public:
+	// Decrypted directory entry, used to read the package without installing it
+	struct entry_info
+	{
+		std::string name;
+		u64 file_offset{};
+		u64 file_size{};
+		u32 type{};
+	};
+
 	package_reader(const std::string& path, fs::file file = {});
 	~package_reader();
 
@@ -385,6 +394,14 @@ public:
 		return m_file;
 	}
 
+	const std::string& get_install_dir() const { return m_install_dir; }
+
+	// Lists the entries with decrypted names. Entries sharing a name resolve the same way as during installation.
+	bool get_entries(std::vector<entry_info>& entries);
+
+	// Decrypts data at any offset of the data section
+	u64 read_data(u64 offset, void* buffer, u64 size, bool is_psp);
+
 private:
 	bool read_header();
 	bool read_metadata();
@@ -4,7 +4,9 @@
 #include "util/asm.hpp"
 #include "Emu/System.h"
 #include "Emu/system_utils.hpp"
+#include "Emu/system_config.h"
 #include "Crypto/unzip.h"
+#include "Crypto/sha1.h"
 
 inline u8 Read8(const fs::file& f)
 {
@@ -1399,6 +1401,115 @@ static fs::file CheckDebugSelf(const fs::file& s)
 	return {};
 }
 
+// Header of a decrypted ELF stored in the SELF cache
+struct self_cache_header
+{
+	le_t<u32> magic;
+	le_t<u32> version;
+	le_t<u64> self_size;
+	le_t<u64> elf_size;
+};
+
+constexpr u32 self_cache_magic = "RSC\0"_u32;
+constexpr u32 self_cache_version = 1;
+
+// Returns the cache file path for a SELF, or an empty string if it cannot be cached.
+// The key covers the whole SELF header, which holds the encrypted metadata with the section digests, and the klic used to decrypt it.
+static std::string get_self_cache_path(const fs::file& self, const u8* klic_key)
+{
+	if (!g_cfg.core.self_cache)
+	{
+		return {};
+	}
+
+	SceHeader sce_hdr{};
+	self.seek(0);
+	sce_hdr.Load(self);
+
+	const u64 file_size = self.size();
+
+	if (!sce_hdr.CheckMagic() || sce_hdr.se_hsize < sizeof(SceHeader) || sce_hdr.se_hsize > std::min<u64>(file_size, 0x1000000))
+	{
+		return {};
+	}
+
+	std::vector<u8> header(sce_hdr.se_hsize);
+
+	if (self.read_at(0, header.data(), header.size()) != header.size())
+	{
+		return {};
+	}
+
+	sha1_context ctx;
+	u8 output[20];
+
+	sha1_starts(&ctx);
+	sha1_update(&ctx, header.data(), header.size());
+
+	if (klic_key)
+	{
+		sha1_update(&ctx, klic_key, 0x10);
+	}
+
+	const le_t<u64> size_le = file_size;
+	sha1_update(&ctx, reinterpret_cast<const u8*>(&size_le), sizeof(size_le));
+	sha1_finish(&ctx, output);
+
+	return fmt::format("%s%s.elf", rpcs3::utils::get_self_cache_dir(), fmt::base57(output));
+}
+
+static fs::file load_cached_self(const std::string& path, u64 self_size)
+{
+	fs::file cached(path);
+
+	if (!cached)
+	{
+		return {};
+	}
+
+	self_cache_header hdr{};
+
+	if (!cached.read(hdr) || hdr.magic != self_cache_magic || hdr.version != self_cache_version || hdr.self_size != self_size || cached.size() != sizeof(hdr) + hdr.elf_size)
+	{
+		self_log.warning("Ignoring invalid SELF cache entry: %s", path);
+		return {};
+	}
+
+	std::vector<u8> data(hdr.elf_size);
+
+	if (cached.read_at(sizeof(hdr), data.data(), data.size()) != data.size())
+	{
+		return {};
+	}
+
+	return fs::make_stream(std::move(data));
+}
+
+static void save_cached_self(const std::string& path, u64 self_size, const fs::file& elf)
+{
+	const std::vector<u8> data = elf.to_vector<u8>();
+
+	self_cache_header hdr{};
+	hdr.magic = self_cache_magic;
+	hdr.version = self_cache_version;
+	hdr.self_size = self_size;
+	hdr.elf_size = data.size();
+
+	if (!fs::create_path(fs::get_parent_dir(path)))
+	{
+		self_log.error("Failed to create SELF cache directory for %s (%s)", path, fs::g_tls_error);
+		return;
+	}
+
+	// Several threads may decrypt the same module at once, the last commit wins
+	fs::pending_file file(path);
+
+	if (!file.file || file.file.write(&hdr, sizeof(hdr)) != sizeof(hdr) || file.file.write(data.data(), data.size()) != data.size() || !file.commit())
+	{
+		self_log.error("Failed to write SELF cache entry %s (%s)", path, fs::g_tls_error);
+	}
+}
+
 fs::file decrypt_self(const fs::file& elf_or_self, const u8* klic_key, SelfAdditionalInfo* out_info)
 {
 	if (out_info)
@@ -1438,6 +1549,18 @@ fs::file decrypt_self(const fs::file& elf_or_self, const u8* klic_key, SelfAddit
 			return fs::file{};
 		}
 
+		// Skip decryption if this SELF was decrypted with the same key before
+		const std::string cache_path = get_self_cache_path(elf_or_self, klic_key);
+
+		if (!cache_path.empty())
+		{
+			if (fs::file cached = load_cached_self(cache_path, elf_or_self.size()))
+			{
+				self_log.notice("Loaded decrypted SELF from cache: %s", cache_path);
+				return cached;
+			}
+		}
+
 		// Load and decrypt the SELF file metadata.
 		if (!self_dec.LoadMetadata(klic_key))
 		{
@@ -1453,7 +1576,14 @@ fs::file decrypt_self(const fs::file& elf_or_self, const u8* klic_key, SelfAddit
 		}
 
 		// Make a new ELF file from this SELF.
-		return self_dec.MakeElf(isElf32);
+		fs::file elf = self_dec.MakeElf(isElf32);
+
+		if (!cache_path.empty() && elf)
+		{
+			save_cached_self(cache_path, elf_or_self.size(), elf);
+		}
+
+		return elf;
 	}
 	else if (Emu.GetBoot().ends_with(".elf") || Emu.GetBoot().ends_with(".ELF"))
 	{
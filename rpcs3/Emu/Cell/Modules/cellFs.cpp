@@ -5,8 +5,14 @@
 
 #include "Emu/Cell/lv2/sys_fs.h"
 #include "Emu/Cell/lv2/sys_sync.h"
+#include "Emu/Cell/lv2/sys_ppu_thread.h"
+#include "Utilities/Thread.h"
+#include "util/sysinfo.hpp"
+#include "sysPrxForUser.h"
 #include "cellFs.h"
 
+#include <deque>
+#include <map>
 #include <mutex>
 
 LOG_CHANNEL(cellFs);
@@ -890,130 +896,367 @@ s32 cellFsStReadWaitCallback(u32 fd, u64 size, vm::ptr<void(s32 xfd, u64 xsize)>
 
 using fs_aio_cb_t = vm::ptr<void(vm::ptr<CellFsAio> xaio, s32 error, s32 xid, u64 size)>;
 
-struct fs_aio_thread : ppu_thread
+struct fs_aio_request
 {
-	using ppu_thread::ppu_thread;
+	u32 type; // 1 = read, 2 = write
+	s32 xid;
+	vm::ptr<CellFsAio> aio;
+	fs_aio_cb_t func;
 
-	void non_task()
+	// Copied from CellFsAio when the request is queued
+	u32 fd;
+	u64 offset;
+	vm::ptr<void> buf;
+	u64 size;
+};
+
+struct fs_aio_result
+{
+	s32 xid;
+	vm::ptr<CellFsAio> aio;
+	fs_aio_cb_t func;
+	s32 error = CELL_OK;
+	u64 size = 0;
+};
+
+struct fs_aio_worker
+{
+	void operator()();
+};
+
+struct fs_aio_manager
+{
+	shared_mutex mutex;
+
+	// Mount points passed to cellFsAioInit (with their reference count)
+	std::map<std::string, u32, std::less<>> mount_points;
+
+	// Pending requests, popped by the worker threads in submission order
+	std::deque<fs_aio_request> requests;
+	atomic_t<u32> queued = 0;
+
+	// Requests not reported to the guest yet
+	atomic_t<u32> in_flight = 0;
+
+	// Finished requests, reported by the callback thread in completion order (null func stops the thread)
+	lf_queue<fs_aio_result> completed;
+
+	// HLE PPU thread executing the callbacks
+	atomic_t<u32> ppu_tid = 0;
+
+	// Set under the mutex while cellFsAioFinish stops the callback thread, cellFsAioInit waits for it
+	atomic_t<u32> stopping = 0;
+
+	std::unique_ptr<named_thread_group<fs_aio_worker>> workers;
+
+	static fs_aio_result process(const fs_aio_request& req);
+};
+
+void fs_aio_worker::operator()()
+{
+	auto& m = g_fxo->get<fs_aio_manager>();
+
+	while (thread_ctrl::state() != thread_state::aborting)
 	{
-		while (cmd64 cmd = cmd_wait())
+		if (!m.queued.try_dec(0))
 		{
-			const u32 type = cmd.arg1<u32>();
-			const s32 xid = cmd.arg2<s32>();
-			const cmd64 cmd2 = cmd_get(1);
-			const auto aio = cmd2.arg1<vm::ptr<CellFsAio>>();
-			const auto func = cmd2.arg2<fs_aio_cb_t>();
-			cmd_pop(1);
-
-			s32 error = CELL_EBADF;
-			u64 result = 0;
+			thread_ctrl::wait_on(m.queued, 0);
+			continue;
+		}
 
-			const auto file = idm::get_unlocked<lv2_fs_object, lv2_file>(aio->fd);
+		fs_aio_request req;
+		{
+			std::lock_guard lock(m.mutex);
 
-			if (!file || (type == 1 && file->flags & CELL_FS_O_WRONLY) || (type == 2 && !(file->flags & CELL_FS_O_ACCMODE)))
+			if (m.requests.empty())
 			{
+				// Cancelled
+				continue;
 			}
-			else if (std::lock_guard lock(file->mp->mutex); file->file)
-			{
-				const auto old_pos = file->file.pos(); file->file.seek(aio->offset);
 
-				result = type == 2
-					? file->op_write(aio->buf, aio->size)
-					: file->op_read(aio->buf, aio->size);
+			req = m.requests.front();
+			m.requests.pop_front();
+		}
 
-				file->file.seek(old_pos);
-				error = CELL_OK;
-			}
+		m.completed.push(fs_aio_manager::process(req));
+	}
+}
+
+fs_aio_result fs_aio_manager::process(const fs_aio_request& req)
+{
+	fs_aio_result res{req.xid, req.aio, req.func};
+	res.error = CELL_EBADF;
+
+	const auto file = idm::get_unlocked<lv2_fs_object, lv2_file>(req.fd);
+
+	if (!file || (req.type == 1 && file->flags & CELL_FS_O_WRONLY) || (req.type == 2 && !(file->flags & CELL_FS_O_ACCMODE)))
+	{
+		return res;
+	}
 
-			func(*this, aio, error, xid, result);
-			lv2_obj::sleep(*this);
+	if (req.type == 1)
+	{
+		// Positional reads do not touch the file position and can proceed in parallel (see sys_fs_fcntl 0x8000000a)
+		reader_lock lock(file->mp->mutex);
+
+		if (file->file)
+		{
+			res.size = file->op_read(req.buf, req.size, req.offset);
+			res.error = CELL_OK;
 		}
 	}
-};
+	else if (std::lock_guard lock(file->mp->mutex); file->file)
+	{
+		const auto old_pos = file->file.pos(); file->file.seek(req.offset);
+		res.size = file->op_write(req.buf, req.size);
+		file->file.seek(old_pos);
+		res.error = CELL_OK;
+	}
 
-struct fs_aio_manager
+	return res;
+}
+
+extern void fsAioEntry(ppu_thread& ppu)
 {
-	std::shared_ptr<fs_aio_thread> thread;
+	auto& m = g_fxo->get<fs_aio_manager>();
 
-	shared_mutex mutex;
-};
+	m.ppu_tid.release(ppu.id);
+	m.ppu_tid.notify_all();
+
+	for (bool exit = false; !exit && thread_ctrl::state() != thread_state::aborting;)
+	{
+		auto slice = m.completed.pop_all();
+
+		if (!slice)
+		{
+			thread_ctrl::wait_on(m.completed);
+			continue;
+		}
+
+		for (const fs_aio_result& res : slice)
+		{
+			if (!res.func)
+			{
+				exit = true;
+				break;
+			}
+
+			res.func(ppu, res.aio, res.error, res.xid, res.size);
+			lv2_obj::sleep(ppu);
+
+			if (m.in_flight-- == 1)
+			{
+				m.in_flight.notify_all();
+			}
+		}
+	}
+
+	ppu.state += cpu_flag::exit;
+}
 
-s32 cellFsAioInit(vm::cptr<char> mount_point)
+error_code cellFsAioInit(ppu_thread& ppu, vm::cptr<char> mount_point)
 {
 	cellFs.warning("cellFsAioInit(mount_point=%s)", mount_point);
 
-	// TODO: create AIO thread (if not exists) for specified mount point
-	cellFs.fatal("cellFsAio disabled, use LLE.");
+	if (!mount_point)
+	{
+		return CELL_EFAULT;
+	}
+
+	auto& m = g_fxo->get<fs_aio_manager>();
+
+	std::unique_lock lock(m.mutex);
+
+	// Don't start a new callback thread until cellFsAioFinish has stopped the previous one
+	if (m.stopping)
+	{
+		lv2_obj::sleep(ppu);
+
+		while (m.stopping)
+		{
+			lock.unlock();
+
+			if (ppu.is_stopped())
+			{
+				return {};
+			}
+
+			thread_ctrl::wait_on(m.stopping, 1);
+			lock.lock();
+		}
+	}
+
+	if (m.mount_points[mount_point.get_ptr()]++ || m.mount_points.size() > 1)
+	{
+		// The callback thread is shared by all mount points
+		return CELL_OK;
+	}
+
+	// Blocking host I/O is done by the workers, the guest thread only runs the callbacks
+	if (!m.workers)
+	{
+		const u32 worker_count = std::clamp<u32>(utils::get_thread_count() / 2, 1, 4);
+		m.workers = std::make_unique<named_thread_group<fs_aio_worker>>("FS AIO Worker "sv, worker_count, fs_aio_worker{});
+	}
+
+	vm::var<u64> _tid;
+	vm::var<char[]> _name = vm::make_str("HLE FS AIO Thread");
+	ppu_execute<&sys_ppu_thread_create>(ppu, +_tid, 0x10000, 0, 1000, 0x4000, SYS_PPU_THREAD_CREATE_INTERRUPT, +_name);
+
+	const auto thrd = idm::get_unlocked<named_thread<ppu_thread>>(static_cast<u32>(*_tid));
+
+	thrd->cmd_list
+	({
+		{ ppu_cmd::hle_call, FIND_FUNC(fsAioEntry) },
+	});
+
+	thrd->state -= cpu_flag::stop;
+	thrd->state.notify_one();
 
 	return CELL_OK;
 }
 
-s32 cellFsAioFinish(vm::cptr<char> mount_point)
+error_code cellFsAioFinish(ppu_thread& ppu, vm::cptr<char> mount_point)
 {
 	cellFs.warning("cellFsAioFinish(mount_point=%s)", mount_point);
 
-	// TODO: delete existing AIO thread for specified mount point
+	if (!mount_point)
+	{
+		return CELL_EFAULT;
+	}
 
-	return CELL_OK;
-}
+	auto& m = g_fxo->get<fs_aio_manager>();
 
-atomic_t<s32> g_fs_aio_id;
+	{
+		std::lock_guard lock(m.mutex);
 
-s32 cellFsAioRead(vm::ptr<CellFsAio> aio, vm::ptr<s32> id, fs_aio_cb_t func)
-{
-	cellFs.warning("cellFsAioRead(aio=*0x%x, id=*0x%x, func=*0x%x)", aio, id, func);
+		const auto found = m.mount_points.find(std::string_view{mount_point.get_ptr()});
+
+		if (found == m.mount_points.end())
+		{
+			return CELL_EINVAL;
+		}
 
-	// TODO: detect mount point and send AIO request to the AIO thread of this mount point
+		if (--found->second)
+		{
+			return CELL_OK;
+		}
 
-	auto& m = g_fxo->get<fs_aio_manager>();
+		m.mount_points.erase(found);
+
+		if (!m.mount_points.empty())
+		{
+			return CELL_OK;
+		}
+
+		m.stopping = 1;
+	}
+
+	lv2_obj::sleep(ppu);
 
-	if (!m.thread)
+	// Let the outstanding requests complete, then stop the callback thread
+	while (!ppu.is_stopped())
 	{
-		return CELL_ENXIO;
+		const u32 in_flight = m.in_flight;
+
+		if (!in_flight)
+		{
+			break;
+		}
+
+		thread_ctrl::wait_on(m.in_flight, in_flight);
 	}
 
-	const s32 xid = (*id = ++g_fs_aio_id);
+	// The callback thread publishes its id once it starts running
+	while (!m.ppu_tid && !ppu.is_stopped())
+	{
+		thread_ctrl::wait_on(m.ppu_tid, 0);
+	}
 
-	m.thread->cmd_list
-	({
-		{ 1, xid },
-		{ aio, func },
-	});
+	m.completed.push(fs_aio_result{});
+
+	if (const u32 tid = m.ppu_tid.exchange(0))
+	{
+		ppu_execute<&sys_interrupt_thread_disestablish>(ppu, tid);
+	}
+
+	{
+		std::lock_guard lock(m.mutex);
+		m.stopping = 0;
+	}
 
+	m.stopping.notify_all();
 	return CELL_OK;
 }
 
-s32 cellFsAioWrite(vm::ptr<CellFsAio> aio, vm::ptr<s32> id, fs_aio_cb_t func)
+atomic_t<s32> g_fs_aio_id;
+
+static error_code fs_aio_submit(u32 type, vm::ptr<CellFsAio> aio, vm::ptr<s32> id, fs_aio_cb_t func)
 {
-	cellFs.warning("cellFsAioWrite(aio=*0x%x, id=*0x%x, func=*0x%x)", aio, id, func);
+	auto& m = g_fxo->get<fs_aio_manager>();
 
-	// TODO: detect mount point and send AIO request to the AIO thread of this mount point
+	if (!aio || !id || !func)
+	{
+		return CELL_EFAULT;
+	}
 
-	auto& m = g_fxo->get<fs_aio_manager>();
+	std::lock_guard lock(m.mutex);
 
-	if (!m.thread)
+	if (m.mount_points.empty())
 	{
 		return CELL_ENXIO;
 	}
 
 	const s32 xid = (*id = ++g_fs_aio_id);
 
-	m.thread->cmd_list
-	({
-		{ 2, xid },
-		{ aio, func },
-	});
+	m.requests.push_back(fs_aio_request{type, xid, aio, func, aio->fd, aio->offset, aio->buf, aio->size});
+	m.in_flight++;
+	m.queued++;
+	m.queued.notify_one();
 
 	return CELL_OK;
 }
 
-s32 cellFsAioCancel(s32 id)
+error_code cellFsAioRead(vm::ptr<CellFsAio> aio, vm::ptr<s32> id, fs_aio_cb_t func)
 {
-	cellFs.todo("cellFsAioCancel(id=%d) -> CELL_EINVAL", id);
+	cellFs.trace("cellFsAioRead(aio=*0x%x, id=*0x%x, func=*0x%x)", aio, id, func);
 
-	// TODO: cancelled requests return CELL_ECANCELED through their own callbacks
+	return fs_aio_submit(1, aio, id, func);
+}
+
+error_code cellFsAioWrite(vm::ptr<CellFsAio> aio, vm::ptr<s32> id, fs_aio_cb_t func)
+{
+	cellFs.trace("cellFsAioWrite(aio=*0x%x, id=*0x%x, func=*0x%x)", aio, id, func);
+
+	return fs_aio_submit(2, aio, id, func);
+}
+
+error_code cellFsAioCancel(s32 id)
+{
+	cellFs.warning("cellFsAioCancel(id=%d)", id);
+
+	auto& m = g_fxo->get<fs_aio_manager>();
+
+	std::lock_guard lock(m.mutex);
 
-	return CELL_EINVAL;
+	// Only requests not picked up by a worker yet can be cancelled
+	const auto found = std::find_if(m.requests.begin(), m.requests.end(), [&](const fs_aio_request& req)
+	{
+		return req.xid == id;
+	});
+
+	if (found == m.requests.end())
+	{
+		return CELL_EINVAL;
+	}
+
+	// Cancelled requests return CELL_ECANCELED through their own callbacks
+	fs_aio_result res{found->xid, found->aio, found->func};
+	res.error = CELL_ECANCELED;
+	m.completed.push(res);
+	m.requests.erase(found);
+
+	return CELL_OK;
 }
 
 s32 cellFsArcadeHddSerialNumber()
@@ -1130,4 +1373,6 @@ DECLARE(ppu_module_manager::cellFs)("sys_fs", []()
 	REG_FUNC(sys_fs, cellFsUtime);
 	REG_FUNC(sys_fs, cellFsWrite).flag(MFF_PERFECT);
 	REG_FUNC(sys_fs, cellFsWriteWithOffset);
+
+	REG_HIDDEN_FUNC(fsAioEntry);
 });
@@ -5746,6 +5746,7 @@ static void ppu_initialize2(jit_compiler& jit, const ppu_module<lv2_obj>& module
 	}
 
 	// Load or compile module
+	perf_span span("PPU LLVM Compile");
 	jit.add(std::move(_module), cache_path);
 #endif // LLVM_AVAILABLE
 }
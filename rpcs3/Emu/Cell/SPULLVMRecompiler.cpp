@@ -3,6 +3,7 @@
 
 #include "Emu/System.h"
 #include "Emu/system_config.h"
+#include "Emu/perf_meter.hpp"
 #include "Emu/IdManager.h"
 #include "Emu/Cell/timers.hpp"
 #include "Emu/Cell/lv2/sys_time.h"
@@ -1719,6 +1720,8 @@ public:
 
 		spu_log.notice("Building function 0x%x... (size %u, %s)", func.entry_point, func.data.size(), m_hash);
 
+		perf_span span("SPU LLVM Compile", func.entry_point);
+
 		m_pos = func.lower_bound;
 		m_base = func.entry_point;
 		m_size = ::size32(func.data) * 4;
@@ -1546,6 +1546,9 @@ void spu_thread::cpu_task()
 		}
 	}
 
+	// One timeline event per thread group run
+	perf_span span("SPU Run", lv2_id);
+
 	if (jit)
 	{
 		while (true)
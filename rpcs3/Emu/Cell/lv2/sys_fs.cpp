@@ -572,6 +572,8 @@ u64 lv2_file::op_read(const fs::file& file, vm::ptr<void> buf, u64 size, u64 opt
 
 u64 lv2_file::op_write(const fs::file& file, vm::cptr<void> buf, u64 size)
 {
+	const vfs::host_cache_guard cache_guard;
+
 	if (u64 region = buf.addr() >> 28, region_end = (buf.addr() + size) >> 28;
 		size < u32{umax} && region == region_end && (region == 0 || region == 0xD) && vm::check_addr(buf.addr(), vm::page_readable, static_cast<u32>(size)))
 	{
@@ -1015,6 +1017,9 @@ lv2_file::open_raw_result_t lv2_file::open_raw(const std::string& local_path, s3
 
 	std::lock_guard lock(mp->mutex);
 
+	// Cached stat results of read-only mounts may alias this file (e.g. a disc game located in dev_hdd0)
+	const vfs::host_cache_guard cache_guard(!!(open_mode & fs::write));
+
 	fs::file file(local_path, open_mode);
 
 	if (!file && open_mode == fs::read && fs::g_tls_error == fs::error::noent && mp.mp != &g_mp_sys_dev_hdd1)
@@ -1489,6 +1494,12 @@ error_code sys_fs_close(ppu_thread& ppu, u32 fd)
 	return CELL_OK;
 }
 
+// Read-only mounts can only change through a remount or through a write on another mount, both drop the cache
+static bool get_mount_stat(const lv2_fs_mount_info& mp, const std::string& local_path, fs::stat_t& info)
+{
+	return mp.read_only ? vfs::get_stat_cached(local_path, info) : fs::get_stat(local_path, info);
+}
+
 error_code sys_fs_opendir(ppu_thread& ppu, vm::cptr<char> path, vm::ptr<u32> fd)
 {
 	lv2_obj::sleep(ppu);
@@ -1517,16 +1528,27 @@ error_code sys_fs_opendir(ppu_thread& ppu, vm::cptr<char> path, vm::ptr<u32> fd)
 
 	// TODO: other checks for path
 
-	if (fs::is_file(local_path))
+	if (fs::stat_t info{}; get_mount_stat(mp, local_path, info) && !info.is_directory)
 	{
 		return {CELL_ENOTDIR, path};
 	}
 
 	std::unique_lock lock(mp->mutex);
 
-	const fs::dir dir(local_path);
+	// Listings of read-only mounts are cached
+	fs::dir dir;
+	std::shared_ptr<const std::vector<fs::dir_entry>> cached_dir;
+
+	if (mp.read_only)
+	{
+		cached_dir = vfs::get_dir_cached(local_path);
+	}
+	else
+	{
+		dir.open(local_path);
+	}
 
-	if (!dir)
+	if (!dir && !cached_dir)
 	{
 		switch (const auto error = fs::g_tls_error)
 		{
@@ -1558,10 +1580,28 @@ error_code sys_fs_opendir(ppu_thread& ppu, vm::cptr<char> path, vm::ptr<u32> fd)
 	// Build directory as a vector of entries
 	std::vector<fs::dir_entry> data;
 
-	if (dir)
+	if (dir || cached_dir)
 	{
+		usz cached_pos = 0;
+
+		auto read_entry = [&](fs::dir_entry& entry)
+		{
+			if (cached_dir)
+			{
+				if (cached_pos >= cached_dir->size())
+				{
+					return false;
+				}
+
+				entry = (*cached_dir)[cached_pos++];
+				return true;
+			}
+
+			return dir.read(entry);
+		};
+
 		// Add real directories
-		while (dir.read(data.emplace_back()))
+		while (read_entry(data.emplace_back()))
 		{
 			// Preprocess entries
 			data.back().name = vfs::unescape(data.back().name);
@@ -1729,7 +1769,7 @@ error_code sys_fs_stat(ppu_thread& ppu, vm::cptr<char> path, vm::ptr<CellFsStat>
 
 	fs::stat_t info{};
 
-	if (!fs::get_stat(local_path, info))
+	if (!get_mount_stat(mp, local_path, info))
 	{
 		switch (auto error = fs::g_tls_error)
 		{
@@ -1744,7 +1784,7 @@ error_code sys_fs_stat(ppu_thread& ppu, vm::cptr<char> path, vm::ptr<CellFsStat>
 
 			// Use attributes from the first fragment (consistently with sys_fs_open+fstat
 			fs::stat_t info_split{};
-			if (mp.mp != &g_mp_sys_dev_hdd1 && fs::get_stat(local_path + ".66600", info_split) && !info_split.is_directory)
+			if (mp.mp != &g_mp_sys_dev_hdd1 && get_mount_stat(mp, local_path + ".66600", info_split) && !info_split.is_directory)
 			{
 				// Success
 				total_size += info_split.size;
@@ -1754,7 +1794,7 @@ error_code sys_fs_stat(ppu_thread& ppu, vm::cptr<char> path, vm::ptr<CellFsStat>
 			{
 				info = {};
 
-				if (fs::get_stat(fmt::format("%s.%u", local_path, i), info) && !info.is_directory)
+				if (get_mount_stat(mp, fmt::format("%s.%u", local_path, i), info) && !info.is_directory)
 				{
 					total_size += info.size;
 				}
@@ -1909,6 +1949,8 @@ error_code sys_fs_mkdir(ppu_thread& ppu, vm::cptr<char> path, s32 mode)
 		return {CELL_EACCES, path};
 	}
 
+	const vfs::host_cache_guard cache_guard;
+
 	if (!fs::create_dir(local_path))
 	{
 		switch (auto error = fs::g_tls_error)
@@ -2052,6 +2094,8 @@ error_code sys_fs_rmdir(ppu_thread& ppu, vm::cptr<char> path)
 		return {CELL_EACCES, vpath};
 	}
 
+	const vfs::host_cache_guard cache_guard;
+
 	if (!fs::remove_dir(local_path))
 	{
 		switch (auto error = fs::g_tls_error)
@@ -3028,6 +3072,8 @@ error_code sys_fs_truncate(ppu_thread& ppu, vm::cptr<char> path, u64 size)
 
 	std::lock_guard lock(mp->mutex);
 
+	const vfs::host_cache_guard cache_guard;
+
 	if (!fs::truncate_file(local_path, size))
 	{
 		switch (auto error = fs::g_tls_error)
@@ -3090,6 +3136,8 @@ error_code sys_fs_ftruncate(ppu_thread& ppu, u32 fd, u64 size)
 		return CELL_EBUSY;
 	}
 
+	const vfs::host_cache_guard cache_guard;
+
 	if (!file->file.trunc(size))
 	{
 		switch (auto error = fs::g_tls_error)
@@ -3295,6 +3343,8 @@ error_code sys_fs_utime(ppu_thread& ppu, vm::cptr<char> path, vm::cptr<CellFsUti
 
 	std::lock_guard lock(mp->mutex);
 
+	const vfs::host_cache_guard cache_guard;
+
 	if (!fs::utime(local_path, timep->actime, timep->modtime))
 	{
 		switch (auto error = fs::g_tls_error)
@@ -2,6 +2,8 @@
 #include "System.h"
 #include "Emu/IPC_config.h"
 #include "IPC_socket.h"
+#include "perf_meter.hpp"
+#include "perf_monitor.hpp"
 #include "rpcs3_version.h"
 
 
@@ -90,11 +92,175 @@ namespace IPC_socket
 		return rpcs3::get_version_and_branch();
 	}
 
+	std::string IPC_impl::capture_trace()
+	{
+		return perf_trace::capture(g_cfg.core.perf_trace_capture_length);
+	}
+
+	std::array<u32, 5> IPC_impl::get_frame_stats()
+	{
+		const perf_metrics m = perf_monitor::get_metrics();
+
+		return
+		{
+			static_cast<u32>(m.fps * 100),
+			static_cast<u32>(m.frame_time_p50 * 1000),
+			static_cast<u32>(m.frame_time_p90 * 1000),
+			static_cast<u32>(m.frame_time_p99 * 1000),
+			static_cast<u32>(m.frame_time_max * 1000),
+		};
+	}
+
+	std::array<u32, 6> IPC_impl::get_cpu_stats()
+	{
+		const perf_metrics m = perf_monitor::get_metrics();
+
+		return
+		{
+			static_cast<u32>(m.cpu_usage * 100),
+			static_cast<u32>(m.ppu_usage * 100),
+			static_cast<u32>(m.spu_usage * 100),
+			static_cast<u32>(m.rsx_usage * 100),
+			m.rsx_load,
+			m.thread_count,
+		};
+	}
+
+	std::string IPC_impl::get_perf_metrics()
+	{
+		return perf_monitor::get_metrics_text();
+	}
+
 	IPC_impl& IPC_impl::operator=(thread_state)
 	{
 		return *this;
 	}
 
+	bool IPC_server::is_ext_command(char command)
+	{
+		switch (static_cast<u8>(command))
+		{
+		case MsgCaptureTrace:
+		case MsgFrameStats:
+		case MsgCPUStats:
+		case MsgPerfMetrics:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	IPC_server::IPCBuffer IPC_server::parse_ext_command(char* buf, char* ret_buffer, u32 buf_size)
+	{
+		usz ret_cnt = 5;
+
+		const auto write_string = [&](std::string_view str)
+		{
+			if (!SafetyChecks(0, 0, ret_cnt, str.size() + 1 + sizeof(u32)))
+				return false;
+			ToArray(ret_buffer, ::narrow<u32>(str.size() + 1), ret_cnt);
+			ret_cnt += sizeof(u32);
+			std::memcpy(&ret_buffer[ret_cnt], str.data(), str.size());
+			ret_cnt += str.size();
+			ret_buffer[ret_cnt++] = '\0';
+			return true;
+		};
+
+		const auto write_values = [&](const auto& values)
+		{
+			if (!SafetyChecks(0, 0, ret_cnt, sizeof(values)))
+				return false;
+			for (const auto value : values)
+			{
+				ToArray(ret_buffer, value, ret_cnt);
+				ret_cnt += sizeof(value);
+			}
+			return true;
+		};
+
+		for (u32 i = 0; i < buf_size; i++)
+		{
+			bool ok = false;
+
+			switch (static_cast<u8>(buf[i]))
+			{
+			case MsgCaptureTrace: ok = write_string(capture_trace()); break;
+			case MsgFrameStats: ok = write_values(get_frame_stats()); break;
+			case MsgCPUStats: ok = write_values(get_cpu_stats()); break;
+			case MsgPerfMetrics: ok = write_string(get_perf_metrics()); break;
+			default: break;
+			}
+
+			if (!ok)
+			{
+				return IPCBuffer{5, MakeFailIPC(ret_buffer)};
+			}
+		}
+
+		return IPCBuffer{ret_cnt, MakeOkIPC(ret_buffer, ret_cnt)};
+	}
+
+	// Same as pine_server::operator(), with the RPCS3 specific commands
+	void IPC_server::operator()()
+	{
+		m_ret_buffer.resize(MAX_IPC_RETURN_SIZE);
+		m_ipc_buffer.resize(MAX_IPC_SIZE);
+
+		if (!StartSocket())
+			return;
+
+		while (thread_ctrl::state() != thread_state::aborting)
+		{
+			auto receive_length = 0;
+			auto end_length = 4;
+
+			// Read the entire packet
+			while (receive_length < end_length)
+			{
+				auto tmp_length = read_portable(m_msgsock, &m_ipc_buffer[receive_length], MAX_IPC_SIZE - receive_length);
+
+				// Recreate the socket on error
+				if (tmp_length <= 0)
+				{
+					receive_length = 0;
+					if (!StartSocket())
+						return;
+					break;
+				}
+
+				receive_length += tmp_length;
+
+				if (end_length == 4 && receive_length >= 4)
+				{
+					end_length = FromArray<u32>(m_ipc_buffer.data(), 0);
+
+					if (end_length > MAX_IPC_SIZE || end_length < 4)
+					{
+						receive_length = 0;
+						break;
+					}
+				}
+			}
+
+			if (receive_length != 0)
+			{
+				char* const buf = &m_ipc_buffer[4];
+				const u32 buf_size = static_cast<u32>(end_length) - 4;
+
+				const bool is_ext = buf_size && std::all_of(buf, buf + buf_size, is_ext_command);
+
+				const IPCBuffer res = is_ext ? parse_ext_command(buf, m_ret_buffer.data(), buf_size) : ParseCommand(buf, m_ret_buffer.data(), buf_size);
+
+				// Restart the socket if the answer cannot be sent
+				if (write_portable(m_msgsock, res.buffer, res.size) < 0)
+				{
+					if (!StartSocket())
+						return;
+				}
+			}
+		}
+	}
+
 	IPC_server_manager::IPC_server_manager(bool enabled)
 	{
 		// Enable IPC if needed
@@ -109,7 +275,7 @@ namespace IPC_socket
 			if (!m_ipc_server || port != m_old_port)
 			{
 				IPC.notice("Starting server with port %d", port);
-				m_ipc_server = std::make_unique<IPC_server>();
+				m_ipc_server = std::make_unique<named_thread<IPC_server>>();
 				m_old_port = port;
 			}
 		}
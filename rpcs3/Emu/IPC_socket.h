@@ -40,17 +40,39 @@ namespace IPC_socket
 		static const std::string& get_executable_hash();
 		static const std::string& get_app_version();
 		static std::string get_version_and_branch();
+		static std::string capture_trace();
+		static std::array<u32, 5> get_frame_stats();
+		static std::array<u32, 6> get_cpu_stats();
+		static std::string get_perf_metrics();
 
 	public:
 		static auto constexpr thread_name = "IPC Server"sv;
 		IPC_impl& operator=(thread_state);
 	};
 
-	class IPC_server_manager
+	// RPCS3 specific commands, numbered after the PINE ones
+	enum IPC_ext_command : u8
 	{
-		using IPC_server = named_thread<pine::pine_server<IPC_socket::IPC_impl>>;
+		MsgCaptureTrace = 0x10, // Saves a timeline trace, returns its path
+		MsgFrameStats = 0x11,   // Returns FPS x100 and frame time percentiles (50, 90, 99, 100) in µs
+		MsgCPUStats = 0x12,     // Returns process, PPU, SPU and RSX CPU usage x100, RSX load and host thread count
+		MsgPerfMetrics = 0x13,  // Returns all performance metrics as Prometheus text
+	};
 
-		std::unique_ptr<IPC_server> m_ipc_server;
+	// PINE server which also accepts the RPCS3 specific commands.
+	// They take no arguments and must be sent in packets of their own, other packets go to the PINE parser.
+	class IPC_server : public pine::pine_server<IPC_impl>
+	{
+		static bool is_ext_command(char command);
+		IPCBuffer parse_ext_command(char* buf, char* ret_buffer, u32 buf_size);
+
+	public:
+		void operator()();
+	};
+
+	class IPC_server_manager
+	{
+		std::unique_ptr<named_thread<IPC_server>> m_ipc_server;
 		int m_old_port = 0;
 
 	public:
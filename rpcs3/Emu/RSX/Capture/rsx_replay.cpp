@@ -177,8 +177,31 @@ namespace rsx
 
 		auto fifo_stops = alloc_write_fifo(context_id);
 
-		while (thread_ctrl::state() != thread_state::aborting)
+		if (benchmark_loops)
 		{
+			benchmark_frames.reserve(benchmark_loops);
+
+			// The RSX is idle until the put pointer is moved below
+			get_current_renderer()->set_frame_stats_callback([this](const frame_statistics_t& stats)
+			{
+				std::lock_guard lock(benchmark_mutex);
+				benchmark_frames.push_back({0, stats});
+				benchmark_frames_count.release(::size32(benchmark_frames));
+			});
+		}
+
+		bool benchmark_done = false;
+
+		for (u32 loop = 0; thread_ctrl::state() != thread_state::aborting; loop++)
+		{
+			if (benchmark_loops && loop == benchmark_loops)
+			{
+				benchmark_done = true;
+				break;
+			}
+
+			const u64 loop_start = get_system_time();
+
 			// Load registers while the RSX is still idle
 			method_registers = frame->reg_state;
 			atomic_fence_seq_cst();
@@ -241,10 +264,108 @@ namespace rsx
 				render->request_emu_flip(1u);
 			}
 
+			if (benchmark_loops)
+			{
+				// Wait for the frame statistics of this iteration, there is no GPU to protect
+				while (benchmark_frames_count <= loop && thread_ctrl::state() != thread_state::aborting)
+				{
+					std::this_thread::yield();
+				}
+
+				std::lock_guard lock(benchmark_mutex);
+
+				if (loop < benchmark_frames.size())
+				{
+					benchmark_frames[loop].wall_time = get_system_time() - loop_start;
+				}
+
+				continue;
+			}
+
 			// random pause to not destroy gpu
 			thread_ctrl::wait_for(10'000);
 		}
 
+		if (benchmark_loops)
+		{
+			// Stop the renderer from calling back into this thread before it goes away
+			get_current_renderer()->set_frame_stats_callback({});
+
+			if (benchmark_done)
+			{
+				report_benchmark();
+				Emu.CallFromMainThread([]() { Emu.GracefulShutdown(true, true); });
+			}
+		}
+
 		get_current_cpu_thread()->state += (cpu_flag::exit + cpu_flag::wait);
 	}
+
+	void rsx_replay_thread::report_benchmark()
+	{
+		std::lock_guard lock(benchmark_mutex);
+
+		if (benchmark_frames.empty())
+		{
+			rsx_log.error("Capture Replay: No frames were recorded during the benchmark");
+			return;
+		}
+
+		struct metric
+		{
+			std::string_view name;
+			s64 frame_statistics_t::* member;
+		};
+
+		static constexpr std::array<metric, 6> metrics
+		{{
+			{ "FIFO decode", &frame_statistics_t::fifo_decode_time },
+			{ "Method dispatch", &frame_statistics_t::method_dispatch_time },
+			{ "Setup", &frame_statistics_t::setup_time },
+			{ "Vertex/index", &frame_statistics_t::vertex_upload_time },
+			{ "Textures", &frame_statistics_t::textures_upload_time },
+			{ "Draw exec", &frame_statistics_t::draw_exec_time },
+		}};
+
+		for (usz i = 0; i < benchmark_frames.size(); i++)
+		{
+			const auto& [wall_time, stats] = benchmark_frames[i];
+
+			rsx_log.notice("Capture Replay: Frame %u: wall=%uus, draws=%u, fifo_decode=%dus, method_dispatch=%dus, setup=%dus, vertex=%dus, textures=%dus, draw_exec=%dus",
+				i, wall_time, stats.draw_calls, stats.fifo_decode_time, stats.method_dispatch_time, stats.setup_time, stats.vertex_upload_time, stats.textures_upload_time, stats.draw_exec_time);
+		}
+
+		const auto summarize = [&](std::string_view name, auto&& get)
+		{
+			std::vector<s64> values;
+			values.reserve(benchmark_frames.size());
+
+			for (const auto& frame : benchmark_frames)
+			{
+				values.push_back(static_cast<s64>(get(frame)));
+			}
+
+			std::sort(values.begin(), values.end());
+
+			s64 total = 0;
+			for (const s64 value : values)
+			{
+				total += value;
+			}
+
+			const usz p99 = std::min(values.size() - 1, values.size() * 99 / 100);
+
+			rsx_log.success("Capture Replay: %-16s min=%8dus avg=%8dus p99=%8dus max=%8dus",
+				name, values.front(), total / static_cast<s64>(values.size()), values[p99], values.back());
+		};
+
+		rsx_log.success("Capture Replay: Benchmark finished, %u frames replayed", benchmark_frames.size());
+
+		summarize("Frame (wall)", [](const benchmark_frame& frame) { return frame.wall_time; });
+
+		for (const auto& metric : metrics)
+		{
+			summarize(metric.name, [member = metric.member](const benchmark_frame& frame) { return frame.stats.*member; });
+		}
+	}
 }
@@ -2,6 +2,8 @@
 
 #include "Emu/CPU/CPUThread.h"
 #include "Emu/RSX/rsx_methods.h"
+#include "Emu/RSX/Core/RSXDisplay.h"
+#include "Utilities/mutex.h"
 
 #include <unordered_map>
 #include <unordered_set>
@@ -180,14 +182,27 @@ namespace rsx
 			frame_capture_data::tile_state tile_state{};
 		};
 
+		struct benchmark_frame
+		{
+			u64 wall_time;
+			frame_statistics_t stats;
+		};
+
 		u32 user_mem_addr{};
 		current_state cs{};
 		std::unique_ptr<frame_capture_data> frame;
 
+		// Benchmark mode, replays the capture a fixed number of times and reports timings
+		u32 benchmark_loops{};
+		shared_mutex benchmark_mutex;
+		std::vector<benchmark_frame> benchmark_frames;
+		atomic_t<u32> benchmark_frames_count{};
+
 	public:
-		rsx_replay_thread(std::unique_ptr<frame_capture_data>&& frame_data)
+		rsx_replay_thread(std::unique_ptr<frame_capture_data>&& frame_data, u32 loops = 0)
 			: cpu_thread(0)
 			, frame(std::move(frame_data))
+			, benchmark_loops(loops)
 		{
 		}
 
@@ -197,5 +212,6 @@ namespace rsx
 		be_t<u32> allocate_context();
 		std::vector<u32> alloc_write_fifo(be_t<u32> context_id) const;
 		void apply_frame_state(be_t<u32> context_id, const frame_capture_data::replay_command& replay_cmd);
+		void report_benchmark();
 	};
 }
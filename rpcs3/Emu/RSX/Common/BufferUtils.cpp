@@ -477,6 +477,73 @@ namespace
 			dst[i] = i;
 	}
 
+	// Per-thread staging buffer for the swapped indices consumed by the expansion routines below
+	template <typename T>
+	std::span<T> get_expansion_scratch(usz count)
+	{
+		thread_local std::vector<T> scratch;
+
+		if (scratch.size() < count)
+		{
+			scratch.resize(count);
+		}
+
+		return { scratch.data(), count };
+	}
+
+	// Without primitive restart, fans and quads expand with a fixed pattern. Swap and scan the indices with the vectorized
+	// upload routine first, then shuffle them into place without any per-index branching.
+	template<typename T>
+	std::tuple<T, T, u32> expand_indexed_triangle_fan_no_restart(std::span<to_be_t<const T>> src, std::span<T> dst)
+	{
+		const auto indices = get_expansion_scratch<T>(src.size());
+		const auto [min_index, max_index, count] = untouched_impl::upload_untouched<T>(src, indices);
+
+		if (count < 3)
+		{
+			// The anchor and first outer index never produce a triangle on their own
+			return std::make_tuple(min_index, max_index, 0u);
+		}
+
+		const T anchor = indices[0];
+		T* out = dst.data();
+
+		for (u32 i = 2; i < count; ++i, out += 3)
+		{
+			out[0] = anchor;
+			out[1] = indices[i - 1];
+			out[2] = indices[i];
+		}
+
+		return std::make_tuple(min_index, max_index, (count - 2) * 3);
+	}
+
+	// Same as above, each group of 4 indices becomes 2 triangles
+	template<typename T>
+	std::tuple<T, T, u32> expand_indexed_quads_no_restart(std::span<to_be_t<const T>> src, std::span<T> dst)
+	{
+		const auto indices = get_expansion_scratch<T>(src.size());
+		const auto [min_index, max_index, count] = untouched_impl::upload_untouched<T>(src, indices);
+
+		const u32 quads = count / 4;
+		const T* in = indices.data();
+		T* out = dst.data();
+
+		for (u32 i = 0; i < quads; ++i, in += 4, out += 6)
+		{
+			// First triangle
+			out[0] = in[0];
+			out[1] = in[1];
+			out[2] = in[2];
+			// Second triangle
+			out[3] = in[2];
+			out[4] = in[3];
+			out[5] = in[0];
+		}
+
+		return std::make_tuple(min_index, max_index, quads * 6);
+	}
+
 	template<typename T>
 	std::tuple<T, T, u32> expand_indexed_triangle_fan(std::span<to_be_t<const T>> src, std::span<T> dst, bool is_primitive_restart_enabled, u32 primitive_restart_index)
 	{
@@ -487,6 +554,11 @@ namespace
 
 		ensure((dst.size() >= 3 * (src.size() - 2)));
 
+		if (!is_primitive_restart_enabled || primitive_restart_index > invalid_index)
+		{
+			return expand_indexed_triangle_fan_no_restart<T>(src, dst);
+		}
+
 		u32 dst_idx = 0;
 
 		bool needs_anchor = true;
@@ -537,6 +609,11 @@ namespace
 
 		ensure((4 * dst.size_bytes() >= 6 * src.size_bytes()));
 
+		if (!is_primitive_restart_enabled || primitive_restart_index > index_limit<T>())
+		{
+			return expand_indexed_quads_no_restart<T>(src, dst);
+		}
+
 		u32 dst_idx = 0;
 		u8 set_size = 0;
 		T tmp_indices[4];
@@ -720,10 +797,150 @@ namespace
 	}
 }
 
+namespace
+{
+	// Index lists processed with primitive restart enabled go through a scalar walk when they need expansion or compaction.
+	// Games tend to resubmit the same fan and quad lists every frame, so the processed output is kept per thread and
+	// replayed when the source bytes did not change. Sources that keep changing under the same address are skipped for a while.
+	class index_expansion_cache
+	{
+		static constexpr usz max_entries = 32;
+		static constexpr usz min_source_size = 64;
+		static constexpr usz max_source_size = 256 * 1024;
+		static constexpr u32 max_misses = 2;
+		static constexpr u32 bypass_length = 64;
+
+		struct entry_t
+		{
+			const std::byte* src = nullptr;
+			rsx::index_array_type type{};
+			rsx::primitive_type draw_mode{};
+			u32 restart_index = 0;
+			std::vector<std::byte> source;
+			std::vector<std::byte> output;
+			std::tuple<u32, u32, u32> result{};
+			u64 last_used = 0;
+			u32 misses = 0;
+			u32 bypass = 0;
+		};
+
+		std::vector<entry_t> m_entries;
+		u64 m_clock = 0;
+
+		entry_t& find_or_allocate(std::span<const std::byte> src, rsx::index_array_type type, rsx::primitive_type draw_mode, u32 restart_index)
+		{
+			entry_t* victim = nullptr;
+
+			for (auto& entry : m_entries)
+			{
+				if (entry.src == src.data() && entry.source.size() == src.size() &&
+					entry.type == type && entry.draw_mode == draw_mode && entry.restart_index == restart_index)
+				{
+					return entry;
+				}
+
+				if (!victim || entry.last_used < victim->last_used)
+				{
+					victim = &entry;
+				}
+			}
+
+			if (m_entries.size() < max_entries)
+			{
+				victim = &m_entries.emplace_back();
+			}
+
+			*victim = {};
+			victim->src = src.data();
+			victim->type = type;
+			victim->draw_mode = draw_mode;
+			victim->restart_index = restart_index;
+			return *victim;
+		}
+
+	public:
+		static bool is_cacheable(std::span<const std::byte> src, rsx::index_array_type type, rsx::primitive_type draw_mode,
+			bool restart_index_enabled, u32 restart_index, bool expanded)
+		{
+			if (!restart_index_enabled || src.size() < min_source_size || src.size() > max_source_size)
+			{
+				// Everything else already runs through the vectorized paths, a lookup would cost as much as the upload
+				return false;
+			}
+
+			if (type == rsx::index_array_type::u16 && restart_index > 0xffff)
+			{
+				return false;
+			}
+
+			return expanded ? draw_mode != rsx::primitive_type::line_loop : is_primitive_disjointed(draw_mode);
+		}
+
+		template <typename F>
+		std::tuple<u32, u32, u32> process(std::span<std::byte> dst, std::span<const std::byte> src, rsx::index_array_type type,
+			rsx::primitive_type draw_mode, u32 restart_index, F&& upload)
+		{
+			auto& entry = find_or_allocate(src, type, draw_mode, restart_index);
+			entry.last_used = ++m_clock;
+
+			if (entry.bypass)
+			{
+				entry.bypass--;
+				return upload();
+			}
+
+			if (!entry.output.empty())
+			{
+				if (entry.output.size() <= dst.size() && std::memcmp(entry.source.data(), src.data(), src.size()) == 0)
+				{
+					std::memcpy(dst.data(), entry.output.data(), entry.output.size());
+					entry.misses = 0;
+					return entry.result;
+				}
+
+				if (++entry.misses >= max_misses)
+				{
+					// Streaming data, stop paying for the compare and the copies
+					entry.misses = 0;
+					entry.bypass = bypass_length;
+					entry.output.clear();
+					return upload();
+				}
+			}
+
+			const auto result = upload();
+			const usz written = std::get<2>(result) * get_index_type_size(type);
+
+			entry.source.assign(src.begin(), src.end());
+			entry.output.assign(dst.begin(), dst.begin() + written);
+			entry.result = result;
+			return result;
+		}
+	};
+
+	thread_local index_expansion_cache g_index_expansion_cache;
+}
+
 std::tuple<u32, u32, u32> write_index_array_data_to_buffer(std::span<std::byte> dst_ptr,
 	std::span<const std::byte> src_ptr,
 	rsx::index_array_type type, rsx::primitive_type draw_mode, bool restart_index_enabled, u32 restart_index,
 	const std::function<bool(rsx::primitive_type)>& expands)
+{
+	if (index_expansion_cache::is_cacheable(src_ptr, type, draw_mode, restart_index_enabled, restart_index, expands(draw_mode)))
+	{
+		return g_index_expansion_cache.process(dst_ptr, src_ptr, type, draw_mode, restart_index, [&]()
+		{
+			return write_index_array_data_to_buffer_untracked(dst_ptr, src_ptr, type, draw_mode, restart_index_enabled, restart_index, expands);
+		});
+	}
+
+	return write_index_array_data_to_buffer_untracked(dst_ptr, src_ptr, type, draw_mode, restart_index_enabled, restart_index, expands);
+}
+
+std::tuple<u32, u32, u32> write_index_array_data_to_buffer_untracked(std::span<std::byte> dst_ptr,
+	std::span<const std::byte> src_ptr,
+	rsx::index_array_type type, rsx::primitive_type draw_mode, bool restart_index_enabled, u32 restart_index,
+	const std::function<bool(rsx::primitive_type)>& expands)
 {
 	switch (type)
 	{
@@ -33,6 +33,13 @@ std::tuple<u32, u32, u32> write_index_array_data_to_buffer(std::span<std::byte>
 	rsx::index_array_type, rsx::primitive_type draw_mode, bool restart_index_enabled, u32 restart_index,
 	const std::function<bool(rsx::primitive_type)>& expands);
 
+/**
+ * Same as write_index_array_data_to_buffer, but always processes the source and bypasses the per-thread cache of expanded index lists.
+ */
+std::tuple<u32, u32, u32> write_index_array_data_to_buffer_untracked(std::span<std::byte> dst, std::span<const std::byte> src,
+	rsx::index_array_type, rsx::primitive_type draw_mode, bool restart_index_enabled, u32 restart_index,
+	const std::function<bool(rsx::primitive_type)>& expands);
+
 /**
  * Write index data needed to emulate non indexed non native primitive mode.
  */
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <util/types.hpp>
+#include "Utilities/address_range.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace rsx
+{
+	// Treap of address ranges ordered by start address, with each node tracking the highest end address in its subtree.
+	// Overlap queries visit O(log n + k) nodes no matter how the ranges are distributed across the address space.
+	// Values act as keys and must be unique; inserting an existing value moves it to the new range.
+	template <typename T>
+	class interval_tree
+	{
+		static constexpr u32 nil = umax;
+
+		struct node_t
+		{
+			utils::address_range32 range;
+			u32 max_end;
+			u32 priority;
+			u32 left;
+			u32 right;
+			T value;
+		};
+
+		std::vector<node_t> m_nodes;
+		std::vector<u32> m_free_list;
+		std::unordered_map<T, u32> m_lookup;
+		u32 m_root = nil;
+		u32 m_seed = 0x9e3779b9;
+
+		u32 next_priority()
+		{
+			// xorshift32, only the balancing depends on it
+			m_seed ^= m_seed << 13;
+			m_seed ^= m_seed >> 17;
+			m_seed ^= m_seed << 5;
+			return m_seed;
+		}
+
+		void update(u32 id)
+		{
+			auto& node = m_nodes[id];
+			node.max_end = node.range.end;
+
+			if (node.left != nil)
+			{
+				node.max_end = std::max(node.max_end, m_nodes[node.left].max_end);
+			}
+
+			if (node.right != nil)
+			{
+				node.max_end = std::max(node.max_end, m_nodes[node.right].max_end);
+			}
+		}
+
+		// Strict ordering by (start, id)
+		bool less(u32 a, u32 b) const
+		{
+			const u32 start_a = m_nodes[a].range.start;
+			const u32 start_b = m_nodes[b].range.start;
+			return start_a < start_b || (start_a == start_b && a < b);
+		}
+
+		void split(u32 root, u32 id, u32& lhs, u32& rhs)
+		{
+			if (root == nil)
+			{
+				lhs = rhs = nil;
+				return;
+			}
+
+			if (less(root, id))
+			{
+				split(m_nodes[root].right, id, m_nodes[root].right, rhs);
+				lhs = root;
+			}
+			else
+			{
+				split(m_nodes[root].left, id, lhs, m_nodes[root].left);
+				rhs = root;
+			}
+
+			update(root);
+		}
+
+		u32 merge(u32 lhs, u32 rhs)
+		{
+			if (lhs == nil) return rhs;
+			if (rhs == nil) return lhs;
+
+			if (m_nodes[lhs].priority > m_nodes[rhs].priority)
+			{
+				const u32 right = merge(m_nodes[lhs].right, rhs);
+				m_nodes[lhs].right = right;
+				update(lhs);
+				return lhs;
+			}
+
+			const u32 left = merge(lhs, m_nodes[rhs].left);
+			m_nodes[rhs].left = left;
+			update(rhs);
+			return rhs;
+		}
+
+		u32 erase_node(u32 root, u32 id)
+		{
+			if (root == id)
+			{
+				return merge(m_nodes[root].left, m_nodes[root].right);
+			}
+
+			if (less(id, root))
+			{
+				const u32 left = erase_node(m_nodes[root].left, id);
+				m_nodes[root].left = left;
+			}
+			else
+			{
+				const u32 right = erase_node(m_nodes[root].right, id);
+				m_nodes[root].right = right;
+			}
+
+			update(root);
+			return root;
+		}
+
+		template <typename F>
+		void visit(u32 id, const utils::address_range32& range, F& func) const
+		{
+			while (id != nil)
+			{
+				const auto& node = m_nodes[id];
+
+				if (node.max_end < range.start)
+				{
+					// Nothing in this subtree reaches the range
+					return;
+				}
+
+				visit(node.left, range, func);
+
+				if (node.range.start > range.end)
+				{
+					// Everything to the right starts past the range
+					return;
+				}
+
+				if (node.range.end >= range.start)
+				{
+					func(node.value);
+				}
+
+				id = node.right;
+			}
+		}
+
+	public:
+		interval_tree() = default;
+
+		void insert(const utils::address_range32& range, const T& value)
+		{
+			AUDIT(range.valid());
+
+			if (const auto found = m_lookup.find(value); found != m_lookup.end())
+			{
+				if (m_nodes[found->second].range == range)
+				{
+					return;
+				}
+
+				erase(value);
+			}
+
+			u32 id;
+			if (m_free_list.empty())
+			{
+				id = ::size32(m_nodes);
+				m_nodes.emplace_back();
+			}
+			else
+			{
+				id = m_free_list.back();
+				m_free_list.pop_back();
+			}
+
+			m_nodes[id] = { range, range.end, next_priority(), nil, nil, value };
+			m_lookup.emplace(value, id);
+
+			u32 lhs, rhs;
+			split(m_root, id, lhs, rhs);
+			m_root = merge(merge(lhs, id), rhs);
+		}
+
+		bool erase(const T& value)
+		{
+			const auto found = m_lookup.find(value);
+			if (found == m_lookup.end())
+			{
+				return false;
+			}
+
+			const u32 id = found->second;
+			m_lookup.erase(found);
+
+			m_root = erase_node(m_root, id);
+			m_free_list.push_back(id);
+			return true;
+		}
+
+		void clear()
+		{
+			m_nodes.clear();
+			m_free_list.clear();
+			m_lookup.clear();
+			m_root = nil;
+		}
+
+		// Invokes func(value) for every range overlapping 'range', in ascending start order. The tree must not be modified from func.
+		template <typename F>
+		void for_each_overlapping(const utils::address_range32& range, F&& func) const
+		{
+			visit(m_root, range, func);
+		}
+
+		bool contains(const T& value) const
+		{
+			return m_lookup.contains(value);
+		}
+
+		usz size() const
+		{
+			return m_lookup.size();
+		}
+
+		bool empty() const
+		{
+			return m_lookup.empty();
+		}
+	};
+}
@@ -680,6 +680,7 @@ namespace rsx
 		atomic_t<u32> m_texture_upload_calls_this_frame = { 0 };
 		atomic_t<u32> m_texture_upload_misses_this_frame = { 0 };
 		atomic_t<u32> m_texture_copies_ellided_this_frame = { 0 };
+		atomic_t<u32> m_textures_revived_this_frame = { 0 };
 		static const u32 m_predict_max_flushes_per_frame = 50; // Above this number the predictions are disabled
 
 		// Invalidation
@@ -777,7 +778,7 @@ namespace rsx
 
 			// Check that there is at least one valid (locked) section in the test_range
 			reader_lock lock(m_cache_mutex);
-			if (m_storage.range_begin(test_range, locked_range, true) == m_storage.range_end())
+			if (!m_storage.has_section_in_range(test_range, locked_range, true))
 				return false;
 
 			// We do intersect the cache
@@ -1044,68 +1045,58 @@ namespace rsx
 			address_range32 &invalidate_range = result.invalidate_range;
 			invalidate_range = fault_range; // Sections fully inside this range will be invalidated, others will be deemed false positives
 
-			// Loop through cache and find pages that overlap the invalidate_range
-			u32 last_dirty_block = -1;
-			bool repeat_loop = false;
+			// Query the section index for locked sections overlapping the invalidate_range
+			// Extending the range can pull in more sections, so repeat until it stops growing
+			rsx::simple_array<section_storage_type*> candidates;
+			bool repeat_loop;
 
-			auto It = m_storage.range_begin(invalidate_range, locked_range, true); // will iterate through locked sections only
-			while (It != m_storage.range_end())
+			do
 			{
-				const u32 base = It.get_block().get_start();
+				repeat_loop = false;
+				candidates.clear();
 
-				// On the last loop, we stop once we're done with the last dirty block
-				if (!repeat_loop && base > last_dirty_block) // note: blocks are iterated in order from lowest to highest base address
-					break;
-
-				auto &tex = *It;
-
-				AUDIT(tex.is_locked()); // we should be iterating locked sections only, but just to make sure...
-				AUDIT(tex.cache_tag != cache_tag || last_dirty_block != umax); // cache tag should not match during the first loop
+				m_storage.for_each_section_in_range(invalidate_range, locked_range, true, [&](section_storage_type& tex)
+				{
+					//flushable sections can be 'clean' but unlocked. TODO: Handle this better
+					if (tex.cache_tag != cache_tag)
+					{
+						candidates.push_back(&tex);
+					}
+				});
 
-				if (tex.cache_tag != cache_tag) //flushable sections can be 'clean' but unlocked. TODO: Handle this better
+				for (auto tex : candidates)
 				{
-					const rsx::section_bounds bounds = tex.get_overlap_test_bounds();
+					AUDIT(tex->is_locked()); // we should be iterating locked sections only, but just to make sure...
 
-					if (locked_range == bounds || tex.overlaps(invalidate_range, bounds))
+					const rsx::section_bounds bounds = tex->get_overlap_test_bounds();
+
+					if (locked_range == bounds || tex->overlaps(invalidate_range, bounds))
 					{
-						const auto new_range = tex.get_min_max(invalidate_range, bounds).to_page_range();
+						const auto new_range = tex->get_min_max(invalidate_range, bounds).to_page_range();
 						AUDIT(new_range.is_page_range() && invalidate_range.inside(new_range));
 
 						// The various chaining policies behave differently
-						bool extend_invalidate_range = tex.overlaps(fault_range, bounds);
+						bool extend_invalidate_range = tex->overlaps(fault_range, bounds);
 
 						// Extend the various ranges
 						if (extend_invalidate_range && new_range != invalidate_range)
 						{
-							if (new_range.end > invalidate_range.end)
-								It.set_end(new_range.end);
-
 							invalidate_range = new_range;
-							repeat_loop = true; // we will need to repeat the loop again
-							last_dirty_block = base; // stop the repeat loop once we finish this block
+							repeat_loop = true; // we will need to repeat the query with the wider range
 						}
 
 						// Add texture to result, and update its cache tag
-						tex.cache_tag = cache_tag;
-						result.sections.push_back(&tex);
+						tex->cache_tag = cache_tag;
+						result.sections.push_back(tex);
 
-						if (tex.is_flushable())
+						if (tex->is_flushable())
 						{
 							result.has_flushables = true;
 						}
 					}
 				}
-
-				// Iterate
-				It++;
-
-				// repeat_loop==true means some blocks are still dirty and we need to repeat the loop again
-				if (repeat_loop && It == m_storage.range_end())
-				{
-					It = m_storage.range_begin(invalidate_range, locked_range, true);
-					repeat_loop = false;
-				}
 			}
+			while (repeat_loop);
 
 			AUDIT(result.invalidate_range.is_page_range());
 
@@ -1399,25 +1390,28 @@ namespace rsx
 		template <bool check_unlocked = false>
 		rsx::simple_array<section_storage_type*> find_texture_from_range(const address_range32 &test_range, u32 required_pitch = 0, u32 context_mask = 0xFF)
 		{
+			rsx::simple_array<section_storage_type*> candidates;
 			rsx::simple_array<section_storage_type*> results;
 
-			for (auto It = m_storage.range_begin(test_range, full_range, check_unlocked); It != m_storage.range_end(); It++)
+			m_storage.for_each_section_in_range(test_range, full_range, check_unlocked, [&](section_storage_type& tex)
 			{
-				auto &tex = *It;
-
 				if (!tex.is_dirty() && (context_mask & static_cast<u32>(tex.get_context())))
 				{
 					if (required_pitch && !rsx::pitch_compatible<false>(&tex, required_pitch, -1))
 					{
-						continue;
+						return;
 					}
 
-					if (!tex.sync_protection())
-					{
-						continue;
-					}
+					candidates.push_back(&tex);
+				}
+			});
 
-					results.push_back(&tex);
+			// Protection sync may invalidate sections, which must not happen while walking the index
+			for (auto tex : candidates)
+			{
+				if (tex->sync_protection())
+				{
+					results.push_back(tex);
 				}
 			}
 
@@ -1539,6 +1533,39 @@ namespace rsx
 			return tex;
 		}
 
+		// Brings back an invalidated shader_read section if its memory is identical to the last upload
+		section_storage_type* try_revive_unchanged_section(const address_range32 &range, const image_section_attributes_t& attr, u16 mipmaps, texture_dimension_extended type)
+		{
+			auto section = find_cached_texture(range, { .gcm_format = attr.gcm_format, .width = attr.width, .height = attr.height, .depth = attr.depth, .mipmaps = mipmaps }, false, true, true);
+
+			if (!section ||
+				!section->is_dirty() ||
+				!section->exists() ||
+				section->is_locked() ||
+				section->get_context() != texture_upload_context::shader_read ||
+				section->get_image_type() != type ||
+				section->is_swizzled() != attr.swizzled)
+			{
+				return nullptr;
+			}
+
+			// Lock first so that no write can slip in between the hash check and reuse
+			section->protect(utils::protection::ro);
+
+			if (!section->content_hash_matches())
+			{
+				section->unprotect();
+				return nullptr;
+			}
+
+			read_only_range = section->get_min_max(read_only_range, rsx::section_bounds::locked_range);
+			section->touch(m_cache_update_tag);
+			update_cache_tag();
+
+			m_textures_revived_this_frame++;
+			return section;
+		}
+
 		section_storage_type* find_flushable_section(const address_range32 &memory_range)
 		{
 			auto &block = m_storage.block_for(memory_range);
@@ -2899,8 +2926,6 @@ namespace rsx
 			}
 
 			// Do direct upload from CPU as the last resort
-			m_texture_upload_misses_this_frame++;
-
 			const auto subresources_layout = get_subresources_layout(tex);
 			const auto format_class = classify_format(attributes.gcm_format);
 
@@ -2915,10 +2940,34 @@ namespace rsx
 			const address_range32 tex_range = address_range32::start_length(attributes.address, tex_size);
 			invalidate_range_impl_base(cmd, tex_range, invalidation_cause::read, {}, std::forward<Args>(extras)...);
 
+			if (g_cfg.video.reuse_unchanged_textures)
+			{
+				// Streaming engines often copy identical data over resident textures. If the memory still hashes the same, the old image is up to date.
+				if (auto revived = try_revive_unchanged_section(tex_range, attributes, tex.get_exact_mipmap_count(), extended_dimension))
+				{
+					return
+					{
+						revived->get_view(tex.decoded_remap()),
+						texture_upload_context::shader_read,
+						format_class,
+						scale,
+						extended_dimension,
+						attributes.address
+					};
+				}
+			}
+
+			m_texture_upload_misses_this_frame++;
+
 			// Upload from CPU. Note that sRGB conversion is handled in the FS
 			auto uploaded = upload_image_from_cpu(cmd, tex_range, attributes.width, attributes.height, attributes.depth, tex.get_exact_mipmap_count(), attributes.pitch, attributes.gcm_format,
 				texture_upload_context::shader_read, subresources_layout, extended_dimension, attributes.swizzled);
 
+			if (g_cfg.video.reuse_unchanged_textures)
+			{
+				uploaded->store_content_hash();
+			}
+
 			return
 			{
 				uploaded->get_view(tex.decoded_remap()),
@@ -3969,6 +4018,7 @@ namespace rsx
 			m_texture_upload_calls_this_frame.store(0u);
 			m_texture_upload_misses_this_frame.store(0u);
 			m_texture_copies_ellided_this_frame.store(0u);
+			m_textures_revived_this_frame.store(0u);
 		}
 
 		void on_flush()
@@ -4056,5 +4106,10 @@ namespace rsx
 		{
 			return m_texture_copies_ellided_this_frame;
 		}
+
+		u32 get_textures_revived_this_frame() const
+		{
+			return m_textures_revived_this_frame;
+		}
 	};
 }
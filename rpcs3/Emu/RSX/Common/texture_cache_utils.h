@@ -4,6 +4,7 @@
 #include "texture_cache_types.h"
 #include "texture_cache_predictor.h"
 #include "TextureUtils.h"
+#include "interval_tree.hpp"
 
 #include "Emu/Memory/vm.h"
 #include "Emu/RSX/Host/MM.h"
@@ -474,6 +475,9 @@ namespace rsx
 		texture_cache_type *m_tex_cache;
 		std::unordered_set<block_type*> m_in_use;
 
+		// Sections with a valid range, indexed by their page-aligned CPU range which bounds every section_bounds variant
+		interval_tree<section_storage_type*> m_section_index;
+
 	public:
 		atomic_t<u32> m_unreleased_texture_objects = { 0 }; //Number of invalidated objects not yet freed from memory
 		atomic_t<u64> m_texture_memory_in_use = { 0 };
@@ -547,6 +551,7 @@ namespace rsx
 			}
 
 			m_in_use.clear();
+			m_section_index.clear();
 
 			AUDIT(m_unreleased_texture_objects == 0);
 			AUDIT(m_texture_memory_in_use == 0);
@@ -647,6 +652,16 @@ namespace rsx
 			m_unreleased_texture_objects++;
 		}
 
+		void on_section_range_valid(section_storage_type &section)
+		{
+			m_section_index.insert(section.get_section_range().to_page_range(), &section);
+		}
+
+		void on_section_range_invalid(section_storage_type &section)
+		{
+			m_section_index.erase(&section);
+		}
+
 		void on_section_resources_created(const section_storage_type &section)
 		{
 			m_texture_memory_in_use += section.get_section_size();
@@ -671,6 +686,33 @@ namespace rsx
 			m_in_use.erase(&block);
 		}
 
+		/**
+		 * Overlap queries
+		 */
+		// Calls func(section) for every valid section overlapping 'range' within 'bounds', in ascending base address order.
+		// Sections must not be created, reset or invalidated from func; collect them first if that is needed.
+		template <typename F>
+		void for_each_section_in_range(const address_range32 &range, section_bounds bounds, bool locked_only, F&& func) const
+		{
+			m_section_index.for_each_overlapping(range, [&](section_storage_type* section)
+			{
+				if ((!locked_only || section->is_locked()) && section->overlaps(range, bounds))
+				{
+					func(*section);
+				}
+			});
+		}
+
+		bool has_section_in_range(const address_range32 &range, section_bounds bounds, bool locked_only) const
+		{
+			bool found = false;
+			for_each_section_in_range(range, bounds, locked_only, [&](const section_storage_type&)
+			{
+				found = true;
+			});
+			return found;
+		}
+
 		/**
 		 * Ranged Iterator
 		 */
@@ -913,6 +955,9 @@ namespace rsx
 		void discard();
 		const address_range32& get_bounds(section_bounds bounds) const;
 
+		// Hash of the guest memory currently backing the section
+		u64 fast_hash() const { return fast_hash_internal(); }
+
 		bool is_locked(bool actual_page_flags = false) const;
 
 		/**
@@ -1090,6 +1135,8 @@ namespace rsx
 
 		address_range_vector32 flush_exclusions; // Address ranges that will be skipped during flush
 
+		u64 content_hash = 0; // Guest memory hash at the time of the last CPU upload
+
 		predictor_type *m_predictor = nullptr;
 		usz m_predictor_key_hash = 0;
 		predictor_entry_type *m_predictor_entry = nullptr;
@@ -1157,6 +1204,7 @@ namespace rsx
 			last_write_tag = 0ull;
 
 			m_predictor_entry = nullptr;
+			content_hash = 0;
 
 			readback_behaviour = rsx::memory_read_flags::flush_once;
 			view_flags = rsx::component_order::default_;
@@ -1271,7 +1319,7 @@ namespace rsx
 
 			// Callbacks
 			m_block->on_section_range_valid(*derived());
-			//m_storage->on_section_range_valid(*derived());
+			m_storage->on_section_range_valid(*derived());
 
 			// Reset texture_cache m_flush_always_cache
 			if (readback_behaviour == memory_read_flags::flush_always)
@@ -1293,7 +1341,7 @@ namespace rsx
 
 			// Notify the storage block that we are now invalid
 			m_block->on_section_range_invalid(*derived());
-			//m_storage->on_section_range_invalid(*derived());
+			m_storage->on_section_range_invalid(*derived());
 
 			m_predictor_entry = nullptr;
 			speculatively_flushed = false;
@@ -1459,6 +1507,19 @@ namespace rsx
 			protect(prot, range);
 		}
 
+		/**
+		 * Content hash
+		 */
+		void store_content_hash()
+		{
+			content_hash = fast_hash();
+		}
+
+		bool content_hash_matches() const
+		{
+			return content_hash != 0 && content_hash == fast_hash();
+		}
+
 		/**
 		 * Prediction
 		 */
@@ -50,8 +50,11 @@ namespace rsx
 	struct frame_statistics_t
 	{
 		u32 draw_calls;
+		u32 merged_draw_calls;
 		u32 submit_count;
 
+		s64 fifo_decode_time;
+		s64 method_dispatch_time;
 		s64 setup_time;
 		s64 vertex_upload_time;
 		s64 textures_upload_time;
@@ -64,6 +67,9 @@ namespace rsx
 		u32 program_cache_lookups_total;
 		u32 program_cache_lookups_ellided;
 
+		u32 zcull_batched_readbacks;
+		u32 zcull_syncs_avoided;
+
 		framebuffer_statistics_t framebuffer_stats;
 	};
 
@@ -258,6 +258,12 @@ namespace rsx
 
 	void draw_command_processor::append_array_element(u32 index)
 	{
+		if (m_element_push_buffer.size() == m_element_push_buffer.capacity())
+		{
+			// Grow geometrically, the storage is kept across draws
+			m_element_push_buffer.reserve(m_element_push_buffer.capacity() * 2);
+		}
+
 		// Endianness is swapped because common upload code expects input in BE
 		// TODO: Implement fast upload path for LE inputs and do away with this
 		m_element_push_buffer.push_back(std::bit_cast<u32, be_t<u32>>(index));
@@ -547,6 +553,8 @@ namespace rsx
 
 		if (persistent != nullptr)
 		{
+			// Interleaved blocks are copied verbatim. Byte swapping and format expansion happen in the vertex shader (RSXVertexFetch.glsl),
+			// which reads the layout from the vertex layout buffer, so there is no per-attribute host conversion to specialize here.
 			for (interleaved_range_info* block : layout.interleaved_blocks)
 			{
 				auto range = block->calculate_required_range(first_vertex, vertex_count);
@@ -38,6 +38,11 @@ u64 GLGSRender::get_cycles()
 	return thread_ctrl::get_cycles(static_cast<named_thread<GLGSRender>&>(*this));
 }
 
+u64 GLGSRender::get_cpu_time() const
+{
+	return thread_ctrl::get_cpu_time(static_cast<const named_thread<GLGSRender>&>(*this));
+}
+
 GLGSRender::GLGSRender(utils::serial* ar) noexcept : GSRender(ar)
 {
 	m_shaders_cache = std::make_unique<gl::shader_cache>(m_prog_buffer, "opengl", "v1.95");
@@ -837,7 +842,8 @@ bool GLGSRender::load_program()
 			m_program = m_shader_interpreter.get(
 				current_fp_metadata,
 				current_vertex_program.ctrl,
-				current_fragment_program.ctrl);
+				current_fragment_program.ctrl,
+				current_fragment_program.texture_state.texture_dimensions);
 			return true;
 		}
 	}
@@ -898,7 +904,8 @@ bool GLGSRender::load_program()
 			m_program = m_shader_interpreter.get(
 				current_fp_metadata,
 				current_vertex_program.ctrl,
-				current_fragment_program.ctrl);
+				current_fragment_program.ctrl,
+				current_fragment_program.texture_state.texture_dimensions);
 
 			// Program has changed, reupload
 			m_interpreter_state = rsx::invalidate_pipeline_bits;
@@ -1505,6 +1512,18 @@ void GLGSRender::get_occlusion_query_result(rsx::reports::occlusion_query_info*
 	}
 }
 
+void GLGSRender::sync_occlusion_queries(std::span<rsx::reports::occlusion_query_info* const> queries)
+{
+	if (queries.empty())
+	{
+		return;
+	}
+
+	// Queries complete in submission order, waiting on the newest one makes all the others available
+	GLint result = 0;
+	glGetQueryObjectiv(queries.back()->driver_handle, GL_QUERY_RESULT, &result);
+}
+
 void GLGSRender::discard_occlusion_query(rsx::reports::occlusion_query_info* query)
 {
 	if (query->active)
@@ -160,6 +160,7 @@ class GLGSRender : public GSRender, public ::rsx::reports::ZCULL_control
 
 public:
 	u64 get_cycles() final;
+	u64 get_cpu_time() const final;
 
 	GLGSRender(utils::serial* ar) noexcept;
 	GLGSRender() noexcept : GLGSRender(nullptr) {}
@@ -207,6 +208,7 @@ public:
 	bool check_occlusion_query_status(rsx::reports::occlusion_query_info* query) override;
 	void get_occlusion_query_result(rsx::reports::occlusion_query_info* query) override;
 	void discard_occlusion_query(rsx::reports::occlusion_query_info* query) override;
+	void sync_occlusion_queries(std::span<rsx::reports::occlusion_query_info* const> queries) override;
 
 	// DMA
 	bool release_GCM_label(u32 type, u32 address, u32 data) override;
@@ -8,6 +8,7 @@
 #include "Emu/Cell/Modules/cellVideoOut.h"
 #include "Emu/RSX/Overlays/overlay_manager.h"
 #include "Emu/RSX/Overlays/overlay_debug_overlay.h"
+#include "Emu/perf_meter.hpp"
 
 #include "util/video_provider.h"
 
@@ -161,6 +162,8 @@ gl::texture* GLGSRender::get_present_source(gl::present_surface_info* info, cons
 
 void GLGSRender::flip(const rsx::display_flip_info_t& info)
 {
+	perf_span span("RSX Flip", info.buffer);
+
 	if (info.skip_frame)
 	{
 		m_frame->flip(m_context, true);
@@ -456,6 +459,7 @@ void GLGSRender::flip(const rsx::display_flip_info_t& info)
 		const auto num_texture_upload_miss = m_gl_texture_cache.get_texture_upload_misses_this_frame();
 		const auto texture_upload_miss_ratio = m_gl_texture_cache.get_texture_upload_miss_percentage();
 		const auto texture_copies_ellided = m_gl_texture_cache.get_texture_copies_ellided_this_frame();
+		const auto textures_revived = m_gl_texture_cache.get_textures_revived_this_frame();
 		const auto vertex_cache_hit_count = (info.stats.vertex_cache_request_count - info.stats.vertex_cache_miss_count);
 		const auto vertex_cache_hit_ratio = info.stats.vertex_cache_request_count
 			? (vertex_cache_hit_count * 100) / info.stats.vertex_cache_request_count
@@ -470,6 +474,7 @@ void GLGSRender::flip(const rsx::display_flip_info_t& info)
 			"Internal Resolution:     %s\n"
 			"RSX Load:                %3d%%\n"
 			"draw calls: %16d\n"
+			"merged draw calls: %9d\n"
 			"draw call setup: %11dus\n"
 			"vertex upload time: %8dus\n"
 			"textures upload time: %6dus\n"
@@ -477,16 +482,18 @@ void GLGSRender::flip(const rsx::display_flip_info_t& info)
 			"Unreleased textures: %7d\n"
 			"Texture memory: %12dM\n"
 			"Flush requests: %12d  = %2d (%3d%%) hard faults, %2d unavoidable, %2d misprediction(s), %2d speculation(s)\n"
-			"Texture uploads: %11u (%u from CPU - %02u%%, %u copies avoided)\n"
+			"Texture uploads: %11u (%u from CPU - %02u%%, %u copies avoided, %u unchanged)\n"
 			"Vertex cache hits: %9u/%u (%u%%)\n"
-			"Program cache lookup ellision: %u/%u (%u%%)",
+			"Program cache lookup ellision: %u/%u (%u%%)\n"
+			"ZCULL batched readbacks: %u (%u syncs avoided)",
 			info.stats.framebuffer_stats.to_string(resolution_scaling_config, !backend_config.supports_hw_msaa),
-			get_load(), info.stats.draw_calls, info.stats.setup_time, info.stats.vertex_upload_time,
+			get_load(), info.stats.draw_calls, info.stats.merged_draw_calls, info.stats.setup_time, info.stats.vertex_upload_time,
 			info.stats.textures_upload_time, info.stats.draw_exec_time, num_dirty_textures, texture_memory_size,
 			num_flushes, num_misses, cache_miss_ratio, num_unavoidable, num_mispredict, num_speculate,
-			num_texture_upload, num_texture_upload_miss, texture_upload_miss_ratio, texture_copies_ellided,
+			num_texture_upload, num_texture_upload_miss, texture_upload_miss_ratio, texture_copies_ellided, textures_revived,
 			vertex_cache_hit_count, info.stats.vertex_cache_request_count, vertex_cache_hit_ratio,
-			program_cache_ellided, program_cache_lookups, program_cache_ellision_rate)
+			program_cache_ellided, program_cache_lookups, program_cache_ellision_rate,
+			info.stats.zcull_batched_readbacks, info.stats.zcull_syncs_avoided)
 		);
 	}
 
@@ -109,7 +109,7 @@ namespace gl
 		}
 	}
 
-	glsl::program* shader_interpreter::get(const interpreter::program_metadata& metadata, u32 vp_ctrl, u32 fp_ctrl)
+	glsl::program* shader_interpreter::get(const interpreter::program_metadata& metadata, u32 vp_ctrl, u32 fp_ctrl, u32 fp_texture_dimensions)
 	{
 		// Build options
 		u64 opt = 0;
@@ -146,7 +146,7 @@ namespace gl
 		if (fp_ctrl & CELL_GCM_SHADER_CONTROL_32_BITS_EXPORTS) opt |= COMPILER_OPT_ENABLE_F32_EXPORT;
 		if (fp_ctrl & RSX_SHADER_CONTROL_USES_KIL) opt |= COMPILER_OPT_ENABLE_KIL;
 		if (fp_ctrl & RSX_SHADER_CONTROL_ROP_OUTPUT_REMAP) opt |= COMPILER_OPT_ENABLE_ROP_REMAP;
-		if (metadata.referenced_textures_mask) opt |= COMPILER_OPT_ENABLE_TEXTURES;
+		opt |= program_common::interpreter::get_texture_options(metadata.referenced_textures_mask, fp_texture_dimensions);
 		if (metadata.has_branch_instructions) opt |= COMPILER_OPT_ENABLE_FLOW_CTRL;
 		if (metadata.has_pack_instructions) opt |= COMPILER_OPT_ENABLE_PACKING;
 		if (rsx::method_registers.polygon_stipple_enabled()) opt |= COMPILER_OPT_ENABLE_STIPPLING;
@@ -377,6 +377,11 @@ namespace gl
 
 		if (compiler_options & COMPILER_OPT_ENABLE_TEXTURES)
 		{
+			if (compiler_options & COMPILER_OPT_ENABLE_TEXTURE_TYPES)
+			{
+				builder << "#define WITH_TEXTURE_TYPES\n";
+			}
+
 			builder << "#define WITH_TEXTURES\n\n";
 
 			const char* type_names[] = { "sampler1D", "sampler2D", "samplerCube", "sampler3D" };
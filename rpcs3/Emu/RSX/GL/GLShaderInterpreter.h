@@ -135,7 +135,7 @@ namespace gl
 		void flush_fragment_texture_bindings(glsl::program* program = nullptr);
 		void flush_vertex_texture_bindings(glsl::program* program = nullptr);
 
-		glsl::program* get(const interpreter::program_metadata& fp_metadata, u32 vp_ctrl, u32 fp_ctrl);
+		glsl::program* get(const interpreter::program_metadata& fp_metadata, u32 vp_ctrl, u32 fp_ctrl, u32 fp_texture_dimensions);
 		bool is_interpreter(const glsl::program* program) const;
 	};
 }
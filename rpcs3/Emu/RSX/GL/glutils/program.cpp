@@ -3,6 +3,7 @@
 #include "state_tracker.hpp"
 
 #include "Emu/system_config.h"
+#include "Emu/perf_meter.hpp"
 
 namespace gl
 {
@@ -179,6 +180,8 @@ namespace gl
 			ensure(!m_init_fence.is_empty()); // Do not attempt to compile a shader_view!!
 			m_init_fence.server_wait_sync();
 
+			perf_span span("GL Shader Compile");
+
 			glCompileShader(m_id);
 
 			GLint status = GL_FALSE;
@@ -3,6 +3,7 @@
 #include "nv47_sync.hpp"
 
 #include "Emu/RSX/RSXThread.h"
+#include "Emu/perf_meter.hpp"
 
 #include "context_accessors.define.h"
 
@@ -47,6 +48,8 @@ namespace rsx
 				RSX(ctx)->flush_fifo();
 			}
 
+			perf_span span("RSX Semaphore Wait", addr);
+
 			u64 start = get_system_time();
 			u64 last_check_val = start;
 
@@ -1,17 +1,111 @@
 #include "stdafx.h"
 #include "NullGSRender.h"
+#include "Emu/RSX/Common/BufferUtils.h"
+#include "Emu/RSX/rsx_methods.h"
 
 u64 NullGSRender::get_cycles()
 {
 	return thread_ctrl::get_cycles(static_cast<named_thread<NullGSRender>&>(*this));
 }
 
+u64 NullGSRender::get_cpu_time() const
+{
+	return thread_ctrl::get_cpu_time(static_cast<const named_thread<NullGSRender>&>(*this));
+}
+
 NullGSRender::NullGSRender(utils::serial* ar) noexcept : GSRender(ar)
 {
 }
 
+void NullGSRender::emit_geometry(u32 sub_index)
+{
+	auto& draw_call = rsx::method_registers.current_draw_clause;
+	const rsx::flags32_t vertex_state_mask = rsx::vertex_base_changed | rsx::vertex_arrays_changed;
+	const rsx::flags32_t vertex_state = (sub_index == 0) ? rsx::vertex_arrays_changed : draw_call.execute_pipeline_dependencies(m_ctx) & vertex_state_mask;
+
+	if (vertex_state)
+	{
+		m_draw_processor.analyse_inputs_interleaved(m_vertex_layout, current_vp_metadata);
+	}
+
+	if (!m_vertex_layout.validate())
+	{
+		return;
+	}
+
+	// Same index processing as the hardware backends, minus the primitive emulation
+	u32 min_index = draw_call.min_index();
+	u32 max_index = 0;
+	bool index_rebase = false;
+
+	if (const auto command = m_draw_processor.get_draw_command(rsx::method_registers);
+		const auto indexed = std::get_if<rsx::draw_indexed_array_command>(&command))
+	{
+		const auto type = draw_call.is_immediate_draw ? rsx::index_array_type::u32 : rsx::method_registers.index_type();
+		const u32 max_size = draw_call.get_elements_count() * get_index_type_size(type);
+
+		m_index_scratch.resize(max_size);
+
+		std::tie(min_index, max_index, std::ignore) = write_index_array_data_to_buffer(
+			m_index_scratch, indexed->raw_index_buffer, type,
+			draw_call.primitive,
+			rsx::method_registers.restart_index_enabled(),
+			rsx::method_registers.restart_index(),
+			[](auto) { return false; });
+
+		if (min_index >= max_index)
+		{
+			return;
+		}
+
+		index_rebase = true;
+	}
+	else if (std::holds_alternative<rsx::draw_inlined_array>(command))
+	{
+		const auto stream_length = draw_call.inline_vertex_array.size();
+		min_index = 0;
+		max_index = u32(stream_length * sizeof(u32)) / m_vertex_layout.interleaved_blocks[0]->attribute_stride;
+	}
+	else
+	{
+		max_index = (min_index + draw_call.get_elements_count()) - 1;
+	}
+
+	const u32 vertex_count = (max_index - min_index) + 1;
+	const u32 vertex_base = index_rebase ? rsx::get_index_from_base(min_index, rsx::method_registers.vertex_data_base_index()) : min_index;
+
+	const auto [persistent_size, volatile_size] = calculate_memory_requirements(m_vertex_layout, vertex_base, vertex_count);
+	m_persistent_scratch.resize(persistent_size);
+	m_volatile_scratch.resize(volatile_size);
+
+	m_draw_processor.write_vertex_data_to_memory(m_vertex_layout, vertex_base, vertex_count, m_persistent_scratch.data(), m_volatile_scratch.data());
+}
+
 void NullGSRender::end()
 {
-	execute_nop_draw();
+	if (!is_benchmarking() || skip_current_frame || cond_render_ctrl.disable_rendering()) [[likely]]
+	{
+		execute_nop_draw();
+		rsx::thread::end();
+		return;
+	}
+
+	// There is no backend to feed, but emulate the CPU-side work of one so that it can be measured
+	m_profiler.start();
+
+	analyse_current_rsx_pipeline();
+	m_frame_stats.setup_time += m_profiler.duration();
+
+	auto& draw_call = rsx::method_registers.current_draw_clause;
+	draw_call.begin();
+	u32 subdraw = 0u;
+	do
+	{
+		emit_geometry(subdraw++);
+	}
+	while (draw_call.next());
+
+	m_frame_stats.vertex_upload_time += m_profiler.duration();
+
 	rsx::thread::end();
 }
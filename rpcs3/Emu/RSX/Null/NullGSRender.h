@@ -5,10 +5,19 @@ class NullGSRender : public GSRender
 {
 public:
 	u64 get_cycles() final;
+	u64 get_cpu_time() const final;
 
 	NullGSRender(utils::serial* ar) noexcept;
 	NullGSRender() noexcept : NullGSRender(nullptr) {}
 
 private:
+	// CPU-side geometry processing is only performed when benchmarking
+	rsx::vertex_input_layout m_vertex_layout;
+	std::vector<std::byte> m_index_scratch;
+	std::vector<std::byte> m_persistent_scratch;
+	std::vector<std::byte> m_volatile_scratch;
+
+	void emit_geometry(u32 sub_index);
+
 	void end() override;
 };
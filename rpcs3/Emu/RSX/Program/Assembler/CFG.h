@@ -6,6 +6,7 @@
 #include <list>
 
 struct RSXFragmentProgram;
+struct RSXVertexProgram;
 
 namespace rsx::assembler
 {
@@ -40,5 +41,6 @@ namespace rsx::assembler
 	};
 
 	FlowGraph deconstruct_fragment_program(const RSXFragmentProgram& prog);
+	FlowGraph deconstruct_vertex_program(const RSXVertexProgram& prog);
 }
 
@@ -79,6 +79,7 @@ namespace rsx::assembler
 		ENDIF,
 		LOOP,
 		ENDLOOP,
+		BRANCH,  // Unstructured jump, only used by vertex programs
 	};
 
 	struct FlowEdge
@@ -0,0 +1,134 @@
+#include "stdafx.h"
+
+#include "CopyPropagationPass.h"
+#include "Emu/RSX/Program/Assembler/FPOpcodes.h"
+#include "Emu/RSX/Program/RSXFragmentProgram.h"
+
+namespace rsx::assembler::FP
+{
+	static bool is_propagatable_copy(const Instruction& instruction)
+	{
+		const OPDEST dst{ .HEX = instruction.bytecode[0] };
+		const SRC0 src0{ .HEX = instruction.bytecode[1] };
+		const SRC1 src1{ .HEX = instruction.bytecode[2] };
+
+		if (instruction.opcode != RSX_FP_OPCODE_MOV ||
+			dst.no_dest || dst.set_cond ||                              // Must be a plain register write
+			dst.saturate || dst.exp_tex || src1.scale ||                // No output modifiers
+			src0.reg_type != RSX_FP_REGISTER_TYPE_TEMP ||               // Must read from reg
+			src0.fp16 != dst.fp16 ||                                    // No width conversion
+			src0.abs || src0.neg || src1.src0_prec_mod ||               // No input modifiers
+			!(src0.exec_if_lt && src0.exec_if_eq && src0.exec_if_gr))  // Must execute unconditionally
+		{
+			return false;
+		}
+
+		if (src0.tmp_reg_index == dst.dest_reg)
+		{
+			// Self-move, dead code elimination takes care of these
+			return false;
+		}
+
+		switch (dst.prec)
+		{
+		case RSX_FP_PRECISION_REAL:
+			return true;
+		case RSX_FP_PRECISION_HALF:
+			// Rounding a half register to half precision changes nothing
+			return !!dst.fp16;
+		default:
+			return false;
+		}
+	}
+
+	static bool overlaps(const rsx::simple_array<u32>& a, const rsx::simple_array<u32>& b)
+	{
+		for (const auto& index : a)
+		{
+			if (b.find_if(FN(x == index)))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	static rsx::simple_array<u32> get_full_register_range(u32 index, bool fp16)
+	{
+		return get_register_file_range({ .reg{ .id = static_cast<int>(index), .f16 = fp16 }, .mask = 0xF });
+	}
+
+	static void propagate_copy(BasicBlock& block, usz copy_index)
+	{
+		const auto& copy = block.instructions[copy_index];
+		const OPDEST copy_dst{ .HEX = copy.bytecode[0] };
+		const SRC0 copy_src{ .HEX = copy.bytecode[1] };
+
+		const u32 copy_swizzle[4] = { copy_src.swizzle_x, copy_src.swizzle_y, copy_src.swizzle_z, copy_src.swizzle_w };
+		const u32 copy_mask = copy_dst.write_mask;
+
+		// Any write touching either register, including aliased lanes of the other width, ends the forwarding window
+		const auto dst_range = get_full_register_range(copy_dst.dest_reg, copy_dst.fp16);
+		const auto src_range = get_full_register_range(copy_src.tmp_reg_index, copy_src.fp16);
+
+		for (usz i = copy_index + 1; i < block.instructions.size(); ++i)
+		{
+			auto& instruction = block.instructions[i];
+			const auto opcode = static_cast<FP_opcode>(instruction.opcode);
+			if (!is_instruction_valid(opcode))
+			{
+				break;
+			}
+
+			const u32 operand_count = get_operand_count(opcode);
+			for (u32 operand = 0; operand < operand_count; ++operand)
+			{
+				SRC_Common src{ .HEX = instruction.bytecode[operand + 1] };
+				if (src.reg_type != RSX_FP_REGISTER_TYPE_TEMP ||
+					src.tmp_reg_index != copy_dst.dest_reg ||
+					src.fp16 != copy_dst.fp16)
+				{
+					continue;
+				}
+
+				// Every channel of the read has to come from a lane written by the copy.
+				// Unused channels are not excluded since some readers load more channels than their lane mask suggests.
+				const u32 swizzle[4] = { src.swizzle_x, src.swizzle_y, src.swizzle_z, src.swizzle_w };
+				if (std::any_of(std::begin(swizzle), std::end(swizzle), [&](u32 channel) { return !(copy_mask & (1u << channel)); }))
+				{
+					continue;
+				}
+
+				src.tmp_reg_index = copy_src.tmp_reg_index;
+				src.swizzle_x = copy_swizzle[swizzle[0]];
+				src.swizzle_y = copy_swizzle[swizzle[1]];
+				src.swizzle_z = copy_swizzle[swizzle[2]];
+				src.swizzle_w = copy_swizzle[swizzle[3]];
+				instruction.bytecode[operand + 1] = src.HEX;
+			}
+
+			const auto written = get_register_file_range(get_dst_register(&instruction));
+			if (overlaps(written, dst_range) || overlaps(written, src_range))
+			{
+				break;
+			}
+		}
+	}
+
+	bool CopyPropagationPass::run(FlowGraph& graph)
+	{
+		for (auto& block : graph.blocks)
+		{
+			for (usz i = 0; i < block.instructions.size(); ++i)
+			{
+				if (is_propagatable_copy(block.instructions[i]))
+				{
+					propagate_copy(block, i);
+				}
+			}
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "../../CFG.h"
+
+namespace rsx::assembler::FP
+{
+	// The copy propagation pass forwards plain register moves into the instructions that consume them.
+	// A move qualifies when it carries no modifiers or conversions and executes unconditionally. Readers are rewritten to load the
+	// move's source directly, until either register is written again. The move itself is left for dead code elimination to remove.
+	// Must run before register annotation since it rewrites the raw source operands.
+	class CopyPropagationPass : public CFGPass
+	{
+	public:
+		bool run(FlowGraph& graph) override;
+	};
+}
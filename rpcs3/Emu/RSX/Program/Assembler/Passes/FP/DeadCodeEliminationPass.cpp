@@ -0,0 +1,201 @@
+#include "stdafx.h"
+
+#include "DeadCodeEliminationPass.h"
+#include "Emu/RSX/Program/Assembler/FPOpcodes.h"
+#include "Emu/RSX/Program/RSXFragmentProgram.h"
+
+#include <bitset>
+
+namespace rsx::assembler::FP
+{
+	using namespace constants;
+
+	using register_file_mask_t = std::bitset<register_file_max_len>;
+
+	static bool is_flow_control(u32 opcode)
+	{
+		switch (opcode)
+		{
+		case RSX_FP_OPCODE_BRK:
+		case RSX_FP_OPCODE_CAL:
+		case RSX_FP_OPCODE_IFE:
+		case RSX_FP_OPCODE_LOOP:
+		case RSX_FP_OPCODE_REP:
+		case RSX_FP_OPCODE_RET:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	static bool has_side_effects(const Instruction& instruction)
+	{
+		const OPDEST dst{ .HEX = instruction.bytecode[0] };
+		if (dst.set_cond)
+		{
+			// Updates the condition code registers
+			return true;
+		}
+
+		switch (instruction.opcode)
+		{
+		case RSX_FP_OPCODE_KIL:
+		case RSX_FP_OPCODE_FENCT:
+		case RSX_FP_OPCODE_FENCB:
+		case RSX_FP_OPCODE_OR16_LO:
+		case RSX_FP_OPCODE_OR16_HI:
+			return true;
+		default:
+			return is_flow_control(instruction.opcode) ||
+				!is_instruction_valid(static_cast<FP_opcode>(instruction.opcode));
+		}
+	}
+
+	static bool is_unconditional(const Instruction& instruction)
+	{
+		const SRC0 src0{ .HEX = instruction.bytecode[1] };
+		return src0.exec_if_lt && src0.exec_if_eq && src0.exec_if_gr;
+	}
+
+	// MOV Rn, Rn with no modifiers. The delay slots emitted by the RSX compiler look like this.
+	static bool is_self_move(const Instruction& instruction)
+	{
+		const OPDEST dst{ .HEX = instruction.bytecode[0] };
+		const SRC0 src0{ .HEX = instruction.bytecode[1] };
+		const SRC1 src1{ .HEX = instruction.bytecode[2] };
+
+		if (instruction.opcode != RSX_FP_OPCODE_MOV ||
+			dst.no_dest || dst.set_cond ||
+			dst.saturate || dst.exp_tex || src1.scale ||
+			src0.reg_type != RSX_FP_REGISTER_TYPE_TEMP ||
+			src0.tmp_reg_index != dst.dest_reg ||
+			src0.fp16 != dst.fp16 ||
+			src0.abs || src0.neg || src1.src0_prec_mod)
+		{
+			return false;
+		}
+
+		switch (dst.prec)
+		{
+		case RSX_FP_PRECISION_REAL:
+			break;
+		case RSX_FP_PRECISION_HALF:
+			// Rounding a half register to half precision is a no-op. Doing the same on a full register is not.
+			if (!dst.fp16) return false;
+			break;
+		default:
+			return false;
+		}
+
+		if (dst.mask_x && src0.swizzle_x != 0) return false;
+		if (dst.mask_y && src0.swizzle_y != 1) return false;
+		if (dst.mask_z && src0.swizzle_z != 2) return false;
+		if (dst.mask_w && src0.swizzle_w != 3) return false;
+
+		return true;
+	}
+
+	static register_file_mask_t get_read_mask(const Instruction& instruction)
+	{
+		register_file_mask_t result;
+
+		const auto opcode = static_cast<FP_opcode>(instruction.opcode);
+		const u32 operand_count = get_operand_count(opcode);
+
+		for (u32 operand = 0; operand < operand_count; ++operand)
+		{
+			const SRC_Common src{ .HEX = instruction.bytecode[operand + 1] };
+			if (src.reg_type != RSX_FP_REGISTER_TYPE_TEMP)
+			{
+				continue;
+			}
+
+			// Assume the whole register is read, lane masks are not reliable enough to prove a write dead
+			const RegisterRef ref{ .reg{ .id = static_cast<int>(src.tmp_reg_index), .f16 = !!src.fp16 }, .mask = 0xF };
+			for (const auto& index : get_register_file_range(ref))
+			{
+				result.set(index);
+			}
+		}
+
+		return result;
+	}
+
+	static register_file_mask_t get_write_mask(const Instruction& instruction)
+	{
+		register_file_mask_t result;
+		for (const auto& index : get_register_file_range(get_dst_register(&instruction)))
+		{
+			result.set(index);
+		}
+		return result;
+	}
+
+	static void eliminate_dead_code(BasicBlock& block)
+	{
+		// Lanes that are overwritten further down the block before anything reads them.
+		// Walking backwards, nothing is known to be overwritten at the block exit.
+		register_file_mask_t overwritten;
+		std::vector<bool> dead(block.instructions.size(), false);
+
+		for (usz i = block.instructions.size(); i-- > 0;)
+		{
+			const auto& instruction = block.instructions[i];
+
+			if (is_flow_control(instruction.opcode))
+			{
+				// Execution may leave the block here
+				overwritten.reset();
+				continue;
+			}
+
+			if (is_self_move(instruction))
+			{
+				dead[i] = true;
+				continue;
+			}
+
+			const auto written = get_write_mask(instruction);
+			if (!has_side_effects(instruction) && (written & ~overwritten).none())
+			{
+				dead[i] = true;
+				continue;
+			}
+
+			if (is_unconditional(instruction))
+			{
+				overwritten |= written;
+			}
+
+			overwritten &= ~get_read_mask(instruction);
+		}
+
+		usz count = 0;
+		for (usz i = 0; i < block.instructions.size(); ++i)
+		{
+			if (dead[i])
+			{
+				continue;
+			}
+
+			if (count != i)
+			{
+				block.instructions[count] = std::move(block.instructions[i]);
+			}
+
+			count++;
+		}
+
+		block.instructions.resize(count);
+	}
+
+	bool DeadCodeEliminationPass::run(FlowGraph& graph)
+	{
+		for (auto& block : graph.blocks)
+		{
+			eliminate_dead_code(block);
+		}
+
+		return true;
+	}
+}
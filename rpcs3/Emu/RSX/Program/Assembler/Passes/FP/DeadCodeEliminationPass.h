@@ -0,0 +1,16 @@
+#pragma once
+
+#include "../../CFG.h"
+
+namespace rsx::assembler::FP
+{
+	// The dead code elimination pass removes instructions whose results can never be observed.
+	// This covers writes that are fully overwritten later in the same block before being read, instructions without any outputs,
+	// and moves of a register onto itself at its own precision, which the decompiler would otherwise emit as a no-op conversion.
+	// Liveness is not tracked across blocks; anything written by a block is assumed to be read by its successors.
+	class DeadCodeEliminationPass : public CFGPass
+	{
+	public:
+		bool run(FlowGraph& graph) override;
+	};
+}
@@ -0,0 +1,234 @@
+#include "stdafx.h"
+
+#include "DeadOutputEliminationPass.h"
+#include "Emu/RSX/Program/Assembler/VPOpcodes.h"
+#include "Emu/RSX/Program/RSXVertexProgram.h"
+#include "Emu/RSX/gcm_enums.h"
+
+#include <bitset>
+#include <unordered_map>
+
+namespace rsx::assembler::VP
+{
+	using namespace constants;
+
+	// Temporaries R0-R63 followed by the result registers, 4 lanes each
+	constexpr u32 output_lane_base = temp_register_count * 4;
+	using live_set_t = std::bitset<(temp_register_count + output_register_count) * 4>;
+
+	struct operation_info_t
+	{
+		bool active = false;      // Emits any code at all
+		bool removable = false;   // Only writes registers, can be dropped if nothing reads them
+		bool conditional = false; // Writes do not fully replace the old value
+		live_set_t writes;
+		live_set_t reads;
+	};
+
+	static void add_lanes(live_set_t& set, u32 base, const RegisterRef& ref)
+	{
+		for (u32 lane = 0; lane < 4; ++lane)
+		{
+			if (ref.mask & (1u << lane))
+			{
+				set.set(base + ref.reg.id * 4 + lane);
+			}
+		}
+	}
+
+	static operation_info_t get_operation_info(const Instruction& instruction, bool is_sca)
+	{
+		operation_info_t result;
+
+		const u32 opcode = is_sca ? get_sca_opcode(&instruction) : get_vec_opcode(&instruction);
+		if (opcode == 0)
+		{
+			// NOP in either slot
+			return result;
+		}
+
+		result.active = true;
+
+		if (is_sca && is_flow_control(opcode))
+		{
+			// Only reads the condition code and address registers, which are not tracked
+			return result;
+		}
+
+		result.removable = !writes_control_registers(&instruction, is_sca);
+		result.conditional = is_conditional(&instruction);
+
+		if (const auto dst = get_dst_register(&instruction, is_sca))
+		{
+			add_lanes(result.writes, 0, dst);
+		}
+
+		if (const auto output = get_output_register(&instruction, is_sca);
+			output && output.reg.id < static_cast<int>(output_register_count))
+		{
+			add_lanes(result.writes, output_lane_base, output);
+		}
+
+		const u32 operand_mask = is_sca ? 0b100 : get_vec_operand_mask(opcode);
+		for (u32 operand = 0; operand < 3; ++operand)
+		{
+			if (operand_mask & (1u << operand))
+			{
+				add_lanes(result.reads, 0, get_src_register(&instruction, operand));
+			}
+		}
+
+		return result;
+	}
+
+	// Walks the block backwards from its live-out set and returns the live-in set.
+	// Optionally records which halves of each instruction are dead, bit 0 for the vector half and bit 1 for the scalar half.
+	static live_set_t propagate_liveness(const BasicBlock& block, live_set_t live, std::vector<u8>* dead = nullptr)
+	{
+		for (usz i = block.instructions.size(); i-- > 0;)
+		{
+			const auto& instruction = block.instructions[i];
+
+			// The decompiler emits the vector half first, so the scalar half is visited first going backwards
+			for (const bool is_sca : { true, false })
+			{
+				const auto info = get_operation_info(instruction, is_sca);
+				if (!info.active)
+				{
+					continue;
+				}
+
+				if (info.removable && (info.writes & live).none())
+				{
+					if (dead)
+					{
+						(*dead)[i] |= is_sca ? 2 : 1;
+					}
+					continue;
+				}
+
+				if (!info.conditional)
+				{
+					live &= ~info.writes;
+				}
+
+				live |= info.reads;
+			}
+		}
+
+		return live;
+	}
+
+	u64 DeadOutputEliminationPass::get_live_output_lanes(u32 output_mask)
+	{
+		// Mirrors the output tables of the shader backends. O0 holds the position and is always consumed.
+		u64 result = 0xF;
+
+		auto add_output = [&](u32 reg, u32 lanes, u32 mask)
+		{
+			if (output_mask & mask)
+			{
+				result |= u64{ lanes } << (reg * 4);
+			}
+		};
+
+		constexpr u32 diffuse = CELL_GCM_ATTRIB_OUTPUT_MASK_FRONTDIFFUSE | CELL_GCM_ATTRIB_OUTPUT_MASK_BACKDIFFUSE;
+		constexpr u32 specular = CELL_GCM_ATTRIB_OUTPUT_MASK_FRONTSPECULAR | CELL_GCM_ATTRIB_OUTPUT_MASK_BACKSPECULAR;
+
+		add_output(1, 0xF, diffuse);
+		add_output(2, 0xF, specular);
+		add_output(3, 0xF, diffuse);
+		add_output(4, 0xF, specular);
+
+		// Fog and user clip planes share O5 and O6 with the point size and the last texture coordinate
+		add_output(5, 0x1, CELL_GCM_ATTRIB_OUTPUT_MASK_FOG);
+		add_output(5, 0x2, CELL_GCM_ATTRIB_OUTPUT_MASK_UC0);
+		add_output(5, 0x4, CELL_GCM_ATTRIB_OUTPUT_MASK_UC1);
+		add_output(5, 0x8, CELL_GCM_ATTRIB_OUTPUT_MASK_UC2);
+		add_output(6, 0x1, CELL_GCM_ATTRIB_OUTPUT_MASK_POINTSIZE);
+		add_output(6, 0x2, CELL_GCM_ATTRIB_OUTPUT_MASK_UC3);
+		add_output(6, 0x4, CELL_GCM_ATTRIB_OUTPUT_MASK_UC4);
+		add_output(6, 0x8, CELL_GCM_ATTRIB_OUTPUT_MASK_UC5);
+		add_output(6, 0xF, CELL_GCM_ATTRIB_OUTPUT_MASK_TEX9);
+
+		for (u32 i = 0; i < 8; ++i)
+		{
+			add_output(7 + i, 0xF, CELL_GCM_ATTRIB_OUTPUT_MASK_TEX0 << i);
+		}
+
+		add_output(15, 0xF, CELL_GCM_ATTRIB_OUTPUT_MASK_TEX8);
+		return result;
+	}
+
+	bool DeadOutputEliminationPass::run(FlowGraph& graph)
+	{
+		for (const auto& block : graph.blocks)
+		{
+			for (const auto& instruction : block.instructions)
+			{
+				if (is_subroutine(get_sca_opcode(&instruction)) || !is_instruction_valid(&instruction))
+				{
+					return false;
+				}
+			}
+		}
+
+		live_set_t exit_live;
+		const u64 live_outputs = get_live_output_lanes(m_output_mask);
+		for (u32 lane = 0; lane < output_register_count * 4; ++lane)
+		{
+			exit_live[output_lane_base + lane] = !!(live_outputs & (1ull << lane));
+		}
+
+		auto get_live_out = [&](const BasicBlock& block, const std::unordered_map<const BasicBlock*, live_set_t>& live_in)
+		{
+			if (block.succ.empty())
+			{
+				return exit_live;
+			}
+
+			live_set_t result;
+			for (const auto& edge : block.succ)
+			{
+				if (const auto found = live_in.find(edge.to); found != live_in.end())
+				{
+					result |= found->second;
+				}
+			}
+			return result;
+		};
+
+		// Solve backwards until nothing changes. Back edges from loops need more than one round.
+		std::unordered_map<const BasicBlock*, live_set_t> live_in;
+		for (bool changed = true; changed;)
+		{
+			changed = false;
+
+			for (auto it = graph.blocks.rbegin(); it != graph.blocks.rend(); ++it)
+			{
+				const auto result = propagate_liveness(*it, get_live_out(*it, live_in));
+				auto& entry = live_in[&(*it)];
+
+				if (entry != result)
+				{
+					entry = result;
+					changed = true;
+				}
+			}
+		}
+
+		for (auto& block : graph.blocks)
+		{
+			std::vector<u8> dead(block.instructions.size(), 0);
+			propagate_liveness(block, get_live_out(block, live_in), &dead);
+
+			for (usz i = 0; i < block.instructions.size(); ++i)
+			{
+				if (dead[i] & 1) clear_opcode(&block.instructions[i], false);
+				if (dead[i] & 2) clear_opcode(&block.instructions[i], true);
+			}
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "../../CFG.h"
+
+namespace rsx::assembler::VP
+{
+	// The dead output elimination pass removes vector and scalar operations whose results can never reach a consumed vertex output.
+	// Live outputs are taken from the vertex attribute output mask, which lists the varyings the bound fragment program reads and is
+	// part of the vertex program cache key. Liveness is tracked per register lane across the whole graph, so temporaries that only feed
+	// disabled outputs are removed too. Removed halves are rewritten to NOPs in place.
+	// Programs using subroutines are left untouched since the decompiler does not follow the hardware call semantics exactly.
+	class DeadOutputEliminationPass : public CFGPass
+	{
+	public:
+		DeadOutputEliminationPass(u32 output_mask)
+			: m_output_mask(output_mask)
+		{}
+
+		bool run(FlowGraph& graph) override;
+
+		// Returns a 4-bit lane mask per result register O0-O15 for the outputs that are consumed after the vertex stage
+		static u64 get_live_output_lanes(u32 output_mask);
+
+	private:
+		u32 m_output_mask = 0;
+	};
+}
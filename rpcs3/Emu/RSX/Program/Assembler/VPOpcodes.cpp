@@ -0,0 +1,249 @@
+#include "stdafx.h"
+#include "VPOpcodes.h"
+
+#include "Emu/RSX/Program/RSXVertexProgram.h"
+
+namespace rsx::assembler::VP
+{
+	static SRC decode_src(const Instruction* instruction, u32 operand)
+	{
+		const D1 d1{ .HEX = instruction->bytecode[1] };
+		const D2 d2{ .HEX = instruction->bytecode[2] };
+		const D3 d3{ .HEX = instruction->bytecode[3] };
+
+		SRC src{};
+		switch (operand)
+		{
+		case 0:
+			src.src0l = d2.src0l;
+			src.src0h = d1.src0h;
+			break;
+		case 1:
+			src.src1 = d2.src1;
+			break;
+		case 2:
+			src.src2l = d3.src2l;
+			src.src2h = d2.src2h;
+			break;
+		default:
+			fmt::throw_exception("Invalid VP operand %u", operand);
+		}
+		return src;
+	}
+
+	u32 get_vec_opcode(const Instruction* instruction)
+	{
+		const D1 d1{ .HEX = instruction->bytecode[1] };
+		return d1.vec_opcode;
+	}
+
+	u32 get_sca_opcode(const Instruction* instruction)
+	{
+		const D1 d1{ .HEX = instruction->bytecode[1] };
+		return d1.sca_opcode;
+	}
+
+	bool is_vec_instruction_valid(u32 opcode)
+	{
+		return opcode <= RSX_VEC_OPCODE_SSG || opcode == RSX_VEC_OPCODE_TXL;
+	}
+
+	bool is_sca_instruction_valid(u32 opcode)
+	{
+		return opcode <= RSX_SCA_OPCODE_POP;
+	}
+
+	bool is_branch(u32 sca_opcode)
+	{
+		switch (sca_opcode)
+		{
+		case RSX_SCA_OPCODE_BRA:
+		case RSX_SCA_OPCODE_BRI:
+		case RSX_SCA_OPCODE_BRB:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	bool is_subroutine(u32 sca_opcode)
+	{
+		switch (sca_opcode)
+		{
+		case RSX_SCA_OPCODE_CAL:
+		case RSX_SCA_OPCODE_CLI:
+		case RSX_SCA_OPCODE_CLB:
+		case RSX_SCA_OPCODE_RET:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	bool is_flow_control(u32 sca_opcode)
+	{
+		return is_branch(sca_opcode) ||
+			is_subroutine(sca_opcode) ||
+			sca_opcode == RSX_SCA_OPCODE_PSH ||
+			sca_opcode == RSX_SCA_OPCODE_POP;
+	}
+
+	u32 get_branch_target(const Instruction* instruction)
+	{
+		const D0 d0{ .HEX = instruction->bytecode[0] };
+		const D2 d2{ .HEX = instruction->bytecode[2] };
+		const D3 d3{ .HEX = instruction->bytecode[3] };
+		return (d0.iaddrh2 << 9) | (d2.iaddrh << 3) | d3.iaddrl;
+	}
+
+	bool is_instruction_valid(const Instruction* instruction)
+	{
+		for (u32 operand = 0; operand < 3; ++operand)
+		{
+			if (!decode_src(instruction, operand).reg_type)
+			{
+				return false;
+			}
+		}
+
+		return is_vec_instruction_valid(get_vec_opcode(instruction)) &&
+			is_sca_instruction_valid(get_sca_opcode(instruction));
+	}
+
+	bool is_program_exit(const Instruction* instruction)
+	{
+		const D3 d3{ .HEX = instruction->bytecode[3] };
+		return d3.end || !is_instruction_valid(instruction);
+	}
+
+	u32 get_vec_operand_mask(u32 vec_opcode)
+	{
+		switch (vec_opcode)
+		{
+		case RSX_VEC_OPCODE_NOP:
+		case RSX_VEC_OPCODE_SFL:
+		case RSX_VEC_OPCODE_STR:
+			return 0;
+		case RSX_VEC_OPCODE_MOV:
+		case RSX_VEC_OPCODE_ARL:
+		case RSX_VEC_OPCODE_FRC:
+		case RSX_VEC_OPCODE_FLR:
+		case RSX_VEC_OPCODE_SSG:
+		case RSX_VEC_OPCODE_TXL:
+			return 0b001;
+		case RSX_VEC_OPCODE_ADD:
+			return 0b101;
+		case RSX_VEC_OPCODE_MAD:
+			return 0b111;
+		default:
+			return 0b011;
+		}
+	}
+
+	RegisterRef get_src_register(const Instruction* instruction, u32 operand)
+	{
+		const SRC src = decode_src(instruction, operand);
+		if (src.reg_type != RSX_VP_REGISTER_TYPE_TEMP)
+		{
+			return {};
+		}
+
+		RegisterRef ref{ .reg{ .id = static_cast<int>(src.tmp_src) } };
+		ref.mask = (1u << src.swz_x) | (1u << src.swz_y) | (1u << src.swz_z) | (1u << src.swz_w);
+		return ref;
+	}
+
+	static u32 get_write_mask(const Instruction* instruction, bool is_sca)
+	{
+		const D3 d3{ .HEX = instruction->bytecode[3] };
+		const u32 mask = is_sca
+			? (d3.sca_writemask_x | (d3.sca_writemask_y << 1) | (d3.sca_writemask_z << 2) | (d3.sca_writemask_w << 3))
+			: (d3.vec_writemask_x | (d3.vec_writemask_y << 1) | (d3.vec_writemask_z << 2) | (d3.vec_writemask_w << 3));
+
+		// An empty mask is emitted as a full write
+		return mask ? mask : 0xF;
+	}
+
+	RegisterRef get_dst_register(const Instruction* instruction, bool is_sca)
+	{
+		const D0 d0{ .HEX = instruction->bytecode[0] };
+		const D3 d3{ .HEX = instruction->bytecode[3] };
+
+		if (!is_sca && get_vec_opcode(instruction) == RSX_VEC_OPCODE_ARL)
+		{
+			// Writes the address registers
+			return {};
+		}
+
+		const u32 tmp_index = is_sca ? d3.sca_dst_tmp : d0.dst_tmp;
+		if (tmp_index == 0x3f)
+		{
+			return {};
+		}
+
+		return { .reg{ .id = static_cast<int>(tmp_index) }, .mask = get_write_mask(instruction, is_sca) };
+	}
+
+	RegisterRef get_output_register(const Instruction* instruction, bool is_sca)
+	{
+		const D0 d0{ .HEX = instruction->bytecode[0] };
+		const D3 d3{ .HEX = instruction->bytecode[3] };
+
+		// vec_result selects which half writes to o[]
+		const bool is_result = is_sca ? !d0.vec_result : d0.vec_result;
+		if (!is_result || d3.dst == 0x1f)
+		{
+			return {};
+		}
+
+		return { .reg{ .id = static_cast<int>(d3.dst) }, .mask = get_write_mask(instruction, is_sca) };
+	}
+
+	bool is_conditional(const Instruction* instruction)
+	{
+		const D0 d0{ .HEX = instruction->bytecode[0] };
+
+		// A condition of 0 never passes, the decompiler skips the write even with the test disabled
+		return d0.cond == 0 || (d0.cond_test_enable && d0.cond != 7);
+	}
+
+	bool writes_control_registers(const Instruction* instruction, bool is_sca)
+	{
+		const D0 d0{ .HEX = instruction->bytecode[0] };
+		if (d0.cond_update_enable_0 || d0.cond_update_enable_1)
+		{
+			return true;
+		}
+
+		if (!is_sca && get_vec_opcode(instruction) == RSX_VEC_OPCODE_ARL)
+		{
+			return true;
+		}
+
+		const auto output = get_output_register(instruction, is_sca);
+		if (output && output.reg.id >= static_cast<int>(constants::output_register_count))
+		{
+			// Out of range, leave it to the decompiler to report
+			return true;
+		}
+
+		// With neither a temporary nor a result register, the value goes to the condition code register
+		return !output && !get_dst_register(instruction, is_sca);
+	}
+
+	void clear_opcode(Instruction* instruction, bool is_sca)
+	{
+		D1 d1{ .HEX = instruction->bytecode[1] };
+		if (is_sca)
+		{
+			d1.sca_opcode = RSX_SCA_OPCODE_NOP;
+		}
+		else
+		{
+			d1.vec_opcode = RSX_VEC_OPCODE_NOP;
+		}
+
+		instruction->bytecode[1] = d1.HEX;
+		instruction->opcode = make_opcode(d1.vec_opcode, d1.sca_opcode);
+	}
+}
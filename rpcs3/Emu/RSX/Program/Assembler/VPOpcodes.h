@@ -0,0 +1,60 @@
+#pragma once
+
+#include "IR.h"
+
+namespace rsx::assembler::VP
+{
+	namespace constants
+	{
+		// Temporaries R0-R63 followed by the result registers O0-O15
+		constexpr u32 temp_register_count = 64;
+		constexpr u32 output_register_count = 16;
+	}
+
+	// Each vertex program instruction dual-issues a vector and a scalar operation.
+	// The IR opcode packs both halves, vector opcode in the low 5 bits and scalar opcode above it.
+	constexpr u32 make_opcode(u32 vec_opcode, u32 sca_opcode)
+	{
+		return vec_opcode | (sca_opcode << 5);
+	}
+
+	u32 get_vec_opcode(const Instruction* instruction);
+	u32 get_sca_opcode(const Instruction* instruction);
+
+	// Returns true if the decompiler understands the opcode
+	bool is_vec_instruction_valid(u32 opcode);
+	bool is_sca_instruction_valid(u32 opcode);
+
+	// Scalar slot opcodes that do not produce a value
+	bool is_branch(u32 sca_opcode);     // BRA, BRI, BRB
+	bool is_subroutine(u32 sca_opcode); // CAL, CLI, CLB, RET
+	bool is_flow_control(u32 sca_opcode);
+
+	// Static branch or call target. Not valid for BRA, which jumps through the address register.
+	u32 get_branch_target(const Instruction* instruction);
+
+	// Returns false if any operand or opcode is invalid. The decompiler drops such instructions and ends the program.
+	bool is_instruction_valid(const Instruction* instruction);
+
+	// Returns true if execution never continues past this instruction
+	bool is_program_exit(const Instruction* instruction);
+
+	// Bitmask of the source operands read by the vector half. The scalar half always reads operand 2.
+	u32 get_vec_operand_mask(u32 vec_opcode);
+
+	// Temporary register read by an operand, with the swizzled lanes. Empty for inputs and constants.
+	RegisterRef get_src_register(const Instruction* instruction, u32 operand);
+
+	// Temporary and result registers written by either half. Empty if the half does not write one.
+	RegisterRef get_dst_register(const Instruction* instruction, bool is_sca);
+	RegisterRef get_output_register(const Instruction* instruction, bool is_sca);
+
+	// Returns true if the write may not happen, depending on the condition code test
+	bool is_conditional(const Instruction* instruction);
+
+	// Returns true if the half writes the condition code or address registers instead of, or next to, its destination
+	bool writes_control_registers(const Instruction* instruction, bool is_sca);
+
+	// Turn one half of the instruction into a NOP
+	void clear_opcode(Instruction* instruction, bool is_sca);
+}
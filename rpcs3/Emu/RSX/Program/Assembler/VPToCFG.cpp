@@ -0,0 +1,132 @@
+#include "stdafx.h"
+#include "CFG.h"
+#include "VPOpcodes.h"
+
+#include "Emu/RSX/Program/RSXVertexProgram.h"
+
+#include <map>
+
+namespace rsx::assembler
+{
+	FlowGraph deconstruct_vertex_program(const RSXVertexProgram& prog)
+	{
+		// Vertex programs have no structured flow control. Any label can be jumped to from anywhere.
+		// A new block starts at every label and after every branch or exit. The last block is an empty exit node that every path leads to.
+		// Instructions dropped by the program analyser are unreachable and are left out.
+		const u32 instruction_count = ::size32(prog.data) / 4;
+
+		FlowGraph graph{};
+		std::map<u32, BasicBlock*> blocks_by_pc;
+		std::vector<std::tuple<BasicBlock*, u32, u32>> branches; // Source block, opcode, target
+		std::vector<BasicBlock*> exits;
+
+		auto link = [](BasicBlock* from, BasicBlock* to, EdgeType edge_type)
+		{
+			from->insert_succ(to, edge_type);
+			to->insert_pred(from, edge_type);
+		};
+
+		BasicBlock* bb = nullptr;
+		bool split = true;
+		bool fallthrough = false;
+
+		for (u32 pc = 0; pc < instruction_count; ++pc)
+		{
+			if (!prog.instruction_mask[pc])
+			{
+				continue;
+			}
+
+			if (split || prog.jump_table.contains(pc))
+			{
+				graph.blocks.push_back({});
+				BasicBlock* next = &graph.blocks.back();
+				next->id = pc;
+				blocks_by_pc[pc] = next;
+
+				if (bb && fallthrough)
+				{
+					link(bb, next, EdgeType::NONE);
+				}
+
+				bb = next;
+				split = false;
+			}
+
+			bb->instructions.push_back({});
+			auto& ir_inst = bb->instructions.back();
+			std::memcpy(ir_inst.bytecode, &prog.data[pc * 4], 16);
+			ir_inst.length = 4;
+			ir_inst.addr = pc * 16;
+			ir_inst.opcode = VP::make_opcode(VP::get_vec_opcode(&ir_inst), VP::get_sca_opcode(&ir_inst));
+
+			fallthrough = true;
+			const u32 sca_opcode = VP::get_sca_opcode(&ir_inst);
+
+			if (VP::is_branch(sca_opcode) || VP::is_subroutine(sca_opcode))
+			{
+				branches.push_back({ bb, sca_opcode, VP::get_branch_target(&ir_inst) });
+				split = true;
+			}
+
+			if (VP::is_program_exit(&ir_inst) || sca_opcode == RSX_SCA_OPCODE_RET)
+			{
+				// RET outside a subroutine conditionally ends the program
+				exits.push_back(bb);
+				fallthrough = sca_opcode == RSX_SCA_OPCODE_RET && !VP::is_program_exit(&ir_inst);
+				split = true;
+			}
+		}
+
+		if (bb && fallthrough)
+		{
+			// Ran off the end of the program
+			exits.push_back(bb);
+		}
+
+		// Branch targets are resolved once all blocks exist, addresses are relative to the start of the program
+		auto find_block = [&](u32 pc) -> BasicBlock*
+		{
+			const auto found = blocks_by_pc.lower_bound(pc);
+			return found != blocks_by_pc.end() ? found->second : nullptr;
+		};
+
+		for (const auto& [from, opcode, target] : branches)
+		{
+			if (opcode == RSX_SCA_OPCODE_BRA)
+			{
+				// Indirect jump through the address register, may land on any label
+				for (const u32 label : prog.jump_table)
+				{
+					if (auto to = find_block(label))
+					{
+						link(from, to, EdgeType::BRANCH);
+					}
+				}
+				continue;
+			}
+
+			if (opcode == RSX_SCA_OPCODE_RET)
+			{
+				// Return sites are only known to the caller
+				continue;
+			}
+
+			if (auto to = find_block(target))
+			{
+				link(from, to, EdgeType::BRANCH);
+			}
+		}
+
+		graph.blocks.push_back({});
+		BasicBlock* exit_block = &graph.blocks.back();
+		exit_block->id = instruction_count;
+
+		for (auto from : exits)
+		{
+			link(from, exit_block, EdgeType::NONE);
+		}
+
+		return graph;
+	}
+}
@@ -3,10 +3,13 @@
 #include "FragmentProgramDecompiler.h"
 #include "ProgramStateCache.h"
 
+#include "Assembler/Passes/FP/CopyPropagationPass.h"
+#include "Assembler/Passes/FP/DeadCodeEliminationPass.h"
 #include "Assembler/Passes/FP/RegisterAnnotationPass.h"
 #include "Assembler/Passes/FP/RegisterDependencyPass.h"
 
 #include "Emu/system_config.h"
+#include "Emu/perf_meter.hpp"
 
 #include <algorithm>
 
@@ -1296,6 +1299,8 @@ bool FragmentProgramDecompiler::handle_tex_srb(u32 opcode)
 
 std::string FragmentProgramDecompiler::Decompile()
 {
+	perf_span span("FP Decompile");
+
 	auto graph = deconstruct_fragment_program(m_prog);
 	m_is_valid_ucode = true;
 
@@ -1321,6 +1326,13 @@ std::string FragmentProgramDecompiler::Decompile()
 		const auto rop_inputs = get_fragment_program_output_set(m_prog.ctrl, m_prog.mrt_buffers_count);
 		rop_block->input_list.insert(rop_block->input_list.end(), rop_inputs.begin(), rop_inputs.end());
 
+		// Optimizations operate on the raw ucode and must run before annotation
+		FP::CopyPropagationPass copy_propagation_pass{};
+		FP::DeadCodeEliminationPass dce_pass{};
+
+		copy_propagation_pass.run(graph);
+		dce_pass.run(graph);
+
 		FP::RegisterAnnotationPass annotation_pass{ m_prog, { .skip_delay_slots = true } };
 		FP::RegisterDependencyPass dependency_pass{};
 
@@ -361,6 +361,11 @@ vec4 _texture(in vec4 coord, float bias)
 		return vr_zero;
 	}
 
+#ifndef WITH_TEXTURE_TYPES
+	// Only 2D textures are bound to this variant
+	coord.xy = _texcoord_xform(coord.xy, texture_parameters[ur0 + texture_base_index]);
+	vr0 = texture(SAMPLER2D(ur0), coord.xy, bias);
+#else
 	ur1 = ur0 + ur0;
 	const uint type = GET_BITS(texture_control, int(ur1), 2);
 
@@ -383,6 +388,7 @@ vec4 _texture(in vec4 coord, float bias)
 		vr0 = texture(SAMPLER3D(ur0), coord.xyz, bias);
 		break;
 	}
+#endif
 
 	if (TEST_INST_BIT(0, 21))
 	{
@@ -400,6 +406,11 @@ vec4 _textureLod(in vec4 coord, float lod)
 		return vr_zero;
 	}
 
+#ifndef WITH_TEXTURE_TYPES
+	// Only 2D textures are bound to this variant
+	coord.xy = _texcoord_xform(coord.xy, texture_parameters[ur0 + texture_base_index]);
+	vr0 = textureLod(SAMPLER2D(ur0), coord.xy, lod);
+#else
 	ur1 = ur0 + ur0;
 	const uint type = GET_BITS(texture_control, int(ur1), 2);
 
@@ -422,6 +433,7 @@ vec4 _textureLod(in vec4 coord, float lod)
 		vr0 = textureLod(SAMPLER3D(ur0), coord.xyz, lod);
 		break;
 	}
+#endif
 
 	if (TEST_INST_BIT(0, 21))
 	{
@@ -23,6 +23,7 @@
 
 #include "SPIRVCommon.h"
 #include "Emu/RSX/Program/GLSLTypes.h"
+#include "Emu/perf_meter.hpp"
 
 namespace spirv
 {
@@ -127,6 +128,8 @@ namespace spirv
 
 	bool compile_glsl_to_spv(std::vector<u32>& spv, std::string& shader, ::glsl::program_domain domain, ::glsl::glsl_rules rules)
 	{
+		perf_span span("SPIR-V Compile");
+
 		EShLanguage lang = (domain == ::glsl::glsl_fragment_program)
 			? EShLangFragment
 			: (domain == ::glsl::glsl_vertex_program)
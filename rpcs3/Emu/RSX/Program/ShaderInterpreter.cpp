@@ -1,5 +1,6 @@
 #include "stdafx.h"
 #include "ShaderInterpreter.h"
+#include "Emu/RSX/gcm_enums.h"
 
 #include <unordered_set>
 
@@ -69,6 +70,12 @@ namespace program_common::interpreter
 		const u32 base_fs_mask = COMPILER_OPT_BASE_FS_MASK & ~(COMPILER_OPT_FS_EXCL_MASK);
 		bitrange_foreach(COMPILER_OPT_FS_MIN, COMPILER_OPT_FS_MAX, [&](u32 fs_opt)
 		{
+			if ((fs_opt & COMPILER_OPT_ENABLE_TEXTURE_TYPES) && !(fs_opt & COMPILER_OPT_ENABLE_TEXTURES))
+			{
+				// Never selected, the texture types only matter with texturing enabled
+				return;
+			}
+
 			result.fs_opts.insert(fs_opt);
 			if (const auto excl_mask = (fs_opt & COMPILER_OPT_FS_EXCL_MASK);
 				excl_mask != 0)
@@ -150,4 +157,23 @@ namespace program_common::interpreter
 
 		return result;
 	}
+
+	u32 get_texture_options(u32 referenced_textures_mask, u32 texture_dimensions)
+	{
+		if (!referenced_textures_mask)
+		{
+			return 0;
+		}
+
+		for (u32 mask = referenced_textures_mask, i = 0; mask; mask >>= 1, ++i)
+		{
+			const auto type = static_cast<rsx::texture_dimension_extended>((texture_dimensions >> (i * 2)) & 0x3);
+			if ((mask & 1) && type != rsx::texture_dimension_extended::texture_dimension_2d)
+			{
+				return COMPILER_OPT_ENABLE_TEXTURES | COMPILER_OPT_ENABLE_TEXTURE_TYPES;
+			}
+		}
+
+		return COMPILER_OPT_ENABLE_TEXTURES;
+	}
 }
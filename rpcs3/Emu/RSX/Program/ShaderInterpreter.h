@@ -17,30 +17,31 @@ namespace program_common
 			COMPILER_OPT_ENABLE_STIPPLING      = (1 << 5),
 			COMPILER_OPT_ENABLE_FLOW_CTRL      = (1 << 6),
 			COMPILER_OPT_ENABLE_ROP_REMAP      = (1 << 7),
+			COMPILER_OPT_ENABLE_TEXTURE_TYPES  = (1 << 8), // 1D, cube and 3D samplers. Without it, textures are only fetched as 2D.
 
 			// VS Mix-N-Match
-			COMPILER_OPT_ENABLE_INSTANCING     = (1 << 8),
-			COMPILER_OPT_ENABLE_VTX_TEXTURES   = (1 << 9),
+			COMPILER_OPT_ENABLE_INSTANCING     = (1 << 9),
+			COMPILER_OPT_ENABLE_VTX_TEXTURES   = (1 << 10),
 
 			// Exclusive bits. Only one can be set at a time
-			COMPILER_OPT_ENABLE_ALPHA_TEST_GE  = (1 << 10),
-			COMPILER_OPT_ENABLE_ALPHA_TEST_G   = (1 << 11),
-			COMPILER_OPT_ENABLE_ALPHA_TEST_LE  = (1 << 12),
-			COMPILER_OPT_ENABLE_ALPHA_TEST_L   = (1 << 13),
-			COMPILER_OPT_ENABLE_ALPHA_TEST_EQ  = (1 << 14),
-			COMPILER_OPT_ENABLE_ALPHA_TEST_NE  = (1 << 15),
+			COMPILER_OPT_ENABLE_ALPHA_TEST_GE  = (1 << 11),
+			COMPILER_OPT_ENABLE_ALPHA_TEST_G   = (1 << 12),
+			COMPILER_OPT_ENABLE_ALPHA_TEST_LE  = (1 << 13),
+			COMPILER_OPT_ENABLE_ALPHA_TEST_L   = (1 << 14),
+			COMPILER_OPT_ENABLE_ALPHA_TEST_EQ  = (1 << 15),
+			COMPILER_OPT_ENABLE_ALPHA_TEST_NE  = (1 << 16),
 
 			// Meta
 			COMPILER_OPT_MAX                   = COMPILER_OPT_ENABLE_ALPHA_TEST_NE,
-			COMPILER_OPT_ALPHA_TEST_MASK       = (0b111111 << 10),
+			COMPILER_OPT_ALPHA_TEST_MASK       = (0b111111 << 11),
 			COMPILER_OPT_ALL_VS_MASK           = COMPILER_OPT_ENABLE_INSTANCING | COMPILER_OPT_ENABLE_VTX_TEXTURES,
-			COMPILER_OPT_BASE_FS_MASK          = 0b11111111,
+			COMPILER_OPT_BASE_FS_MASK          = 0b111111111,
 			COMPILER_OPT_ALL_FS_MASK           = COMPILER_OPT_BASE_FS_MASK | COMPILER_OPT_ALPHA_TEST_MASK,
 			COMPILER_OPT_VS_EXCL_MASK          = COMPILER_OPT_ENABLE_INSTANCING,
 			COMPILER_OPT_FS_EXCL_MASK          = COMPILER_OPT_ALPHA_TEST_MASK | COMPILER_OPT_ENABLE_STIPPLING | COMPILER_OPT_ENABLE_DEPTH_EXPORT | COMPILER_OPT_ENABLE_F32_EXPORT,
 
 			// Bounds
-			COMPILER_OPT_FS_MAX                = COMPILER_OPT_ENABLE_ROP_REMAP,
+			COMPILER_OPT_FS_MAX                = COMPILER_OPT_ENABLE_TEXTURE_TYPES,
 			COMPILER_OPT_FS_MIN                = COMPILER_OPT_ENABLE_TEXTURES,
 			COMPILER_OPT_VS_MAX                = COMPILER_OPT_ENABLE_VTX_TEXTURES,
 			COMPILER_OPT_VS_MIN                = COMPILER_OPT_ENABLE_INSTANCING,
@@ -88,5 +89,8 @@ namespace program_common
 		};
 
 		interpreter_variants_t get_interpreter_variants();
+
+		// Returns the texture related options for a fragment program, given the 2-bit texture dimensions of each slot
+		u32 get_texture_options(u32 referenced_textures_mask, u32 texture_dimensions);
 	}
 }
@@ -1,6 +1,10 @@
 #include "stdafx.h"
 #include "VertexProgramDecompiler.h"
 
+#include "Assembler/CFG.h"
+#include "Assembler/Passes/VP/DeadOutputEliminationPass.h"
+#include "Emu/perf_meter.hpp"
+
 #include <sstream>
 
 std::string VertexProgramDecompiler::GetMask(bool is_sca) const
@@ -444,7 +448,26 @@ VertexProgramDecompiler::VertexProgramDecompiler(const RSXVertexProgram& prog) :
 
 std::string VertexProgramDecompiler::Decompile()
 {
-	const auto& data = m_prog.data;
+	perf_span span("VP Decompile");
+
+	// Drop work feeding outputs that are not consumed. The passes rewrite a copy of the ucode, the program itself is part of the cache key.
+	std::vector<u32> data = m_prog.data;
+	{
+		auto graph = rsx::assembler::deconstruct_vertex_program(m_prog);
+		rsx::assembler::VP::DeadOutputEliminationPass dce_pass{ m_prog.output_mask };
+
+		if (dce_pass.run(graph))
+		{
+			for (const auto& block : graph.blocks)
+			{
+				for (const auto& instruction : block.instructions)
+				{
+					std::memcpy(&data[instruction.addr / 4], instruction.bytecode, 16);
+				}
+			}
+		}
+	}
+
 	m_instr_count = data.size() / 4;
 
 	bool has_BRA = false;
@@ -10,6 +10,7 @@
 #include "NV47/HW/context.h"
 
 #include "util/asm.hpp"
+#include "util/tsc.hpp"
 
 #include <thread>
 
@@ -22,11 +23,404 @@ namespace rsx
 {
 	namespace FIFO
 	{
+		// Decodes the command stream ahead of the RSX thread, resolving flow control and splitting packets into (method, value) pairs.
+		// The stream between GET and PUT is committed by the application, but anything that synchronizes with or writes to guest memory
+		// may change what follows, so decoding stops after such methods until the RSX thread catches up and restarts it.
+		struct FIFO_predecoder
+		{
+			static constexpr u32 ring_size = 4096;
+
+			enum class step
+			{
+				progress,
+				stall, // Waiting for PUT to move
+				full,  // Waiting for space in the ring
+				park
+			};
+
+			const RsxDmaControl* m_ctrl;
+			const rsx_iomap_table* m_iotable;
+
+			std::array<predecoded_command, ring_size> m_ring{};
+			atomic_t<u32> m_write_pos = 0;
+			atomic_t<u32> m_read_pos = 0;
+
+			// Restart requests, the epoch is published last
+			atomic_t<u32> m_request_epoch = 0;
+			atomic_t<u32> m_request_get = 0;
+			atomic_t<u32> m_request_ret = RSX_CALL_STACK_EMPTY;
+
+			// Last epoch the decoder stopped on, it will not make progress until restarted
+			atomic_t<u32> m_parked_epoch = 0;
+
+			// Stall state, the decoder sleeps on the wake counter until the RSX thread sees PUT move or frees ring space
+			atomic_t<u32> m_wake = 0;
+			atomic_t<u32> m_stall_put = umax;
+			atomic_t<u32> m_stall_full = 0;
+
+			FIFO_predecoder(const RsxDmaControl* ctrl, const rsx_iomap_table* iotable)
+				: m_ctrl(ctrl)
+				, m_iotable(iotable)
+			{
+			}
+
+			void restart(u32 epoch, u32 get, u32 ret_addr)
+			{
+				m_request_get.release(get);
+				m_request_ret.release(ret_addr);
+				m_request_epoch.store(epoch);
+				m_request_epoch.notify_one();
+
+				// The decoder may also be sleeping on a stall
+				m_wake++;
+				m_wake.notify_one();
+			}
+
+			// Called by the RSX thread with the current PUT
+			void wake(u32 put)
+			{
+				if (const u32 stall_put = m_stall_put.load(); stall_put != umax && stall_put != put)
+				{
+					m_stall_put.release(umax);
+				}
+				else if (m_stall_full && m_write_pos.load() - m_read_pos.raw() <= ring_size / 2)
+				{
+					m_stall_full.release(0);
+				}
+				else
+				{
+					return;
+				}
+
+				m_wake++;
+				m_wake.notify_one();
+			}
+
+			const predecoded_command* peek() const
+			{
+				const u32 pos = m_read_pos.raw();
+
+				if (pos == m_write_pos.load())
+				{
+					return nullptr;
+				}
+
+				return &m_ring[pos % ring_size];
+			}
+
+			void pop()
+			{
+				m_read_pos.release(m_read_pos.raw() + 1);
+			}
+
+			static bool is_sync_method(u32 reg)
+			{
+				// Channel methods (semaphores, reference) and the other subchannels (transfers, flips)
+				if (reg < (0x100 >> 2) || reg >= (0x2000 >> 2))
+				{
+					return true;
+				}
+
+				switch (reg)
+				{
+				case NV4097_NOTIFY:
+				case NV4097_WAIT_FOR_IDLE:
+				case NV4097_CLEAR_REPORT_VALUE:
+				case NV4097_GET_REPORT:
+				case NV4097_BACK_END_WRITE_SEMAPHORE_RELEASE:
+				case NV4097_TEXTURE_READ_SEMAPHORE_RELEASE:
+					return true;
+				default:
+					return false;
+				}
+			}
+
+			step decode_packet(u32 epoch, u32 put, u32& get, u32& start_get, u32& ret_addr)
+			{
+				if (get == put)
+				{
+					return step::stall;
+				}
+
+				const u32 addr = m_iotable->get_addr(get);
+
+				if (addr == umax)
+				{
+					return step::park;
+				}
+
+				const u32 cmd = vm::read32(addr);
+
+				if (cmd & RSX_METHOD_NON_METHOD_CMD_MASK)
+				{
+					// Flow control is followed here, but also queued as a marker so that the RSX thread executes it itself
+					const auto emit_flow = [&](u32 target)
+					{
+						const u32 pos = m_write_pos.raw();
+						m_ring[pos % ring_size] = { epoch, start_get, cmd, get, addr, target, 1 };
+						m_write_pos.release(pos + 1);
+
+						get = start_get = target;
+						return step::progress;
+					};
+
+					if (m_write_pos.raw() - m_read_pos.load() >= ring_size)
+					{
+						return step::full;
+					}
+
+					if (const bool old_jump = (cmd & RSX_METHOD_OLD_JUMP_CMD_MASK) == RSX_METHOD_OLD_JUMP_CMD;
+						old_jump || (cmd & RSX_METHOD_NEW_JUMP_CMD_MASK) == RSX_METHOD_NEW_JUMP_CMD)
+					{
+						const u32 offs = cmd & (old_jump ? RSX_METHOD_OLD_JUMP_OFFSET_MASK : RSX_METHOD_NEW_JUMP_OFFSET_MASK);
+
+						if (offs == get)
+						{
+							// Jump to self, the application is going to patch it
+							return step::park;
+						}
+
+						return emit_flow(offs);
+					}
+
+					if ((cmd & RSX_METHOD_CALL_CMD_MASK) == RSX_METHOD_CALL_CMD)
+					{
+						if (ret_addr != RSX_CALL_STACK_EMPTY)
+						{
+							return step::park;
+						}
+
+						ret_addr = get + 4;
+						return emit_flow(cmd & RSX_METHOD_CALL_OFFSET_MASK);
+					}
+
+					if ((cmd & RSX_METHOD_RETURN_MASK) == RSX_METHOD_RETURN_CMD && ret_addr != RSX_CALL_STACK_EMPTY)
+					{
+						return emit_flow(std::exchange(ret_addr, RSX_CALL_STACK_EMPTY));
+					}
+
+					// Leave error handling to the RSX thread
+					return step::park;
+				}
+
+				const u32 count = (cmd >> 18) & 0x7ff;
+
+				if (!count)
+				{
+					// NOP
+					get += 4;
+					return step::progress;
+				}
+
+				if (put - (get + 4) < count * 4)
+				{
+					// Wait for the whole packet to be available
+					return step::stall;
+				}
+
+				if (m_write_pos.raw() - m_read_pos.load() + count > ring_size)
+				{
+					return step::full;
+				}
+
+				const u32 inc = ((cmd & RSX_METHOD_NON_INCREMENT_CMD_MASK) == RSX_METHOD_NON_INCREMENT_CMD) ? 0 : 4;
+				const u32 pos = m_write_pos.raw();
+				bool sync_point = false;
+
+				for (u32 i = 0, reg = cmd & 0xfffc; i < count; i++, reg += inc)
+				{
+					const u32 arg_get = get + 4 + i * 4;
+					const u32 arg_addr = m_iotable->get_addr(arg_get);
+
+					if (arg_addr == umax)
+					{
+						return step::park;
+					}
+
+					m_ring[(pos + i) % ring_size] = { epoch, start_get, cmd, arg_get, arg_addr, vm::read32(arg_addr), i == 0 };
+					sync_point |= is_sync_method(reg >> 2);
+				}
+
+				m_write_pos.release(pos + count);
+
+				get += 4 + count * 4;
+				start_get = get;
+
+				return sync_point ? step::park : step::progress;
+			}
+
+			void operator()()
+			{
+				if (g_cfg.core.thread_scheduler != thread_scheduler_mode::os)
+				{
+					thread_ctrl::set_thread_affinity_mask(thread_ctrl::get_affinity_mask(thread_class::rsx));
+				}
+
+				u32 epoch = 0;
+				u32 get = 0;
+				u32 start_get = 0;
+				u32 ret_addr = RSX_CALL_STACK_EMPTY;
+				bool parked = true;
+
+				while (thread_ctrl::state() != thread_state::aborting)
+				{
+					if (const u32 request = m_request_epoch.load(); request != epoch)
+					{
+						epoch = request;
+						get = start_get = m_request_get.load();
+						ret_addr = m_request_ret.load();
+						parked = false;
+					}
+					else if (parked)
+					{
+						// Wait for the RSX thread to catch up
+						thread_ctrl::wait_on(m_request_epoch, request);
+						continue;
+					}
+
+					// Loaded first, so that a wake-up from here on is not missed
+					const u32 wake = m_wake.load();
+					const u32 put = m_ctrl->put & ~3;
+
+					switch (decode_packet(epoch, put, get, start_get, ret_addr))
+					{
+					case step::progress:
+						break;
+					case step::stall:
+						m_stall_put.store(put);
+
+						if ((m_ctrl->put & ~3) == put && m_request_epoch.load() == epoch)
+						{
+							thread_ctrl::wait_on(m_wake, wake);
+						}
+
+						m_stall_put.release(umax);
+						break;
+					case step::full:
+						m_stall_full.store(1);
+
+						if (m_request_epoch.load() == epoch)
+						{
+							thread_ctrl::wait_on(m_wake, wake);
+						}
+
+						m_stall_full.release(0);
+						break;
+					case step::park:
+						parked = true;
+						m_parked_epoch.release(epoch);
+						break;
+					}
+				}
+			}
+
+			static constexpr auto thread_name = "RSX FIFO Decoder"sv;
+		};
+
 		FIFO_control::FIFO_control(::rsx::thread* pctrl)
+			: FIFO_control(pctrl->ctrl, &pctrl->iomap_table, &pctrl->fifo_ret_addr, g_cfg.core.rsx_fifo_predecoder && !g_cfg.core.rsx_fifo_accuracy)
 		{
 			m_thread = pctrl;
-			m_ctrl = pctrl->ctrl;
-			m_iotable = &pctrl->iomap_table;
+		}
+
+		FIFO_control::FIFO_control(RsxDmaControl* ctrl, const rsx_iomap_table* iotable, const u32* ret_addr, bool predecode)
+			: m_thread(nullptr)
+			, m_ctrl(ctrl)
+			, m_iotable(iotable)
+			, m_ret_addr(ret_addr)
+		{
+			if (predecode)
+			{
+				m_predecoder = std::make_unique<named_thread<FIFO_predecoder>>(m_ctrl, m_iotable);
+			}
+		}
+
+		FIFO_control::~FIFO_control()
+		{
+		}
+
+		bool FIFO_control::read_predecoded(register_pair& data)
+		{
+			if (m_remaining_commands || m_memwatch_addr)
+			{
+				return false;
+			}
+
+			m_predecoded_packet = false;
+
+			auto& decoder = *m_predecoder;
+			decoder.wake(read_put<false>());
+
+			while (const auto entry = decoder.peek())
+			{
+				if (entry->epoch != m_predecoder_epoch || !entry->first)
+				{
+					// Stale or skipped data
+					decoder.pop();
+					continue;
+				}
+
+				if (entry->start_get != m_internal_get)
+				{
+					// Control flow diverged from the decoder, restart it from here
+					break;
+				}
+
+				if (entry->cmd & RSX_METHOD_NON_METHOD_CMD_MASK)
+				{
+					// Flow control marker, hand the command to the RSX thread which updates GET, the call stack and last_known_code_start
+					m_cmd = entry->cmd;
+					m_internal_get = entry->arg_get;
+					m_predecoder_get = entry->value;
+
+					data.reg = m_cmd;
+					decoder.pop();
+					return true;
+				}
+
+				m_cmd = entry->cmd;
+				m_command_reg = m_cmd & 0xfffc;
+				m_command_inc = ((m_cmd & RSX_METHOD_NON_INCREMENT_CMD_MASK) == RSX_METHOD_NON_INCREMENT_CMD) ? 0 : 4;
+				m_remaining_commands = ((m_cmd >> 18) & 0x7ff) - 1;
+				m_internal_get = entry->arg_get;
+				m_args_ptr = entry->arg_addr;
+				m_predecoder_get = m_internal_get + 4 * (m_remaining_commands + 1);
+				m_predecoded_packet = true;
+
+				data.set(m_command_reg, entry->value);
+				decoder.pop();
+				return true;
+			}
+
+			if (m_predecoder_get != m_internal_get || decoder.peek() || decoder.m_parked_epoch.load() == m_predecoder_epoch)
+			{
+				// The RSX thread moved on its own, the decoder went astray or stopped at a hazard; restart decoding from the current position
+				decoder.restart(++m_predecoder_epoch, m_internal_get, *m_ret_addr);
+				m_predecoder_get = m_internal_get;
+			}
+
+			return false;
+		}
+
+		bool FIFO_control::read_unsafe_predecoded(register_pair& data)
+		{
+			auto& decoder = *m_predecoder;
+
+			if (const auto entry = decoder.peek(); entry && entry->epoch == m_predecoder_epoch && !entry->first && entry->arg_get == m_internal_get + 4)
+			{
+				m_internal_get = entry->arg_get;
+				m_args_ptr = entry->arg_addr;
+				m_command_reg += m_command_inc;
+				--m_remaining_commands;
+
+				data.set(m_command_reg, entry->value);
+				decoder.pop();
+				return true;
+			}
+
+			// Finish the packet with direct reads
+			m_predecoded_packet = false;
+			return false;
 		}
 
 		u32 FIFO_control::translate_address(u32 address) const
@@ -45,6 +439,7 @@ namespace rsx
 			m_command_inc = ((m_cmd & RSX_METHOD_NON_INCREMENT_CMD_MASK) == RSX_METHOD_NON_INCREMENT_CMD) ? 0 : 4;
 			m_remaining_commands = count;
 			m_internal_get = m_ctrl->get - 4;
+			m_predecoded_packet = false;
 			m_args_ptr = m_iotable->get_addr(m_internal_get);
 			m_command_reg = (m_cmd & 0xffff) + m_command_inc * (((m_cmd >> 18) - count) & 0x7ff) - m_command_inc;
 		}
@@ -272,6 +667,11 @@ namespace rsx
 			// Fast read with no processing, only safe inside a PACKET_BEGIN+count block
 			if (m_remaining_commands)
 			{
+				if (m_predecoded_packet && read_unsafe_predecoded(data)) [[unlikely]]
+				{
+					return true;
+				}
+
 				bool ok{};
 				u32 arg = 0;
 
@@ -339,6 +739,11 @@ namespace rsx
 
 		void FIFO_control::read(register_pair& data)
 		{
+			if (m_predecoder && read_predecoded(data)) [[unlikely]]
+			{
+				return;
+			}
+
 			if (m_remaining_commands)
 			{
 				// Previous block aborted to wait for PUT pointer
@@ -552,7 +957,18 @@ namespace rsx
 			}
 		}
 
-		flatten_op flattening_helper::test(register_pair& command)
+		bool flattening_helper::is_redundant_write(const rsx_state& state, u32 reg, u32 value)
+		{
+			if (!state.test(reg, value))
+			{
+				return false;
+			}
+
+			// Methods may have side effects even if the value is unchanged, only skip those known to be pure state
+			return !methods[reg] || (m_register_properties[reg] & register_props::skip_on_match);
+		}
+
+		flatten_op flattening_helper::test(register_pair& command, const rsx_state& state)
 		{
 			u32 flush_cmd = ~0u;
 			switch (const u32 reg = (command.reg >> 2))
@@ -610,6 +1026,11 @@ namespace rsx
 						// Always ignore
 						command.reg = FIFO_DISABLED_COMMAND;
 					}
+					else if (is_redundant_write(state, reg, command.value))
+					{
+						// Effective state does not change, keep merging
+						command.reg = FIFO_DISABLED_COMMAND;
+					}
 					else
 					{
 						// Flush
@@ -783,6 +1204,18 @@ namespace rsx
 			performance_counters.idle_time += (get_system_time() - performance_counters.FIFO_idle_timestamp);
 		}
 
+		// Split busy time into command decoding and method dispatch when profiling
+		const bool profile_fifo = m_profiler.enabled;
+		const u64 busy_start = profile_fifo ? utils::get_tsc() : 0;
+
+		const auto read_next_timed = [&]()
+		{
+			const u64 start = utils::get_tsc();
+			const bool result = fifo_ctrl->read_unsafe(command);
+			m_fifo_decode_ticks += utils::get_tsc() - start;
+			return result;
+		};
+
 		do
 		{
 			if (capture_current_frame) [[unlikely]]
@@ -848,7 +1281,7 @@ namespace rsx
 
 			if (m_flattener.is_enabled()) [[unlikely]]
 			{
-				switch(m_flattener.test(command))
+				switch(m_flattener.test(command, *m_ctx->register_state))
 				{
 				case FIFO::NOTHING:
 				{
@@ -902,7 +1335,12 @@ namespace rsx
 				m_graphics_state |= state_signals[reg];
 			}
 		}
-		while (fifo_ctrl->read_unsafe(command));
+		while (profile_fifo ? read_next_timed() : fifo_ctrl->read_unsafe(command));
+
+		if (profile_fifo) [[unlikely]]
+		{
+			m_fifo_busy_ticks += utils::get_tsc() - busy_start;
+		}
 
 		fifo_ctrl->sync_get();
 	}
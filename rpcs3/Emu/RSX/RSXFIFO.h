@@ -3,14 +3,19 @@
 #include "util/types.hpp"
 #include "Emu/RSX/gcm_enums.h"
 
+#include <memory>
 #include <span>
 
 struct RsxDmaControl;
 
+template <typename T>
+class named_thread;
+
 namespace rsx
 {
 	class thread;
 	struct rsx_iomap_table;
+	struct rsx_state;
 
 	namespace FIFO
 	{
@@ -79,6 +84,7 @@ namespace rsx
 
 			// Workaround for MSVC, C2248
 			static constexpr u8 register_props_always_ignore = register_props::always_ignore;
+			static constexpr u8 register_props_skip_on_match = register_props::skip_on_match;
 
 			static constexpr std::array<u8, 0x10000 / 4> m_register_properties = []
 			{
@@ -91,6 +97,23 @@ namespace rsx
 					{ NV4097_INVALIDATE_ZCULL, 1 }
 				}};
 
+				// Registers with a method handler that does nothing when the value does not change.
+				// Registers without a handler are always treated this way.
+				constexpr std::array<std::pair<u32, u32>, 8> redundant_write_ranges =
+				{{
+					// Surface setup
+					{ NV4097_SET_SURFACE_CLIP_HORIZONTAL, 9 }, // CLIP_HORIZONTAL to COLOR_TARGET
+					{ NV4097_SET_SURFACE_PITCH_Z, 1 },
+					{ NV4097_SET_SURFACE_PITCH_C, 4 }, // PITCH_C, PITCH_D, COLOR_COFFSET, COLOR_DOFFSET
+					{ NV4097_SET_WINDOW_OFFSET, 1 },
+					{ NV4097_SET_CONTEXT_DMA_COLOR_B, 1 },
+					{ NV4097_SET_CONTEXT_DMA_COLOR_A, 2 }, // COLOR_A, ZETA
+					{ NV4097_SET_CONTEXT_DMA_COLOR_C, 2 }, // COLOR_C, COLOR_D
+
+					// Output merger
+					{ NV4097_SET_COLOR_MASK, 1 },
+				}};
+
 				std::array<u8, 0x10000 / 4> register_properties{};
 
 				for (const auto& method : ignorable_ranges)
@@ -101,6 +124,14 @@ namespace rsx
 					}
 				}
 
+				for (const auto& method : redundant_write_ranges)
+				{
+					for (u32 i = 0; i < method.second; ++i)
+					{
+						register_properties[method.first + i] |= register_props_skip_on_match;
+					}
+				}
+
 				return register_properties;
 			}();
 
@@ -114,6 +145,9 @@ namespace rsx
 
 			void reset(bool _enabled);
 
+			// Returns true if writing the value leaves the effective state unchanged, so that it does not need to break a merged draw
+			static bool is_redundant_write(const rsx_state& state, u32 reg, u32 value);
+
 		public:
 			flattening_helper() = default;
 			~flattening_helper() = default;
@@ -121,17 +155,34 @@ namespace rsx
 			u32 get_primitive() const { return deferred_primitive; }
 			bool is_enabled() const { return enabled; }
 
+			// Number of backend draws saved by merging since the last evaluation
+			u32 get_collapsed_count() const { return num_collapsed; }
+
 			void force_disable();
 			void evaluate_performance(u32 total_draw_count);
-			inline flatten_op test(register_pair& command);
+			inline flatten_op test(register_pair& command, const rsx_state& state);
+		};
+
+		struct predecoded_command
+		{
+			u32 epoch;
+			u32 start_get; // FIFO position expected before the packet header, NOPs ahead of it are skipped
+			u32 cmd;       // Packet header, or JUMP/CALL/RETURN for flow control markers
+			u32 arg_get;   // FIFO position of the argument, or of the flow control command
+			u32 arg_addr;  // Effective address of the argument
+			u32 value;     // Argument, or the flow control target
+			u32 first;     // First argument of its packet, always set for markers
 		};
 
+		struct FIFO_predecoder;
+
 		class FIFO_control
 		{
 		private:
 			mutable rsx::thread* m_thread;
 			RsxDmaControl* m_ctrl = nullptr;
 			const rsx::rsx_iomap_table* m_iotable;
+			const u32* m_ret_addr; // Call stack of the consumer, flow control itself is executed by the consumer
 			u32 m_internal_get = 0;
 
 			u32 m_memwatch_addr = 0;
@@ -147,9 +198,21 @@ namespace rsx
 			u32 m_cache_size = 0;
 			alignas(64) std::byte m_cache[8][128];
 
+			// Optional decoding of the command stream on another core
+			std::unique_ptr<named_thread<FIFO_predecoder>> m_predecoder;
+			u32 m_predecoder_epoch = 0;
+			u32 m_predecoder_get = 0;
+			bool m_predecoded_packet = false;
+
+			bool read_predecoded(register_pair& data);
+			inline bool read_unsafe_predecoded(register_pair& data);
+
 		public:
 			FIFO_control(rsx::thread* pctrl);
-			~FIFO_control() = default;
+
+			// Without an RSX thread, for fast fetch accuracy only. The caller handles errors, PUT must not stop inside a packet.
+			FIFO_control(RsxDmaControl* ctrl, const rsx_iomap_table* iotable, const u32* ret_addr, bool predecode);
+			~FIFO_control();
 
 			u32 translate_address(u32 addr) const;
 
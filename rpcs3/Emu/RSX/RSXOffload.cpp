@@ -7,14 +7,64 @@
 #include "RSXThread.h"
 
 #include "Utilities/lockless.h"
+#include "Emu/perf_meter.hpp"
 
 #include <thread>
 #include "util/asm.hpp"
+#include "util/sysinfo.hpp"
+#include "util/tsc.hpp"
 
 namespace rsx
 {
+	// Copies a slice of a large transfer on behalf of the offload thread
+	struct dma_manager::copy_worker
+	{
+		struct copy_chunk
+		{
+			void* dst;
+			const void* src;
+			u32 length;
+
+			copy_chunk(void* _dst, const void* _src, u32 len)
+				: dst(_dst), src(_src), length(len)
+			{}
+		};
+
+		lf_queue<copy_chunk> m_work_queue;
+		atomic_t<u64> m_enqueued_count = 0;
+		atomic_t<u64> m_processed_count = 0;
+
+		thread_base* current_thread_ = nullptr;
+
+		void operator ()()
+		{
+			current_thread_ = thread_ctrl::get_current();
+
+			if (g_cfg.core.thread_scheduler != thread_scheduler_mode::os)
+			{
+				thread_ctrl::set_thread_affinity_mask(thread_ctrl::get_affinity_mask(thread_class::rsx));
+			}
+
+			while (thread_ctrl::state() != thread_state::aborting)
+			{
+				for (auto&& chunk : m_work_queue.pop_all())
+				{
+					std::memcpy(chunk.dst, chunk.src, chunk.length);
+					m_processed_count.release(m_processed_count + 1);
+				}
+
+				thread_ctrl::wait_on(m_work_queue);
+			}
+		}
+
+		static constexpr auto thread_name = "RSX Offloader Worker"sv;
+	};
+
 	struct dma_manager::offload_thread
 	{
+		// Transfers smaller than this are never split
+		static constexpr u32 min_chunk_size = 0x10000;
+
 		lf_queue<transport_packet> m_work_queue;
 		atomic_t<u64> m_enqueued_count = 0;
 		atomic_t<u64> m_processed_count = 0;
@@ -22,6 +72,72 @@ namespace rsx
 
 		thread_base* current_thread_ = nullptr;
 
+		std::vector<std::unique_ptr<named_thread<copy_worker>>> m_workers;
+
+		offload_thread()
+		{
+			if (!g_cfg.video.multithreaded_rsx)
+			{
+				return;
+			}
+
+			// Large copies are memory bound, a few helpers are enough to saturate bandwidth
+			const u32 worker_count = std::min(utils::get_thread_count() / 4, 4u);
+
+			for (u32 i = 0; i < worker_count; i++)
+			{
+				m_workers.emplace_back(std::make_unique<named_thread<copy_worker>>());
+			}
+		}
+
+		// Splits large copies between the offload thread and the helpers. Packets are still retired in order.
+		void copy(void* dst, const void* src, u32 length)
+		{
+			if (m_workers.empty() || length < min_chunk_size * 2)
+			{
+				std::memcpy(dst, src, length);
+				return;
+			}
+
+			const u32 parts = std::min(::size32(m_workers) + 1, length / min_chunk_size);
+			const u32 chunk_size = utils::align((length + parts - 1) / parts, 64);
+
+			for (u32 offset = chunk_size, i = 0; offset < length; offset += chunk_size, i++)
+			{
+				auto& worker = *m_workers[i];
+				worker.m_enqueued_count++;
+				worker.m_work_queue.push(static_cast<u8*>(dst) + offset, static_cast<const u8*>(src) + offset, std::min(chunk_size, length - offset));
+			}
+
+			std::memcpy(dst, src, chunk_size);
+
+			for (auto& worker : m_workers)
+			{
+				while (worker->m_processed_count.load() < worker->m_enqueued_count.load())
+				{
+					utils::pause();
+				}
+			}
+		}
+
+		bool owns_thread(const thread_base* thread) const
+		{
+			if (current_thread_ == thread)
+			{
+				return true;
+			}
+
+			for (const auto& worker : m_workers)
+			{
+				if (worker->current_thread_ == thread)
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
 		void operator ()()
 		{
 			if (!g_cfg.video.multithreaded_rsx)
@@ -50,12 +166,12 @@ namespace rsx
 					{
 						const u32 vm_addr = vm::try_get_addr(job.src).first;
 						rsx::reservation_lock<true, 1> rsx_lock(vm_addr, job.length, g_cfg.video.strict_rendering_mode && vm_addr);
-						std::memcpy(job.dst, job.src, job.length);
+						copy(job.dst, job.src, job.length);
 						break;
 					}
 					case vector_copy:
 					{
-						std::memcpy(job.dst, job.opt_storage.data(), job.length);
+						copy(job.dst, job.opt_storage.data(), job.length);
 						break;
 					}
 					case index_emulate:
@@ -83,6 +199,11 @@ namespace rsx
 				}
 			}
 
+			for (auto& worker : m_workers)
+			{
+				*worker = thread_state::aborting;
+			}
+
 			m_processed_count = -1;
 			m_processed_count.notify_all();
 		}
@@ -96,32 +217,86 @@ namespace rsx
 		m_thread = std::make_shared<named_thread<offload_thread>>();
 	}
 
+	// Threshold calibration
+	void dma_manager::on_inline_copy(u64 ticks, u32 length) const
+	{
+		m_inline_copy_ticks += ticks;
+		m_inline_copy_bytes += length;
+		update_immediate_transfer_size();
+	}
+
+	void dma_manager::on_enqueue(u64 ticks) const
+	{
+		m_enqueue_ticks += ticks;
+		m_enqueue_count++;
+		update_immediate_transfer_size();
+	}
+
+	void dma_manager::update_immediate_transfer_size() const
+	{
+		if (++m_calibration_samples < calibration_interval || !m_inline_copy_bytes || !m_enqueue_count)
+		{
+			return;
+		}
+
+		// Offloading only pays off when the copy costs the RSX thread several times the price of queueing it,
+		// since the RSX thread may have to wait for the transfer later on anyway
+		const f64 ticks_per_byte = static_cast<f64>(m_inline_copy_ticks) / m_inline_copy_bytes;
+		const f64 enqueue_ticks = static_cast<f64>(m_enqueue_ticks) / m_enqueue_count;
+		const f64 break_even = std::max(enqueue_ticks / std::max(ticks_per_byte, 1e-6) * 4., 0.);
+
+		m_immediate_transfer_size = utils::align(static_cast<u32>(std::clamp<f64>(break_even, min_immediate_transfer_size, max_immediate_transfer_size)), 512);
+
+		// Decay the history so that the threshold follows changes in load
+		m_inline_copy_ticks /= 2;
+		m_inline_copy_bytes /= 2;
+		m_enqueue_ticks /= 2;
+		m_enqueue_count /= 2;
+		m_calibration_samples = 0;
+	}
+
 	// General transport
 	void dma_manager::copy(void *dst, std::vector<u8>& src, u32 length) const
 	{
-		if (length <= max_immediate_transfer_size || !g_cfg.video.multithreaded_rsx)
+		if (length <= m_immediate_transfer_size || !g_cfg.video.multithreaded_rsx)
 		{
+			const u64 start = utils::get_tsc();
 			std::memcpy(dst, src.data(), length);
+
+			if (g_cfg.video.multithreaded_rsx)
+			{
+				on_inline_copy(utils::get_tsc() - start, length);
+			}
 		}
 		else
 		{
+			const u64 start = utils::get_tsc();
 			m_thread->m_enqueued_count++;
 			m_thread->m_work_queue.push(dst, src, length);
+			on_enqueue(utils::get_tsc() - start);
 		}
 	}
 
 	void dma_manager::copy(void *dst, void *src, u32 length) const
 	{
-		if (length <= max_immediate_transfer_size || !g_cfg.video.multithreaded_rsx)
+		if (length <= m_immediate_transfer_size || !g_cfg.video.multithreaded_rsx)
 		{
+			const u64 start = utils::get_tsc();
 			const u32 vm_addr = vm::try_get_addr(src).first;
 			rsx::reservation_lock<true, 1> rsx_lock(vm_addr, length, g_cfg.video.strict_rendering_mode && vm_addr);
 			std::memcpy(dst, src, length);
+
+			if (g_cfg.video.multithreaded_rsx)
+			{
+				on_inline_copy(utils::get_tsc() - start, length);
+			}
 		}
 		else
 		{
+			const u64 start = utils::get_tsc();
 			m_thread->m_enqueued_count++;
 			m_thread->m_work_queue.push(dst, src, length);
+			on_enqueue(utils::get_tsc() - start);
 		}
 	}
 
@@ -154,7 +329,7 @@ namespace rsx
 	{
 		if (auto cpu = thread_ctrl::get_current())
 		{
-			return m_thread->current_thread_ == cpu;
+			return m_thread->owns_thread(cpu);
 		}
 
 		return false;
@@ -178,6 +353,8 @@ namespace rsx
 				return false;
 			}
 
+			perf_span span("RSX Offload Wait");
+
 			while (_thr.m_enqueued_count.load() > _thr.m_processed_count.load())
 			{
 				rsxthr->on_semaphore_acquire_wait();
@@ -202,6 +379,9 @@ namespace rsx
 	void dma_manager::set_mem_fault_flag()
 	{
 		ensure(is_current_thread()); // "Access denied"
+
+		// Copy workers may fault concurrently, recover one at a time
+		m_fault_mutex.lock();
 		m_mem_fault_flag.release(true);
 	}
 
@@ -209,11 +389,13 @@ namespace rsx
 	{
 		ensure(is_current_thread()); // "Access denied"
 		m_mem_fault_flag.release(false);
+		m_fault_mutex.unlock();
 	}
 
 	// Fault recovery
 	utils::address_range32 dma_manager::get_fault_range(bool writing) const
 	{
+		// Faults from copy workers report the whole packet being split
 		const auto m_current_job = ensure(m_thread->m_current_job);
 
 		void *address = nullptr;
@@ -3,6 +3,7 @@
 #include "util/types.hpp"
 #include "Utilities/address_range.h"
 #include "gcm_enums.h"
+#include "Utilities/mutex.h"
 
 #include <vector>
 
@@ -52,12 +53,27 @@ namespace rsx
 		};
 
 		atomic_t<bool> m_mem_fault_flag = false;
+		shared_mutex m_fault_mutex;
 
+		struct copy_worker;
 		struct offload_thread;
 		std::shared_ptr<named_thread<offload_thread>> m_thread;
 
-		// TODO: Improved benchmarks here; value determined by profiling on a Ryzen CPU, rounded to the nearest 512 bytes
-		const u32 max_immediate_transfer_size = 3584;
+		// Transfers up to this size are copied inline, recalibrated from measured copy and queueing costs
+		static constexpr u32 min_immediate_transfer_size = 1024;
+		static constexpr u32 max_immediate_transfer_size = 0x40000;
+		static constexpr u32 calibration_interval = 1024;
+
+		mutable u32 m_immediate_transfer_size = 3584;
+		mutable u64 m_inline_copy_ticks = 0;
+		mutable u64 m_inline_copy_bytes = 0;
+		mutable u64 m_enqueue_ticks = 0;
+		mutable u64 m_enqueue_count = 0;
+		mutable u32 m_calibration_samples = 0;
+
+		void on_inline_copy(u64 ticks, u32 length) const;
+		void on_enqueue(u64 ticks) const;
+		void update_immediate_transfer_size() const;
 
 	public:
 		dma_manager() = default;
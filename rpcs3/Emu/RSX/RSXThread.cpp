@@ -15,6 +15,7 @@
 #include "RSXDisAsm.h"
 
 #include "Emu/System.h"
+#include "Emu/perf_monitor.hpp"
 #include "Emu/Cell/PPUThread.h"
 #include "Emu/Cell/timers.hpp"
 #include "Emu/Cell/lv2/sys_event.h"
@@ -28,6 +29,7 @@
 #include "Utilities/date_time.h"
 
 #include "util/asm.hpp"
+#include "util/sysinfo.hpp"
 
 #include <span>
 #include <thread>
@@ -1224,6 +1226,12 @@ namespace rsx
 	{
 		m_eng_interrupt_mask.clear(rsx::backend_interrupt);
 
+		if (!m_profiler.enabled && is_benchmarking()) [[unlikely]]
+		{
+			// A benchmark was started while the FIFO is idle, profile its first frame too (disabling waits for the end of a frame)
+			m_profiler.enabled = true;
+		}
+
 		if (async_flip_requested & flip_request::emu_requested)
 		{
 			// NOTE: This has to be executed immediately
@@ -2556,17 +2564,18 @@ namespace rsx
 			}
 		}
 
+		last_host_flip_timestamp = get_system_time();
+
 		if (info.emu_flip)
 		{
 			performance_counters.sampled_frames++;
+			perf_monitor::push_frame(last_host_flip_timestamp);
 
 			if (m_pause_after_x_flips && m_pause_after_x_flips-- == 1)
 			{
 				Emu.Pause();
 			}
 		}
-
-		last_host_flip_timestamp = get_system_time();
 	}
 
 	void thread::check_zcull_status(bool framebuffer_swap)
@@ -3285,6 +3294,34 @@ namespace rsx
 			zcull_ctrl->clear(this, CELL_GCM_ZPASS_PIXEL_CNT | CELL_GCM_ZCULL_STATS);
 		}
 
+		if (m_profiler.enabled)
+		{
+			if (const u64 tsc_freq = utils::get_tsc_freq())
+			{
+				m_frame_stats.fifo_decode_time = static_cast<s64>(m_fifo_decode_ticks * 1'000'000 / tsc_freq);
+				m_frame_stats.method_dispatch_time = static_cast<s64>((m_fifo_busy_ticks - std::min(m_fifo_busy_ticks, m_fifo_decode_ticks)) * 1'000'000 / tsc_freq);
+			}
+
+			m_fifo_busy_ticks = 0;
+			m_fifo_decode_ticks = 0;
+		}
+
+		m_frame_stats.merged_draw_calls = m_flattener.get_collapsed_count();
+
+		const auto zcull_batch_stats = zcull_ctrl->pop_batch_stats();
+		m_frame_stats.zcull_batched_readbacks = zcull_batch_stats.batches;
+		m_frame_stats.zcull_syncs_avoided = zcull_batch_stats.syncs_avoided;
+
+		if (is_benchmarking()) [[unlikely]]
+		{
+			reader_lock lock(m_frame_stats_mutex);
+
+			if (m_frame_stats_callback)
+			{
+				m_frame_stats_callback(m_frame_stats);
+			}
+		}
+
 		// Save current state
 		m_queued_flip.stats = m_frame_stats;
 		m_queued_flip.push(buffer);
@@ -3331,7 +3368,19 @@ namespace rsx
 
 		// Reset current stats
 		m_frame_stats = {};
-		m_profiler.enabled = !!g_cfg.video.debug_overlay;
+		m_profiler.enabled = !!g_cfg.video.debug_overlay || is_benchmarking();
+	}
+
+	void thread::set_frame_stats_callback(std::function<void(const frame_statistics_t&)> callback)
+	{
+		{
+			std::lock_guard lock(m_frame_stats_mutex);
+			m_frame_stats_callback = std::move(callback);
+			m_benchmarking = !!m_frame_stats_callback;
+		}
+
+		// The profiler is only touched by the RSX thread, let it switch on from the local task
+		m_eng_interrupt_mask |= rsx::backend_interrupt;
 	}
 
 	f64 thread::get_cached_display_refresh_rate()
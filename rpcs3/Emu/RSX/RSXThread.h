@@ -127,6 +127,8 @@ namespace rsx
 		void dump_misc(std::string& ret, std::any& custom_data) const override;
 
 	protected:
+		friend class FIFO::FIFO_control;
+
 		FIFO::flattening_helper m_flattener;
 		u32 fifo_ret_addr = RSX_CALL_STACK_EMPTY;
 		u32 saved_fifo_ret = RSX_CALL_STACK_EMPTY;
@@ -157,6 +159,15 @@ namespace rsx
 		rsx::profiling_timer m_profiler;
 		frame_statistics_t m_frame_stats{};
 
+		// FIFO profiling in TSC ticks, converted to frame stats on frame end
+		u64 m_fifo_busy_ticks = 0;
+		u64 m_fifo_decode_ticks = 0;
+
+		// Benchmark consumer of per-frame statistics (RSX replay), installed from another thread
+		shared_mutex m_frame_stats_mutex;
+		std::function<void(const frame_statistics_t&)> m_frame_stats_callback;
+		atomic_t<bool> m_benchmarking = false;
+
 		// Savestates related
 		u32 m_pause_after_x_flips = 0;
 
@@ -327,6 +338,7 @@ namespace rsx
 		reports::conditional_render_eval cond_render_ctrl;
 
 		virtual u64 get_cycles() = 0;
+		virtual u64 get_cpu_time() const = 0;
 		virtual ~thread();
 
 		static constexpr auto thread_name = "rsx::thread"sv;
@@ -465,6 +477,12 @@ namespace rsx
 		// Get stats object
 		frame_statistics_t& get_stats() { return m_frame_stats; }
 
+		// Forces profiling on and forwards the statistics of every completed frame to the callback.
+		// Must be installed while the FIFO is idle. Once removed (empty callback), it is guaranteed not to be running.
+		void set_frame_stats_callback(std::function<void(const frame_statistics_t&)> callback);
+
+		bool is_benchmarking() const { return m_benchmarking.load(); }
+
 		// Returns true if the current thread is the active RSX thread
 		inline bool is_current_thread() const
 		{
@@ -7,6 +7,33 @@ namespace rsx
 {
 	namespace reports
 	{
+		void collect_pending_queries(std::span<const queued_report_write> writes, std::span<const query_stat_counter> counters, u32 stop_address, std::vector<occlusion_query_info*>& out)
+		{
+			out.clear();
+
+			for (const auto& writer : writes)
+			{
+				if (!writer.sink)
+				{
+					// Unclaimed writes cannot be retired yet
+					break;
+				}
+
+				const bool implemented = (writer.type == CELL_GCM_ZPASS_PIXEL_CNT || writer.type == CELL_GCM_ZCULL_STATS3);
+				const bool have_result = ::at32(counters, writer.counter_tag).result && !g_cfg.video.precise_zpass_count;
+
+				if (implemented && !have_result && writer.query && writer.query->num_draws)
+				{
+					out.push_back(writer.query);
+				}
+
+				if (stop_address && writer.sink == stop_address && !writer.forwarder)
+				{
+					break;
+				}
+			}
+		}
+
 		ZCULL_control::ZCULL_control()
 		{
 			for (auto& query : m_occlusion_query_data)
@@ -407,6 +434,25 @@ namespace rsx
 			}
 		}
 
+		void ZCULL_control::resolve_pending_queries(u32 sync_address)
+		{
+			if (!g_cfg.video.batch_zcull_queries)
+			{
+				return;
+			}
+
+			collect_pending_queries(m_pending_writes, m_statistics_map, sync_address, m_query_batch);
+			if (m_query_batch.empty())
+			{
+				return;
+			}
+
+			sync_occlusion_queries(m_query_batch);
+
+			m_batch_stats.batches++;
+			m_batch_stats.syncs_avoided += ::size32(m_query_batch) - 1;
+		}
+
 		void ZCULL_control::sync(::rsx::thread* ptimer)
 		{
 			if (m_pending_writes.empty())
@@ -442,6 +488,9 @@ namespace rsx
 				}
 			}
 
+			// Wait for all claimed reports at once instead of stalling on each one
+			resolve_pending_queries(0);
+
 			u32 processed = 0;
 			const bool has_unclaimed = (m_pending_writes.back().sink == 0);
 
@@ -578,6 +627,12 @@ namespace rsx
 				}
 			}
 
+			if (sync_address)
+			{
+				// Everything up to the requested report is read back unconditionally, wait for it in one go
+				resolve_pending_queries(sync_address);
+			}
+
 			u32 processed = 0;
 			for (auto& writer : m_pending_writes)
 			{
@@ -9,6 +9,7 @@
 #include "rsx_utils.h"
 
 #include <vector>
+#include <span>
 #include <stack>
 #include <unordered_map>
 
@@ -66,6 +67,17 @@ namespace rsx
 			u32 flags;
 		};
 
+		struct query_batch_stats
+		{
+			u32 batches;       // Number of batched resolves issued to the backend
+			u32 syncs_avoided; // Number of queries that did not need a wait of their own
+		};
+
+		// Collects the queries that must be read back before the claimed writes in the queue can be retired, in queue order.
+		// If stop_address is set, collection ends with the final write to that address, otherwise all claimed writes are visited.
+		// Queries whose counter already holds a hit are skipped, their results are discarded on retire (unless precise_zpass_count is set).
+		void collect_pending_queries(std::span<const queued_report_write> writes, std::span<const query_stat_counter> counters, u32 stop_address, std::vector<occlusion_query_info*>& out);
+
 		struct sync_hint_payload_t
 		{
 			occlusion_query_info* query;
@@ -131,6 +143,9 @@ namespace rsx
 			std::vector<queued_report_write> m_pending_writes{};
 			std::array<query_stat_counter, max_stat_registers> m_statistics_map{};
 
+			std::vector<occlusion_query_info*> m_query_batch{};
+			query_batch_stats m_batch_stats{};
+
 			// Enables/disables the ZCULL unit
 			void set_active(class ::rsx::thread* ptimer, bool state, bool flush_queue);
 
@@ -150,6 +165,9 @@ namespace rsx
 			// Retire operation
 			void retire(class ::rsx::thread* ptimer, queued_report_write* writer, u32 result);
 
+			// Make the results of all queries needed up to sync_address available in one backend round trip
+			void resolve_pending_queries(u32 sync_address);
+
 		public:
 
 			ZCULL_control();
@@ -198,12 +216,18 @@ namespace rsx
 			// Optimization check
 			bool is_query_result_urgent(u32 address) const { return m_pages_accessed[rsx::classify_location(address)]; }
 
+			// Returns the batching counters gathered since the last call and resets them
+			query_batch_stats pop_batch_stats() { return std::exchange(m_batch_stats, {}); }
+
 			// Backend methods (optional, will return everything as always visible by default)
 			virtual void begin_occlusion_query(occlusion_query_info* /*query*/) {}
 			virtual void end_occlusion_query(occlusion_query_info* /*query*/) {}
 			virtual bool check_occlusion_query_status(occlusion_query_info* /*query*/) { return true; }
 			virtual void get_occlusion_query_result(occlusion_query_info* query) { query->result = -1; }
 			virtual void discard_occlusion_query(occlusion_query_info* /*query*/) {}
+
+			// Waits once for the newest of the queries so that reading any of them afterwards does not stall. Queries are in submission order.
+			virtual void sync_occlusion_queries(std::span<occlusion_query_info* const> /*queries*/) {}
 		};
 
 		// Helper class for conditional rendering
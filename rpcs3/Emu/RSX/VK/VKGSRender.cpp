@@ -408,6 +408,11 @@ u64 VKGSRender::get_cycles()
 	return thread_ctrl::get_cycles(static_cast<named_thread<VKGSRender>&>(*this));
 }
 
+u64 VKGSRender::get_cpu_time() const
+{
+	return thread_ctrl::get_cpu_time(static_cast<const named_thread<VKGSRender>&>(*this));
+}
+
 VKGSRender::VKGSRender(utils::serial* ar) noexcept : GSRender(ar)
 {
 	// Initialize dependencies
@@ -924,13 +929,13 @@ bool VKGSRender::on_access_violation(u32 address, bool is_writing)
 	{
 		if (g_fxo->get<rsx::dma_manager>().is_current_thread())
 		{
-			// The offloader thread cannot handle flush requests
+			// The offloader threads cannot handle flush requests. Raising the fault flag also serializes recovery between them.
+			g_fxo->get<rsx::dma_manager>().set_mem_fault_flag();
 			ensure(!(m_queue_status & flush_queue_state::deadlock));
 
 			m_offloader_fault_range = g_fxo->get<rsx::dma_manager>().get_fault_range(is_writing);
 			m_offloader_fault_cause = (is_writing) ? rsx::invalidation_cause::write : rsx::invalidation_cause::read;
 
-			g_fxo->get<rsx::dma_manager>().set_mem_fault_flag();
 			m_queue_status |= flush_queue_state::deadlock;
 			m_eng_interrupt_mask |= rsx::backend_interrupt;
 
@@ -1828,7 +1833,8 @@ bool VKGSRender::load_program()
 				current_fp_metadata,
 				current_vp_metadata,
 				current_vertex_program.ctrl,
-				current_fragment_program.ctrl);
+				current_fragment_program.ctrl,
+				current_fragment_program.texture_state.texture_dimensions);
 
 			std::tie(m_vs_binding_table, m_fs_binding_table) = get_binding_table();
 			return true;
@@ -1930,7 +1936,8 @@ bool VKGSRender::load_program()
 				current_fp_metadata,
 				current_vp_metadata,
 				current_vertex_program.ctrl,
-				current_fragment_program.ctrl);
+				current_fragment_program.ctrl,
+				current_fragment_program.texture_state.texture_dimensions);
 
 			// Program has changed, reupload
 			m_interpreter_state = rsx::invalidate_pipeline_bits;
@@ -2763,6 +2770,21 @@ void VKGSRender::end_occlusion_query(rsx::reports::occlusion_query_info* query)
 	m_active_query_info = nullptr;
 }
 
+void VKGSRender::hard_sync_occlusion_queries()
+{
+	// The queries are still recorded in the current command buffer, submit it and wait for the GPU
+	std::lock_guard lock(m_flush_queue_mutex);
+	flush_command_queue();
+
+	if (m_flush_requests.pending())
+	{
+		m_flush_requests.clear_pending_flag();
+	}
+
+	rsx_log.warning("[Performance warning] Unexpected ZCULL read caused a hard sync");
+	busy_wait();
+}
+
 bool VKGSRender::check_occlusion_query_status(rsx::reports::occlusion_query_info* query)
 {
 	if (!query->num_draws)
@@ -2789,16 +2811,7 @@ void VKGSRender::get_occlusion_query_result(rsx::reports::occlusion_query_info*
 	{
 		if (data.is_current(m_current_command_buffer))
 		{
-			std::lock_guard lock(m_flush_queue_mutex);
-			flush_command_queue();
-
-			if (m_flush_requests.pending())
-			{
-				m_flush_requests.clear_pending_flag();
-			}
-
-			rsx_log.warning("[Performance warning] Unexpected ZCULL read caused a hard sync");
-			busy_wait();
+			hard_sync_occlusion_queries();
 		}
 
 		data.sync();
@@ -2834,6 +2847,38 @@ void VKGSRender::discard_occlusion_query(rsx::reports::occlusion_query_info* que
 	data.indices.clear();
 }
 
+void VKGSRender::sync_occlusion_queries(std::span<rsx::reports::occlusion_query_info* const> queries)
+{
+	vk::occlusion_data* newest = nullptr;
+	bool hard_sync = false;
+
+	for (const auto query : queries)
+	{
+		auto& data = m_occlusion_map[query->driver_handle];
+		if (data.indices.empty())
+		{
+			continue;
+		}
+
+		hard_sync |= data.is_current(m_current_command_buffer);
+		newest = &data;
+	}
+
+	if (!newest)
+	{
+		return;
+	}
+
+	if (hard_sync)
+	{
+		hard_sync_occlusion_queries();
+	}
+
+	// Command buffers and queries retire in submission order. Once the newest query is available, so are all the others.
+	newest->sync();
+	m_occlusion_query_manager->get_query_result(newest->indices.back());
+}
+
 void VKGSRender::emergency_query_cleanup(vk::command_buffer* commands)
 {
 	ensure(commands == static_cast<vk::command_buffer*>(m_current_command_buffer));
@@ -208,6 +208,7 @@ private:
 
 public:
 	u64 get_cycles() final;
+	u64 get_cpu_time() const final;
 	~VKGSRender() override;
 
 	VKGSRender(utils::serial* ar) noexcept;
@@ -223,6 +224,7 @@ private:
 		VkPipelineStageFlags pipeline_stage_flags = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
 
 	void flush_command_queue(bool hard_sync = false, bool do_not_switch = false);
+	void hard_sync_occlusion_queries();
 	void queue_swap_request();
 	void frame_context_cleanup(vk::frame_context_t *ctx);
 	void advance_queued_frames();
@@ -267,6 +269,7 @@ public:
 	bool check_occlusion_query_status(rsx::reports::occlusion_query_info* query) override;
 	void get_occlusion_query_result(rsx::reports::occlusion_query_info* query) override;
 	void discard_occlusion_query(rsx::reports::occlusion_query_info* query) override;
+	void sync_occlusion_queries(std::span<rsx::reports::occlusion_query_info* const> queries) override;
 
 	// External callback in case we need to suddenly submit a commandlist unexpectedly, e.g in a violation handler
 	void emergency_query_cleanup(vk::command_buffer* commands);
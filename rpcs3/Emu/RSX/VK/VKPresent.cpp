@@ -11,6 +11,7 @@
 #include "upscalers/nearest_pass.hpp"
 #include "util/asm.hpp"
 #include "util/video_provider.h"
+#include "Emu/perf_meter.hpp"
 
 extern atomic_t<bool> g_user_asked_for_screenshot;
 extern atomic_t<recording_mode> g_recording_mode;
@@ -148,6 +149,8 @@ bool VKGSRender::reinitialize_swapchain()
 
 void VKGSRender::present(vk::frame_context_t *ctx)
 {
+	perf_span span("VK Present");
+
 	ensure(ctx->present_image != umax);
 
 	// Partial CS flush
@@ -424,6 +427,8 @@ vk::viewable_image* VKGSRender::get_present_source(/* inout */ vk::present_surfa
 
 void VKGSRender::flip(const rsx::display_flip_info_t& info)
 {
+	perf_span span("RSX Flip", info.buffer);
+
 	// Check swapchain condition/status
 	if (!m_swapchain->supports_automatic_wm_reports())
 	{
@@ -926,6 +931,7 @@ void VKGSRender::flip(const rsx::display_flip_info_t& info)
 			const auto num_texture_upload_miss = m_texture_cache.get_texture_upload_misses_this_frame();
 			const auto texture_upload_miss_ratio = m_texture_cache.get_texture_upload_miss_percentage();
 			const auto texture_copies_ellided = m_texture_cache.get_texture_copies_ellided_this_frame();
+			const auto textures_revived = m_texture_cache.get_textures_revived_this_frame();
 			const auto vertex_cache_hit_count = (info.stats.vertex_cache_request_count - info.stats.vertex_cache_miss_count);
 			const auto vertex_cache_hit_ratio = info.stats.vertex_cache_request_count
 				? (vertex_cache_hit_count * 100) / info.stats.vertex_cache_request_count
@@ -940,6 +946,7 @@ void VKGSRender::flip(const rsx::display_flip_info_t& info)
 				"Internal Resolution:      %s\n"
 				"RSX Load:                 %3d%%\n"
 				"draw calls: %17d\n"
+				"merged draw calls: %10d\n"
 				"submits: %20d\n"
 				"draw call setup: %12dus\n"
 				"vertex upload time: %9dus\n"
@@ -950,17 +957,19 @@ void VKGSRender::flip(const rsx::display_flip_info_t& info)
 				"Texture cache memory: %7dM\n"
 				"Temporary texture memory: %3dM\n"
 				"Flush requests: %13d  = %2d (%3d%%) hard faults, %2d unavoidable, %2d misprediction(s), %2d speculation(s)\n"
-				"Texture uploads: %12u (%u from CPU - %02u%%, %u copies avoided)\n"
+				"Texture uploads: %12u (%u from CPU - %02u%%, %u copies avoided, %u unchanged)\n"
 				"Vertex cache hits: %10u/%u (%u%%)\n"
-				"Program cache lookup ellision: %u/%u (%u%%)",
+				"Program cache lookup ellision: %u/%u (%u%%)\n"
+				"ZCULL batched readbacks: %u (%u syncs avoided)",
 				info.stats.framebuffer_stats.to_string(resolution_scaling_config, !backend_config.supports_hw_msaa),
-				get_load(), info.stats.draw_calls, info.stats.submit_count, info.stats.setup_time, info.stats.vertex_upload_time,
+				get_load(), info.stats.draw_calls, info.stats.merged_draw_calls, info.stats.submit_count, info.stats.setup_time, info.stats.vertex_upload_time,
 				info.stats.textures_upload_time, info.stats.draw_exec_time, info.stats.flip_time,
 				num_dirty_textures, texture_memory_size, tmp_texture_memory_size,
 				num_flushes, num_misses, cache_miss_ratio, num_unavoidable, num_mispredict, num_speculate,
-				num_texture_upload, num_texture_upload_miss, texture_upload_miss_ratio, texture_copies_ellided,
+				num_texture_upload, num_texture_upload_miss, texture_upload_miss_ratio, texture_copies_ellided, textures_revived,
 				vertex_cache_hit_count, info.stats.vertex_cache_request_count, vertex_cache_hit_ratio,
-				program_cache_ellided, program_cache_lookups, program_cache_ellision_rate)
+				program_cache_ellided, program_cache_lookups, program_cache_ellision_rate,
+				info.stats.zcull_batched_readbacks, info.stats.zcull_syncs_avoided)
 			);
 		}
 
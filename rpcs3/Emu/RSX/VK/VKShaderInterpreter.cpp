@@ -387,6 +387,11 @@ namespace vk
 		const char* type_names[] = { "sampler1D", "sampler2D", "sampler3D", "samplerCube" };
 		if (compiler_options & COMPILER_OPT_ENABLE_TEXTURES)
 		{
+			if (compiler_options & COMPILER_OPT_ENABLE_TEXTURE_TYPES)
+			{
+				builder << "#define WITH_TEXTURE_TYPES\n";
+			}
+
 			builder << "#define WITH_TEXTURES\n\n";
 
 			for (int i = 0, bind_location = fragment_textures_start; i < 4; ++i)
@@ -553,7 +558,8 @@ namespace vk
 		const program_hash_util::fragment_program_utils::fragment_program_metadata& fp_metadata,
 		const program_hash_util::vertex_program_utils::vertex_program_metadata& vp_metadata,
 		u32 vp_ctrl,
-		u32 fp_ctrl)
+		u32 fp_ctrl,
+		u32 fp_texture_dimensions)
 	{
 		pipeline_key key;
 		key.compiler_opt = 0;
@@ -592,7 +598,7 @@ namespace vk
 		if (fp_ctrl & CELL_GCM_SHADER_CONTROL_32_BITS_EXPORTS) key.compiler_opt |= COMPILER_OPT_ENABLE_F32_EXPORT;
 		if (fp_ctrl & RSX_SHADER_CONTROL_USES_KIL) key.compiler_opt |= COMPILER_OPT_ENABLE_KIL;
 		if (fp_ctrl & RSX_SHADER_CONTROL_ROP_OUTPUT_REMAP) key.compiler_opt |= COMPILER_OPT_ENABLE_ROP_REMAP;
-		if (fp_metadata.referenced_textures_mask) key.compiler_opt |= COMPILER_OPT_ENABLE_TEXTURES;
+		key.compiler_opt |= program_common::interpreter::get_texture_options(fp_metadata.referenced_textures_mask, fp_texture_dimensions);
 		if (fp_metadata.has_branch_instructions) key.compiler_opt |= COMPILER_OPT_ENABLE_FLOW_CTRL;
 		if (fp_metadata.has_pack_instructions) key.compiler_opt |= COMPILER_OPT_ENABLE_PACKING;
 		if (rsx::method_registers.polygon_stipple_enabled()) key.compiler_opt |= COMPILER_OPT_ENABLE_STIPPLING;
@@ -96,7 +96,8 @@ namespace vk
 			const program_hash_util::fragment_program_utils::fragment_program_metadata& fp_metadata,
 			const program_hash_util::vertex_program_utils::vertex_program_metadata& vp_metadata,
 			u32 vp_ctrl,
-			u32 fp_ctrl);
+			u32 fp_ctrl,
+			u32 fp_texture_dimensions);
 
 		// Retrieve the shader components that make up the current interpreter
 		std::pair<std::shared_ptr<VKVertexProgram>, std::shared_ptr<VKFragmentProgram>> get_shaders() const;
@@ -80,7 +80,15 @@ namespace rsx
 		}
 
 		const auto vertex_size = get_vertex_size_in_dwords();
-		data.resize(vertex_size * required_vertex_count);
+		const u32 required_size = vertex_size * required_vertex_count;
+
+		if (data.capacity() < required_size)
+		{
+			// Immediate mode appends one vertex at a time. Grow geometrically, the storage is kept across draws.
+			data.reserve(std::max(required_size, data.capacity() * 2));
+		}
+
+		data.resize(required_size);
 
 		// For all previous verts, copy over the register contents duplicated over the stream.
 		// Internally it appears RSX actually executes the draw commands as they are encountered.
@@ -35,6 +35,7 @@
 #include "Loader/PSF.h"
 #include "Loader/TAR.h"
 #include "Loader/ISO.h"
+#include "Loader/pkg_device.h"
 #include "Loader/ELF.h"
 #include "Loader/disc.h"
 
@@ -831,7 +832,7 @@ void Emulator::SetUsr(const std::string& user)
 	m_usr = user;
 }
 
-bool Emulator::BootRsxCapture(const std::string& path)
+bool Emulator::BootRsxCapture(const std::string& path, u32 benchmark_loops)
 {
 	if (m_state != system_state::stopped || m_restrict_emu_state_change)
 	{
@@ -926,6 +927,16 @@ bool Emulator::BootRsxCapture(const std::string& path)
 	Init();
 	g_cfg.video.disable_on_disk_shader_cache.set(true);
 
+	if (benchmark_loops)
+	{
+		// Measure the CPU side of the RSX only, as fast as possible, and exit when done
+		g_cfg.video.renderer.set(video_renderer::null);
+		g_cfg.video.frame_limit.set(frame_limit_type::none);
+		g_cfg.misc.autoexit.set(true);
+
+		sys_log.notice("Benchmarking rsx capture: %u loops", benchmark_loops);
+	}
+
 	vm::init();
 	g_fxo->init(false);
 
@@ -946,7 +957,7 @@ bool Emulator::BootRsxCapture(const std::string& path)
 	m_state = system_state::starting;
 	m_state.notify_all();
 
-	ensure(g_fxo->init<named_thread<rsx::rsx_replay_thread>>("RSX Replay", std::move(frame)));
+	ensure(g_fxo->init<named_thread<rsx::rsx_replay_thread>>("RSX Replay", std::move(frame), benchmark_loops));
 
 	return true;
 }
@@ -1004,6 +1015,7 @@ game_boot_result Emulator::BootGame(const std::string& path, const std::string&
 				if (result != game_boot_result::no_errors)
 				{
 					unload_iso();
+					unload_pkg();
 					GetCallbacks().close_gs_frame();
 				}
 			}
@@ -1159,6 +1171,7 @@ game_boot_result Emulator::Load(const std::string& title_id, bool is_disc_patch,
 
 	std::string inherited_ps3_game_path;
 	bool launching_from_disc_archive = false;
+	bool launching_from_pkg = false;
 
 	{
 		Init();
@@ -1251,15 +1264,16 @@ game_boot_result Emulator::Load(const std::string& title_id, bool is_disc_patch,
 			m_ar->serialize(argv.emplace_back(), disc_info, klic.emplace_back(), m_game_dir, hdd1);
 
 			launching_from_disc_archive = is_iso_file(disc_info);
+			launching_from_pkg = !launching_from_disc_archive && is_pkg_file(disc_info);
 
-			sys_log.notice("Savestate: is iso archive = %d ('%s')", launching_from_disc_archive, disc_info);
+			sys_log.notice("Savestate: is iso archive = %d, is package = %d ('%s')", launching_from_disc_archive, launching_from_pkg, disc_info);
 
 			if (!klic[0])
 			{
 				klic.clear();
 			}
 
-			if (!launching_from_disc_archive && !disc_info.empty() && disc_info[0] != '/')
+			if (!launching_from_disc_archive && !launching_from_pkg && !disc_info.empty() && disc_info[0] != '/')
 			{
 				// Restore disc path for disc games (must exist in games.yml i.e. your game library)
 				m_title_id = disc_info;
@@ -1352,7 +1366,7 @@ game_boot_result Emulator::Load(const std::string& title_id, bool is_disc_patch,
 				return game_boot_result::savestate_version_unsupported;
 			}
 
-			if (disc_info.starts_with("/"sv))
+			if (!launching_from_pkg && disc_info.starts_with("/"sv))
 			{
 				// Restore SFO directory for PSN games
 
@@ -1384,6 +1398,20 @@ game_boot_result Emulator::Load(const std::string& title_id, bool is_disc_patch,
 				load_iso(disc_info);
 				m_path = iso_device::virtual_device_name + "/" + argv[0];
 
+				resolve_path_as_vfs_path = false;
+			}
+			else if (launching_from_pkg)
+			{
+				sys_log.notice("Savestate: Loading package");
+
+				if (std::string path; !load_pkg(disc_info, path))
+				{
+					return game_boot_result::invalid_file_or_folder;
+				}
+
+				m_path_real = disc_info;
+				m_path = pkg_device::virtual_device_name + "/" + argv[0];
+
 				resolve_path_as_vfs_path = false;
 			}
 		}
@@ -1576,6 +1604,23 @@ game_boot_result Emulator::Load(const std::string& title_id, bool is_disc_patch,
 			m_path_real = m_path;
 			m_path = std::move(path);
 		}
+		else if (!launching_from_disc_archive && !launching_from_pkg && is_pkg_file(m_path))
+		{
+			sys_log.notice("Loading package '%s'", m_path);
+
+			// The package is mounted in place of its installation directory
+			std::string path;
+
+			if (!load_pkg(m_path, path))
+			{
+				return game_boot_result::invalid_file_or_folder;
+			}
+
+			launching_from_pkg = true;
+
+			m_path_real = m_path;
+			m_path = std::move(path);
+		}
 
 		sys_log.notice("Load: is iso archive = %d (m_path='%s')", launching_from_disc_archive, m_path);
 
@@ -2150,8 +2195,11 @@ game_boot_result Emulator::Load(const std::string& title_id, bool is_disc_patch,
 			{
 				std::string game_dir = m_sfo_dir;
 
-				// Add HG games not in HDD0 to games.yml
-				[[maybe_unused]] const games_config::result res = m_games_config.add_external_hdd_game(m_title_id, game_dir);
+				// Add HG games not in HDD0 to games.yml, mounted packages are not remembered
+				if (!game_dir.starts_with(pkg_device::virtual_device_name))
+				{
+					[[maybe_unused]] const games_config::result res = m_games_config.add_external_hdd_game(m_title_id, game_dir);
+				}
 
 				const std::string dir = std::string(fmt::trim_sv(std::string_view(game_dir).substr(fs::get_parent_dir_view(game_dir).size() + 1), fs::delim));
 				vfs::mount("/dev_hdd0/game/" + dir, game_dir + '/');
@@ -3830,6 +3878,16 @@ void Emulator::Kill(bool allow_autoexit, bool savestate, savestate_stage* save_s
 					ar(m_path.substr(iso_device::virtual_device_name.size() + 1));
 					ar(iso_dev->get_loaded_iso());
 				}
+				else if (m_path.starts_with(pkg_device::virtual_device_name + "/"))
+				{
+					const auto device = fs::get_virtual_device(pkg_device::virtual_device_name + "/");
+					ensure(device);
+
+					const auto pkg_dev = dynamic_cast<const pkg_device*>(device.get());
+
+					ar(m_path.substr(pkg_device::virtual_device_name.size() + 1));
+					ar(pkg_dev->get_loaded_pkg());
+				}
 				else if (auto dir = vfs::get("/dev_bdvd/PS3_GAME"); fs::is_dir(dir) && !fs::is_file(fs::get_parent_dir(dir) + "/PS3_DISC.SFB"))
 				{
 					// Fake /dev_bdvd/PS3_GAME detected, use HDD0 for m_path restoration
@@ -4125,6 +4183,7 @@ void Emulator::Kill(bool allow_autoexit, bool savestate, savestate_stage* save_s
 			if (!m_continuous_mode)
 			{
 				unload_iso();
+				unload_pkg();
 			}
 
 			initialize_timebased_time(0, true);
@@ -4168,12 +4227,12 @@ game_boot_result Emulator::Restart(bool graceful, bool reset_path)
 
 	Emu.after_kill_callback = [this, reset_path]
 	{
-		// Reset boot path in case of ISO
-		if (m_path.starts_with(iso_device::virtual_device_name))
+		// Reset boot path in case of ISO or PKG
+		if (m_path.starts_with(iso_device::virtual_device_name) || m_path.starts_with(pkg_device::virtual_device_name))
 		{
 			sys_log.notice("Continuous boot: Resetting boot path from '%s' to '%s'", m_path, m_path_real);
 			ensure(!m_path_real.empty());
-			ensure(!m_path_real.starts_with(iso_device::virtual_device_name));
+			ensure(!m_path_real.starts_with(iso_device::virtual_device_name) && !m_path_real.starts_with(pkg_device::virtual_device_name));
 			m_path = m_path_real;
 		}
 
@@ -431,7 +431,7 @@ public:
 	}
 
 	game_boot_result BootGame(const std::string& path, const std::string& title_id = "", bool direct = false, cfg_mode config_mode = cfg_mode::custom, const std::string& config_path = "", const std::optional<std::string>& db_config = std::nullopt);
-	bool BootRsxCapture(const std::string& path);
+	bool BootRsxCapture(const std::string& path, u32 benchmark_loops = 0);
 
 	void SetForceBoot(bool force_boot);
 	void SetContinuousMode(bool continuous_mode);
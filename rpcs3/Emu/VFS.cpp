@@ -2,6 +2,7 @@
 #include "IdManager.h"
 #include "System.h"
 #include "VFS.h"
+#include "VFS_host_cache.h"
 
 #include "Cell/lv2/sys_fs.h"
 
@@ -26,12 +27,31 @@ struct vfs_directory
 	std::map<std::string, std::unique_ptr<vfs_directory>> dirs;
 };
 
+// Bounds of the lookup caches, they are simply cleared when full
+constexpr usz vfs_path_cache_size = 8192;
+constexpr usz vfs_stat_cache_size = 8192;
+constexpr usz vfs_dir_cache_size = 256;
+
 struct vfs_manager
 {
 	shared_mutex mutex{};
 
 	// VFS root
 	vfs_directory root{};
+
+	// Path cache, depends on the mount table and is cleared with it (locked after mutex)
+	shared_mutex cache_mutex{};
+	std::map<std::string, std::string, std::less<>> path_cache;
+
+	void clear_cache()
+	{
+		{
+			std::lock_guard lock(cache_mutex);
+			path_cache.clear();
+		}
+
+		vfs::invalidate_host_cache();
+	}
 };
 
 bool vfs::mount(std::string_view vpath, std::string_view path, bool is_dir)
@@ -80,6 +100,8 @@ bool vfs::mount(std::string_view vpath, std::string_view path, bool is_dir)
 			if (path == "/") // Special
 				list.back()->path = "/";
 
+			table.clear_cache();
+
 			vfs_log.notice("Mounted path \"%s\" to \"%s\"", vpath_backup, list.back()->path);
 			return true;
 		}
@@ -191,22 +213,13 @@ bool vfs::unmount(std::string_view vpath)
 	};
 	unmount_children(table.root, 0);
 
+	table.clear_cache();
+
 	return true;
 }
 
-std::string vfs::get(std::string_view vpath, std::vector<std::string>* out_dir, std::string* out_path, std::source_location src_loc)
+static std::string vfs_get_path(const vfs_manager& table, std::string_view vpath, std::vector<std::string>* out_dir, std::string* out_path)
 {
-	// Just to make the code more robust.
-	// It should never happen because we take care to initialize Emu (and so also vfs_manager) with Emu.Init() before this function is invoked
-	if (!g_fxo->is_init<vfs_manager>())
-	{
-		fmt::throw_exception("vfs_manager not initialized.%s", src_loc);
-	}
-
-	auto& table = g_fxo->get<vfs_manager>();
-
-	reader_lock lock(table.mutex);
-
 	// Resulting path fragments: decoded ones
 	std::vector<std::string_view> result;
 	result.reserve(vpath.size() / 2);
@@ -375,6 +388,155 @@ std::string vfs::get(std::string_view vpath, std::vector<std::string>* out_dir,
 	return std::string{result_base} + fmt::merge(escaped, "/");
 }
 
+std::string vfs::get(std::string_view vpath, std::vector<std::string>* out_dir, std::string* out_path, std::source_location src_loc)
+{
+	// Just to make the code more robust.
+	// It should never happen because we take care to initialize Emu (and so also vfs_manager) with Emu.Init() before this function is invoked
+	if (!g_fxo->is_init<vfs_manager>())
+	{
+		fmt::throw_exception("vfs_manager not initialized.%s", src_loc);
+	}
+
+	auto& table = g_fxo->get<vfs_manager>();
+
+	reader_lock lock(table.mutex);
+
+	// Only the plain lookup is cached, it is what sys_fs calls for every path
+	const bool use_cache = !out_dir && !out_path;
+
+	if (use_cache)
+	{
+		reader_lock cache_lock(table.cache_mutex);
+
+		if (const auto found = table.path_cache.find(vpath); found != table.path_cache.end())
+		{
+			return found->second;
+		}
+	}
+
+	std::string result = vfs_get_path(table, vpath, out_dir, out_path);
+
+	if (use_cache)
+	{
+		std::lock_guard cache_lock(table.cache_mutex);
+
+		if (table.path_cache.size() >= vfs_path_cache_size)
+		{
+			table.path_cache.clear();
+		}
+
+		table.path_cache.emplace(vpath, result);
+	}
+
+	return result;
+}
+
+bool vfs::get_stat_cached(const std::string& path, fs::stat_t& info)
+{
+	auto& table = g_fxo->get<vfs_host_cache>();
+	const u64 gen = table.gen;
+
+	{
+		reader_lock lock(table.mutex);
+
+		if (const auto found = table.stat_cache.find(path); found != table.stat_cache.end())
+		{
+			if (found->second.error != fs::error::ok)
+			{
+				fs::g_tls_error = found->second.error;
+				return false;
+			}
+
+			info = found->second.info;
+			return true;
+		}
+	}
+
+	vfs_host_cache::stat_result result{};
+
+	if (!fs::get_stat(path, result.info))
+	{
+		result.error = fs::g_tls_error;
+	}
+
+	if (std::lock_guard lock(table.mutex); table.gen == gen)
+	{
+		if (table.stat_cache.size() >= vfs_stat_cache_size)
+		{
+			table.stat_cache.clear();
+		}
+
+		table.stat_cache.emplace(path, result);
+		table.has_entries = true;
+	}
+
+	if (result.error != fs::error::ok)
+	{
+		fs::g_tls_error = result.error;
+		return false;
+	}
+
+	info = result.info;
+	return true;
+}
+
+std::shared_ptr<const std::vector<fs::dir_entry>> vfs::get_dir_cached(const std::string& path)
+{
+	auto& table = g_fxo->get<vfs_host_cache>();
+	const u64 gen = table.gen;
+
+	{
+		reader_lock lock(table.mutex);
+
+		if (const auto found = table.dir_cache.find(path); found != table.dir_cache.end())
+		{
+			return found->second;
+		}
+	}
+
+	// Failures are not cached, the caller handles them through fs::g_tls_error
+	fs::dir dir(path);
+
+	if (!dir)
+	{
+		return nullptr;
+	}
+
+	auto entries = std::make_shared<std::vector<fs::dir_entry>>();
+
+	for (fs::dir_entry entry; dir.read(entry);)
+	{
+		entries->push_back(std::move(entry));
+	}
+
+	std::lock_guard lock(table.mutex);
+
+	if (table.gen != gen)
+	{
+		// Invalidated while reading, the listing may be stale
+		return entries;
+	}
+
+	if (table.dir_cache.size() >= vfs_dir_cache_size)
+	{
+		table.dir_cache.clear();
+	}
+
+	table.dir_cache.emplace(path, entries);
+	table.has_entries = true;
+	return entries;
+}
+
+void vfs::invalidate_host_cache()
+{
+	if (!g_fxo->is_init<vfs_host_cache>())
+	{
+		return;
+	}
+
+	g_fxo->get<vfs_host_cache>().invalidate();
+}
+
 using char2 = char8_t;
 
 std::string vfs::retrieve(std::string_view path, const vfs_directory* node, std::vector<std::string_view>* mount_path, std::source_location src_loc)
@@ -946,6 +1108,8 @@ std::string vfs::host::hash_path(const std::string& path, const std::string& dev
 
 bool vfs::host::rename(const std::string& from, const std::string& to, const lv2_fs_mount_point* mp, bool overwrite, bool lock)
 {
+	const vfs::host_cache_guard cache_guard;
+
 	// Lock mount point, close file descriptors, retry
 	const auto from0 = std::string_view(from).substr(0, from.find_last_not_of(fs::delim) + 1);
 
@@ -1041,6 +1205,8 @@ bool vfs::host::rename(const std::string& from, const std::string& to, const lv2
 
 bool vfs::host::unlink(const std::string& path, [[maybe_unused]] const std::string& dev_root)
 {
+	const vfs::host_cache_guard cache_guard;
+
 #ifdef _WIN32
 	if (auto device = fs::get_virtual_device(path))
 	{
@@ -1085,6 +1251,8 @@ bool vfs::host::unlink(const std::string& path, [[maybe_unused]] const std::stri
 
 bool vfs::host::remove_all(const std::string& path, [[maybe_unused]] const std::string& dev_root, [[maybe_unused]] const lv2_fs_mount_point* mp, [[maybe_unused]] bool remove_root, [[maybe_unused]] bool lock, [[maybe_unused]] bool force_atomic)
 {
+	const vfs::host_cache_guard cache_guard;
+
 #ifndef _WIN32
 	if (!force_atomic)
 	{
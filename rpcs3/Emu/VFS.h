@@ -3,10 +3,17 @@
 #include <vector>
 #include <string>
 #include <string_view>
+#include <memory>
 
 struct lv2_fs_mount_point;
 struct vfs_directory;
 
+namespace fs
+{
+	struct stat_t;
+	struct dir_entry;
+}
+
 namespace vfs
 {
 	// Mount VFS device
@@ -18,6 +25,41 @@ namespace vfs
 	// Convert VFS path to fs path, optionally listing directories mounted in it
 	std::string get(std::string_view vpath, std::vector<std::string>* out_dir = nullptr, std::string* out_path = nullptr, std::source_location src_loc = std::source_location::current());
 
+	// fs::get_stat on a host path, cached until the next remount or invalidate_host_cache(). Only for read-only mounts.
+	bool get_stat_cached(const std::string& path, fs::stat_t& info);
+
+	// Host directory entries, cached the same way as get_stat_cached(). Returns nullptr on failure.
+	std::shared_ptr<const std::vector<fs::dir_entry>> get_dir_cached(const std::string& path);
+
+	// Drop cached stat results and directory listings, called when the guest modifies the file system
+	void invalidate_host_cache();
+
+	// Invalidates the host caches before and after a modification, so that lookups racing with it are not kept
+	struct host_cache_guard
+	{
+		const bool enabled;
+
+		host_cache_guard(bool enabled = true)
+			: enabled(enabled)
+		{
+			if (enabled)
+			{
+				invalidate_host_cache();
+			}
+		}
+
+		host_cache_guard(const host_cache_guard&) = delete;
+		host_cache_guard& operator=(const host_cache_guard&) = delete;
+
+		~host_cache_guard()
+		{
+			if (enabled)
+			{
+				invalidate_host_cache();
+			}
+		}
+	};
+
 	// Convert fs path to VFS path
 	std::string retrieve(std::string_view path, const vfs_directory* node = nullptr, std::vector<std::string_view>* mount_path = nullptr, std::source_location src_loc = std::source_location::current());
 
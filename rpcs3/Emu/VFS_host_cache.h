@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Utilities/File.h"
+#include "Utilities/mutex.h"
+
+#include <map>
+
+// Host lookups of read-only mounts, see vfs::get_stat_cached() and vfs::get_dir_cached()
+struct vfs_host_cache
+{
+	struct stat_result
+	{
+		fs::stat_t info{};
+		fs::error error{}; // Set if the path could not be stat'd
+	};
+
+	shared_mutex mutex{};
+	std::map<std::string, stat_result, std::less<>> stat_cache;
+	std::map<std::string, std::shared_ptr<const std::vector<fs::dir_entry>>, std::less<>> dir_cache;
+	atomic_t<bool> has_entries = false; // Set if stat_cache or dir_cache is not empty
+	atomic_t<u64> gen = 0; // Incremented on invalidation, lookups which started before it don't insert their result
+
+	void invalidate()
+	{
+		// Always bump the generation, a lookup in progress may be about to fill an empty cache
+		gen++;
+
+		if (!has_entries)
+		{
+			return;
+		}
+
+		std::lock_guard lock(mutex);
+		stat_cache.clear();
+		dir_cache.clear();
+		has_entries = false;
+	}
+};
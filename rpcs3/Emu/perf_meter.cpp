@@ -6,9 +6,13 @@
 #include "util/tsc.hpp"
 #include "Utilities/Thread.h"
 #include "Utilities/mutex.h"
+#include "Utilities/File.h"
+#include "Utilities/date_time.h"
+#include "Emu/System.h"
 
 #include <map>
 #include <mutex>
+#include <deque>
 
 void perf_stat_base::push(u64 ns[66]) noexcept
 {
@@ -155,3 +159,282 @@ void perf_stat_base::report() noexcept
 
 	perf_log.notice("Performance report end.");
 }
+
+void perf_stat_base::append_metrics(std::string& out) noexcept
+{
+	std::map<std::string_view, std::array<u64, 66>> stats;
+
+	{
+		reader_lock lock(s_perf_mutex);
+
+		for (auto& [name, data] : s_perf_acc)
+		{
+			auto& dst = stats[name];
+
+			for (u32 i = 0; i < 66; i++)
+			{
+				dst[i] += data.m_log[i].load();
+			}
+		}
+
+		for (auto& [name, ns] : s_perf_sources)
+		{
+			// Owned by another thread, only peek at it
+			auto& dst = stats[name];
+
+			for (u32 i = 0; i < 66; i++)
+			{
+				dst[i] += atomic_storage<u64>::load(ns[i]);
+			}
+		}
+	}
+
+	if (stats.empty())
+	{
+		return;
+	}
+
+	out += "# HELP rpcs3_perf_stat_seconds Event length histograms (requires \"Enable Performance Report\")\n";
+	out += "# TYPE rpcs3_perf_stat_seconds histogram\n";
+
+	for (const auto& [name, data] : stats)
+	{
+		// Slot 0 is the total, slot N counts events in [2^(N-1), 2^N) ns
+		const u64 total = data[0];
+		u64 count = total;
+
+		for (u32 i = 1; i < 65; i++)
+		{
+			count -= std::min(count, data[i]);
+		}
+
+		// Start from the zero-length events, which belong in every bucket
+		for (u32 i = 1; i < 65; i++)
+		{
+			count += data[i];
+
+			if (data[i])
+			{
+				fmt::append(out, "rpcs3_perf_stat_seconds_bucket{name=\"%s\",le=\"%.9g\"} %u\n", name, std::pow(2., i) / 1000'000'000., count);
+			}
+		}
+
+		fmt::append(out, "rpcs3_perf_stat_seconds_bucket{name=\"%s\",le=\"+Inf\"} %u\n", name, total);
+		fmt::append(out, "rpcs3_perf_stat_seconds_sum{name=\"%s\"} %.9f\n", name, data[65] / 1000'000'000.);
+		fmt::append(out, "rpcs3_perf_stat_seconds_count{name=\"%s\"} %u\n", name, total);
+	}
+}
+
+namespace
+{
+	struct perf_trace_event
+	{
+		u64 start;
+		u64 end;
+		const char* name;
+		u64 arg;
+	};
+
+	struct perf_trace_ring
+	{
+		static constexpr u64 size = 1 << 14;
+
+		// Single writer (the owning thread), head is published after each event is written
+		std::unique_ptr<perf_trace_event[]> events = std::make_unique<perf_trace_event[]>(size);
+		atomic_t<u64> head = 0;
+		atomic_t<bool> finished = false;
+		std::string name;
+		u64 tid = 0;
+	};
+}
+
+static shared_mutex s_trace_mutex;
+
+static std::deque<std::shared_ptr<perf_trace_ring>> s_trace_rings;
+
+static u64 s_trace_last_tid = 0;
+
+static thread_local struct perf_trace_local
+{
+	std::shared_ptr<perf_trace_ring> ring;
+
+	~perf_trace_local()
+	{
+		if (ring)
+		{
+			// Keep the events around for captures, the ring is dropped once enough threads have finished
+			ring->finished = true;
+		}
+	}
+} g_tls_perf_trace;
+
+void perf_trace::push(const char* name, u64 start_time, u64 end_time, u64 arg) noexcept
+{
+	auto& ring = g_tls_perf_trace.ring;
+
+	if (!ring) [[unlikely]]
+	{
+		ring = std::make_shared<perf_trace_ring>();
+		ring->name = thread_ctrl::get_current() ? thread_ctrl::get_name() : std::string("Host Thread");
+
+		std::lock_guard lock(s_trace_mutex);
+
+		ring->tid = ++s_trace_last_tid;
+
+		// Forget the oldest finished threads
+		usz finished = std::count_if(s_trace_rings.begin(), s_trace_rings.end(), [](const auto& r) { return r->finished.load(); });
+
+		for (auto it = s_trace_rings.begin(); finished > 64 && it != s_trace_rings.end();)
+		{
+			if ((*it)->finished)
+			{
+				it = s_trace_rings.erase(it);
+				finished--;
+			}
+			else
+			{
+				it++;
+			}
+		}
+
+		s_trace_rings.emplace_back(ring);
+	}
+
+	const u64 pos = ring->head.observe();
+	ring->events[pos % perf_trace_ring::size] = {start_time, end_time, name, arg};
+	ring->head.release(pos + 1);
+}
+
+static void append_json_string(std::string& out, std::string_view str)
+{
+	out += '"';
+
+	for (char c : str)
+	{
+		if (c == '"' || c == '\\')
+		{
+			out += '\\';
+			out += c;
+		}
+		else if (static_cast<u8>(c) < 0x20)
+		{
+			fmt::append(out, "\\u%04x", static_cast<u8>(c));
+		}
+		else
+		{
+			out += c;
+		}
+	}
+
+	out += '"';
+}
+
+std::string perf_trace::capture(f64 seconds) noexcept
+{
+	const f64 freq = static_cast<f64>(utils::get_tsc_freq());
+	const u64 now = utils::get_tsc();
+	const u64 window = seconds > 0 ? static_cast<u64>(seconds * freq) : umax;
+	const u64 since = now > window ? now - window : 0;
+
+	std::vector<std::shared_ptr<perf_trace_ring>> rings;
+	{
+		reader_lock lock(s_trace_mutex);
+		rings.assign(s_trace_rings.begin(), s_trace_rings.end());
+	}
+
+	std::vector<std::pair<const perf_trace_ring*, std::vector<perf_trace_event>>> threads;
+	u64 base = umax;
+	usz count = 0;
+
+	for (const auto& ring : rings)
+	{
+		const u64 head = ring->head.load();
+		const u64 first = head > perf_trace_ring::size ? head - perf_trace_ring::size : 0;
+
+		std::vector<perf_trace_event> events;
+		events.reserve(head - first);
+
+		for (u64 i = first; i < head; i++)
+		{
+			events.emplace_back(ring->events[i % perf_trace_ring::size]);
+		}
+
+		// Drop the entries the owning thread may have overwritten while they were copied
+		atomic_fence_acquire();
+		const u64 head2 = ring->head.load();
+		const u64 valid = head2 >= perf_trace_ring::size ? head2 - perf_trace_ring::size + 1 : 0;
+
+		if (valid > first)
+		{
+			events.erase(events.begin(), events.begin() + std::min<u64>(valid - first, events.size()));
+		}
+
+		std::erase_if(events, [&](const perf_trace_event& e) { return e.end < since; });
+
+		for (const auto& e : events)
+		{
+			base = std::min(base, e.start);
+		}
+
+		count += events.size();
+		threads.emplace_back(ring.get(), std::move(events));
+	}
+
+	if (!count)
+	{
+		perf_log.warning("Timeline trace is empty. Is \"Enable Timeline Tracing\" enabled?");
+		return {};
+	}
+
+	// Chrome trace event format, timestamps in microseconds
+	std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+	for (const auto& [ring, events] : threads)
+	{
+		if (events.empty())
+		{
+			continue;
+		}
+
+		fmt::append(json, "{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":", ring->tid);
+		append_json_string(json, ring->name);
+		json += "}},\n";
+
+		for (const auto& e : events)
+		{
+			json += "{\"ph\":\"X\",\"pid\":1,";
+			fmt::append(json, "\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"name\":", ring->tid, (e.start - base) * 1000'000. / freq, (std::max(e.end, e.start) - e.start) * 1000'000. / freq);
+			append_json_string(json, e.name);
+			fmt::append(json, ",\"args\":{\"arg\":%u}},\n", e.arg);
+		}
+	}
+
+	// Remove trailing comma
+	json.resize(json.size() - 2);
+	json += "\n]}\n";
+
+	const std::string dir = fs::get_config_dir() + "traces/";
+	const std::string file_path = dir + (Emu.GetTitleID().empty() ? std::string("trace") : Emu.GetTitleID()) + "_" + date_time::current_time_narrow() + ".json";
+
+	if (!fs::create_path(dir))
+	{
+		perf_log.error("Failed to create directory: %s (%s)", dir, fs::g_tls_error);
+		return {};
+	}
+
+	fs::pending_file temp(file_path);
+
+	if (temp.file)
+	{
+		temp.file.write(json);
+	}
+
+	if (!temp.file || !temp.commit())
+	{
+		perf_log.error("Failed to save timeline trace: %s (%s)", file_path, fs::g_tls_error);
+		return {};
+	}
+
+	perf_log.success("Timeline trace saved: %s (%u events, %u threads)", file_path, count, threads.size());
+	return file_path;
+}
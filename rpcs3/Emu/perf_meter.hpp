@@ -50,6 +50,9 @@ public:
 
 	// Collect all data, report it, and clean
 	static void report() noexcept;
+
+	// Append current data as Prometheus histograms without clearing it
+	static void append_metrics(std::string& out) noexcept;
 };
 
 // Object that prints event length stats at the end
@@ -191,3 +194,45 @@ public:
 		// TODO: handle push(), currently ignored
 	}
 };
+
+// Timeline of scoped events from all threads, kept in per-thread rings and exported as a Chrome trace on demand
+class perf_trace
+{
+public:
+	// Record a finished event for the current thread. Name must be a string literal or otherwise outlive the emulator.
+	static void push(const char* name, u64 start_time, u64 end_time, u64 arg = 0) noexcept;
+
+	// Write the events of the last given number of seconds (0 = everything recorded) to a trace file and return its path
+	static std::string capture(f64 seconds) noexcept;
+};
+
+// Object that records its lifetime on the timeline
+class perf_span
+{
+	const char* m_name;
+	u64 m_arg;
+	u64 m_start = 0;
+
+public:
+	FORCE_INLINE SAFE_BUFFERS() perf_span(const char* name, u64 arg = 0) noexcept
+		: m_name(name)
+		, m_arg(arg)
+	{
+		if (g_cfg.core.perf_trace) [[unlikely]]
+		{
+			m_start = utils::get_tsc();
+		}
+	}
+
+	perf_span(const perf_span&) = delete;
+
+	perf_span& operator =(const perf_span&) = delete;
+
+	FORCE_INLINE SAFE_BUFFERS() ~perf_span()
+	{
+		if (m_start) [[unlikely]]
+		{
+			perf_trace::push(m_name, m_start, utils::get_tsc(), m_arg);
+		}
+	}
+};
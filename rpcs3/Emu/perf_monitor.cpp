@@ -2,12 +2,226 @@
 #include "perf_monitor.hpp"
 
 #include "Emu/System.h"
+#include "Emu/IdManager.h"
+#include "Emu/perf_meter.hpp"
 #include "Emu/Cell/timers.hpp"
+#include "Emu/Cell/PPUThread.h"
+#include "Emu/Cell/SPUThread.h"
+#include "Emu/RSX/RSXThread.h"
 #include "util/cpu_stats.hpp"
 #include "util/sysinfo.hpp"
 #include "Utilities/Thread.h"
+#include "Utilities/File.h"
+#include "Utilities/mutex.h"
 
-LOG_CHANNEL(perf_log, "PERF");
+#include <algorithm>
+#include <array>
+#include <unordered_map>
+
+// Host timestamps of the last presented frames, written by the RSX thread only
+static std::array<atomic_t<u64>, 1024> s_frame_times{};
+static atomic_t<u64> s_frame_count = 0;
+
+static shared_mutex s_metrics_mutex;
+static perf_metrics s_metrics;
+
+void perf_monitor::push_frame(u64 timestamp) noexcept
+{
+	const u64 index = s_frame_count.observe();
+	s_frame_times[index % s_frame_times.size()].release(timestamp);
+	s_frame_count.release(index + 1);
+}
+
+perf_metrics perf_monitor::get_metrics()
+{
+	reader_lock lock(s_metrics_mutex);
+	return s_metrics;
+}
+
+static void append_label(std::string& out, std::string_view value)
+{
+	for (char c : value)
+	{
+		switch (c)
+		{
+		case '\\': out += "\\\\"; break;
+		case '"': out += "\\\""; break;
+		case '\n': out += "\\n"; break;
+		default: out += c; break;
+		}
+	}
+}
+
+std::string perf_monitor::get_metrics_text()
+{
+	const perf_metrics m = get_metrics();
+
+	std::string out;
+
+	const auto gauge = [&](std::string_view name, std::string_view help, const auto& value)
+	{
+		fmt::append(out, "# HELP rpcs3_%s %s\n# TYPE rpcs3_%s gauge\nrpcs3_%s %s\n", name, help, name, name, value);
+	};
+
+	gauge("sample_time_seconds", "Host time of the last sample, 0 if nothing was sampled yet", fmt::format("%.3f", m.timestamp / 1000'000.));
+	gauge("fps", "Guest frames presented per second", fmt::format("%.2f", m.fps));
+
+	out += "# HELP rpcs3_frames_total Guest frames presented since boot\n# TYPE rpcs3_frames_total counter\n";
+	fmt::append(out, "rpcs3_frames_total %u\n", m.frames);
+
+	out += "# HELP rpcs3_frame_time_seconds Frame time percentiles over the last sample interval\n# TYPE rpcs3_frame_time_seconds gauge\n";
+	fmt::append(out, "rpcs3_frame_time_seconds{percentile=\"50\"} %.6f\n", m.frame_time_p50 / 1000.);
+	fmt::append(out, "rpcs3_frame_time_seconds{percentile=\"90\"} %.6f\n", m.frame_time_p90 / 1000.);
+	fmt::append(out, "rpcs3_frame_time_seconds{percentile=\"99\"} %.6f\n", m.frame_time_p99 / 1000.);
+	fmt::append(out, "rpcs3_frame_time_seconds{percentile=\"100\"} %.6f\n", m.frame_time_max / 1000.);
+
+	gauge("cpu_usage_percent", "Process CPU usage", fmt::format("%.1f", m.cpu_usage));
+
+	out += "# HELP rpcs3_core_usage_percent Host CPU usage per core\n# TYPE rpcs3_core_usage_percent gauge\n";
+	for (usz i = 0; i < m.core_usage.size(); i++)
+	{
+		fmt::append(out, "rpcs3_core_usage_percent{core=\"%u\"} %.1f\n", i, m.core_usage[i]);
+	}
+
+	out += "# HELP rpcs3_unit_usage_percent Share of the process CPU usage per emulated unit\n# TYPE rpcs3_unit_usage_percent gauge\n";
+	fmt::append(out, "rpcs3_unit_usage_percent{unit=\"ppu\"} %.1f\n", m.ppu_usage);
+	fmt::append(out, "rpcs3_unit_usage_percent{unit=\"spu\"} %.1f\n", m.spu_usage);
+	fmt::append(out, "rpcs3_unit_usage_percent{unit=\"rsx\"} %.1f\n", m.rsx_usage);
+
+	out += "# HELP rpcs3_unit_threads Emulated threads per unit\n# TYPE rpcs3_unit_threads gauge\n";
+	fmt::append(out, "rpcs3_unit_threads{unit=\"ppu\"} %u\n", m.ppu_threads);
+	fmt::append(out, "rpcs3_unit_threads{unit=\"spu\"} %u\n", m.spu_threads);
+
+	out += "# HELP rpcs3_thread_usage_percent Share of the process CPU usage per emulated thread\n# TYPE rpcs3_thread_usage_percent gauge\n";
+	for (const auto& thread : m.threads)
+	{
+		out += "rpcs3_thread_usage_percent{thread=\"";
+		append_label(out, thread.name);
+		fmt::append(out, "\"} %.1f\n", thread.usage);
+	}
+
+	gauge("rsx_load_percent", "RSX FIFO busy time", m.rsx_load);
+	gauge("host_threads", "Host threads in the process", m.thread_count);
+	gauge("memory_usage_bytes", "Process memory usage", m.memory_usage);
+
+	perf_stat_base::append_metrics(out);
+	return out;
+}
+
+// Sample everything not needed for the log message
+static void update_metrics(perf_metrics& m, std::unordered_map<u64, u64>& last_cpu_time, u64& last_frame_count, u64& last_frame_time, utils::cpu_stats& stats)
+{
+	const u64 now = get_system_time();
+	const u64 interval = m.timestamp ? now - m.timestamp : 0;
+	m.timestamp = now;
+
+	// Frame times since the last sample
+	const u64 frame_count = s_frame_count.load();
+	const u64 first = std::max<u64>(last_frame_count, frame_count > s_frame_times.size() ? frame_count - s_frame_times.size() : 0);
+
+	std::vector<f64> frame_times;
+
+	for (u64 i = first; i < frame_count; i++)
+	{
+		const u64 time = s_frame_times[i % s_frame_times.size()].load();
+
+		if (last_frame_time && time > last_frame_time)
+		{
+			frame_times.push_back((time - last_frame_time) / 1000.);
+		}
+
+		last_frame_time = time;
+	}
+
+	m.fps = interval ? (frame_count - last_frame_count) * 1000'000. / interval : 0;
+	m.frames = frame_count;
+	last_frame_count = frame_count;
+
+	std::sort(frame_times.begin(), frame_times.end());
+
+	const auto percentile = [&](f64 p)
+	{
+		return frame_times.empty() ? 0. : frame_times[std::min<usz>(frame_times.size() - 1, static_cast<usz>(p * frame_times.size()))];
+	};
+
+	m.frame_time_p50 = percentile(0.5);
+	m.frame_time_p90 = percentile(0.9);
+	m.frame_time_p99 = percentile(0.99);
+	m.frame_time_max = frame_times.empty() ? 0. : frame_times.back();
+
+	// Per thread CPU time deltas, weighted like the performance overlay
+	struct sample
+	{
+		std::string name;
+		u64 delta;
+		u32 unit;
+	};
+
+	std::vector<sample> samples;
+	std::unordered_map<u64, u64> cpu_time;
+
+	const auto add_sample = [&](u64 key, std::string name, u64 time, u32 unit)
+	{
+		cpu_time[key] = time;
+
+		const auto found = last_cpu_time.find(key);
+		samples.push_back({std::move(name), found != last_cpu_time.end() && time > found->second ? time - found->second : 0, unit});
+	};
+
+	if (g_fxo->is_init<id_manager::id_map<named_thread<ppu_thread>>>())
+	{
+		m.ppu_threads = idm::select<named_thread<ppu_thread>>([&](u32 id, named_thread<ppu_thread>& ppu)
+		{
+			add_sample(id, ppu.get_name(), thread_ctrl::get_cpu_time(ppu), 0);
+		});
+	}
+
+	if (g_fxo->is_init<id_manager::id_map<named_thread<spu_thread>>>())
+	{
+		m.spu_threads = idm::select<named_thread<spu_thread>>([&](u32 id, named_thread<spu_thread>& spu)
+		{
+			add_sample(u64{1} << 32 | id, spu.get_name(), thread_ctrl::get_cpu_time(spu), 1);
+		});
+	}
+
+	if (auto rsx = g_fxo->try_get<rsx::thread>())
+	{
+		add_sample(u64{2} << 32, "RSX", rsx->get_cpu_time(), 2);
+		m.rsx_load = rsx->get_load();
+	}
+
+	last_cpu_time = std::move(cpu_time);
+
+	u64 total = 0;
+	u64 unit_total[3]{};
+
+	for (const auto& s : samples)
+	{
+		total += s.delta;
+		unit_total[s.unit] += s.delta;
+	}
+
+	m.cpu_usage = stats.get_usage();
+	total = std::max<u64>(total, 1);
+
+	const auto share = [&](u64 delta)
+	{
+		return std::clamp(m.cpu_usage * delta / total, 0., 100.);
+	};
+
+	m.ppu_usage = share(unit_total[0]);
+	m.spu_usage = share(unit_total[1]);
+	m.rsx_usage = share(unit_total[2]);
+
+	m.threads.clear();
+
+	for (auto& s : samples)
+	{
+		m.threads.push_back({std::move(s.name), share(s.delta)});
+	}
+
+	m.thread_count = utils::cpu_stats::get_current_thread_count();
+}
 
 void perf_monitor::operator()()
 {
@@ -28,6 +242,12 @@ void perf_monitor::operator()()
 	std::vector<double> per_core_usage;
 	std::string msg;
 
+	perf_metrics metrics;
+	std::unordered_map<u64, u64> last_cpu_time;
+	u64 last_frame_count = s_frame_count.load();
+	u64 last_frame_time = 0;
+	utils::cpu_stats process_stats;
+
 	for (u64 sleep_until = get_system_time();;)
 	{
 		thread_ctrl::wait_until(&sleep_until, update_interval_us);
@@ -38,6 +258,27 @@ void perf_monitor::operator()()
 		stats.get_per_core_usage(per_core_usage, total_usage);
 
 		const u64 current_mem_use = utils::get_memory_usage().second;
+
+		update_metrics(metrics, last_cpu_time, last_frame_count, last_frame_time, process_stats);
+		metrics.core_usage = per_core_usage;
+		metrics.memory_usage = current_mem_use;
+
+		{
+			std::lock_guard lock(s_metrics_mutex);
+			s_metrics = metrics;
+		}
+
+		if (g_cfg.core.perf_metrics_file)
+		{
+			// For file based collectors like the node exporter textfile collector
+			fs::pending_file file(fs::get_log_dir() + "rpcs3_metrics.prom");
+
+			if (file.file)
+			{
+				file.file.write(get_metrics_text());
+				file.commit();
+			}
+		}
 		const u64 mem_use_increase = current_mem_use >= max_memory_usage ? current_mem_use - max_memory_usage : 0;
 
 		const u64 log_interval = (mem_use_increase >= log_mem_increase ? log_interval_us_min : log_interval_us_max);
@@ -1,12 +1,55 @@
 #pragma once
 
+#include "util/types.hpp"
+
+#include <string>
 #include <string_view>
+#include <vector>
 using namespace std::literals;
 
+// Values sampled by the performance sensor thread
+struct perf_metrics
+{
+	u64 timestamp = 0;       // Host time of the sample in µs, 0 before the first one
+	u64 frames = 0;          // Guest frames presented since boot
+	f64 fps = 0;
+	f64 frame_time_p50 = 0;  // In ms, over the last update interval
+	f64 frame_time_p90 = 0;
+	f64 frame_time_p99 = 0;
+	f64 frame_time_max = 0;
+	f64 cpu_usage = 0;       // Whole process, in percent
+	f64 ppu_usage = 0;       // Share of the process usage, like the performance overlay
+	f64 spu_usage = 0;
+	f64 rsx_usage = 0;
+	u32 ppu_threads = 0;
+	u32 spu_threads = 0;
+	u32 rsx_load = 0;        // Percent of time the RSX FIFO was busy
+	u32 thread_count = 0;
+	u64 memory_usage = 0;    // In bytes
+	std::vector<f64> core_usage;
+
+	struct thread_usage
+	{
+		std::string name;
+		f64 usage;
+	};
+
+	std::vector<thread_usage> threads; // Emulated threads
+};
+
 struct perf_monitor
 {
 	void operator()();
 	~perf_monitor();
 
+	// Record the host time of a presented guest frame (RSX thread only)
+	static void push_frame(u64 timestamp) noexcept;
+
+	// Get the last sample
+	static perf_metrics get_metrics();
+
+	// Format the last sample and the perf_stat histograms as Prometheus text
+	static std::string get_metrics_text();
+
 	static constexpr auto thread_name = "Performance Sensor"sv;
 };
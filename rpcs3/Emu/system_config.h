@@ -54,8 +54,10 @@ struct cfg_root : cfg::node
 		};
 
 		fifo_setting rsx_fifo_accuracy{this, "RSX FIFO Fetch Accuracy", rsx_fifo_mode::atomic };
+		cfg::_bool rsx_fifo_predecoder{ this, "RSX FIFO Pre-decoder", false }; // Only used with fast FIFO fetch accuracy
 		cfg::_bool spu_verification{ this, "SPU Verification", true }; // Should be enabled
 		cfg::_bool spu_cache{ this, "SPU Cache", true };
+		cfg::_bool self_cache{ this, "Decrypted SELF Cache", true }; // Keep decrypted executables and modules in the cache directory
 		cfg::_bool spu_prof{ this, "SPU Profiler", false };
 		cfg::_bool ppu_prof{ this, "PPU Profiler", false };
 		cfg::uint<0, 16> mfc_transfers_shuffling{ this, "MFC Commands Shuffling Limit", 0 };
@@ -93,6 +95,9 @@ struct cfg_root : cfg::node
 
 		cfg::uint64 perf_report_threshold{this, "Performance Report Threshold", 500, true}; // In µs, 0.5ms = default, 0 = everything
 		cfg::_bool perf_report{this, "Enable Performance Report", false, true}; // Show certain perf-related logs
+		cfg::_bool perf_trace{this, "Enable Timeline Tracing", false, true}; // Record scoped events for trace captures
+		cfg::uint<1, 600> perf_trace_capture_length{this, "Timeline Trace Capture Length", 10, true}; // In seconds
+		cfg::_bool perf_metrics_file{this, "Write Performance Metrics File", false, true}; // Prometheus text in the log directory
 		cfg::_bool external_debugger{this, "Assume External Debugger"};
 	} core{ this };
 
@@ -153,8 +158,10 @@ struct cfg_root : cfg::node
 		cfg::_bool disable_vulkan_mem_allocator{ this, "Disable Vulkan Memory Allocator", false };
 		cfg::_bool full_rgb_range_output{ this, "Use full RGB output range", true, true }; // Video out dynamic range
 		cfg::_bool strict_texture_flushing{ this, "Strict Texture Flushing", false };
+		cfg::_bool reuse_unchanged_textures{ this, "Reuse Unchanged Textures", false };
 		cfg::_bool multithreaded_rsx{ this, "Multithreaded RSX", false };
 		cfg::_bool relaxed_zcull_sync{ this, "Relaxed ZCULL Sync", false };
+		cfg::_bool batch_zcull_queries{ this, "Batch ZCULL Query Readback", true };
 		cfg::_bool force_hw_MSAA_resolve{ this, "Force Hardware MSAA Resolve", false, true };
 		cfg::_bool stereo_enabled{ this, "3D Display Enabled", false };
 		cfg::_enum<stereo_render_mode_options> stereo_render_mode{ this, "3D Display Mode", stereo_render_mode_options::disabled, true };
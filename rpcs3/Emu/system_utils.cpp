@@ -321,6 +321,12 @@ namespace rpcs3::utils
 		return get_cache_dir() + (serial == "vsh.self" ? "vsh" : serial);
 	}
 
+	std::string get_self_cache_dir()
+	{
+		// Decrypted executables, shared by all titles
+		return get_cache_dir() + "self/";
+	}
+
 	std::string get_data_dir(const std::string& serial)
 	{
 		return get_data_dir() + serial;
@@ -65,6 +65,7 @@ namespace rpcs3::utils
 
 	// get_cache_dir_by_serial() named in this way to avoid conflict (wrong invocation) with get_cache_dir()
 	std::string get_cache_dir_by_serial(const std::string& serial);
+	std::string get_self_cache_dir();
 	std::string get_data_dir(const std::string& serial);
 	std::string get_icons_dir(const std::string& serial);
 	std::string get_savestates_dir(const std::string& serial);
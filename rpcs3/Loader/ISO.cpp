@@ -1,11 +1,15 @@
 #include "stdafx.h"
 
 #include "ISO.h"
+#include "iso_cache.h"
+#include "iso_compressed.h"
 #include "Emu/VFS.h"
 #include "Emu/system_utils.hpp"
 #include "Emu/System.h"
 #include "Crypto/utils.h"
 
+#include "util/asm.hpp"
+
 #include <codecvt>
 #include <algorithm>
 #include <cmath>
@@ -17,43 +21,30 @@
 LOG_CHANNEL(sys_log, "SYS");
 LOG_CHANNEL(iso_log, "ISO");
 
-struct iso_sector
-{
-	u64 lba_address;
-	u64 offset;
-	u64 size;
-	u64 address_aligned;
-	u64 offset_aligned;
-	u64 size_aligned;
-};
-
-static void* get_aligned_buf()
+static u8* alloc_aligned_buf(u64 size)
 {
-	static thread_local struct aligned_buf
-	{
-		void* buf;
-
-		aligned_buf() noexcept
-		{
-			// IMPORTANT NOTE: It must be aligned (probably enough on multiple of 4) to support raw device, otherwise any read from file will fail
+	// IMPORTANT NOTE: It must be aligned (probably enough on multiple of 4) to support raw device, otherwise any read from file will fail
 #if defined(_WIN32)
-			buf = _aligned_malloc(ISO_SECTOR_SIZE, ISO_SECTOR_SIZE * 2);
+	return static_cast<u8*>(_aligned_malloc(size, ISO_SECTOR_SIZE * 2));
 #else
-			buf = std::aligned_alloc(ISO_SECTOR_SIZE * 2, ISO_SECTOR_SIZE);
+	return static_cast<u8*>(std::aligned_alloc(ISO_SECTOR_SIZE * 2, size));
 #endif
-		}
+}
 
-		~aligned_buf() noexcept
-		{
+void iso_aligned_buffer_deleter::operator()(u8* ptr) const
+{
 #if defined(_WIN32)
-			_aligned_free(buf);
+	_aligned_free(ptr);
 #else
-			std::free(buf);
+	std::free(ptr);
 #endif
-		}
-	} s_aligned_buf {};
+}
 
-	return ensure(s_aligned_buf.buf);
+static u8* get_aligned_buf()
+{
+	static thread_local const std::unique_ptr<u8[], iso_aligned_buffer_deleter> s_aligned_buf{alloc_aligned_buf(ISO_BOUNCE_BUFFER_SIZE)};
+
+	return ensure(s_aligned_buf.get());
 }
 
 static bool is_iso_file(iso_file& file, u64* size = nullptr)
@@ -610,173 +601,12 @@ bool iso_file_decryption::decrypt(u64 offset, const std::span<u8> buffer, const
 iso_file_encrypted::iso_file_encrypted(const std::string& path, bs_t<fs::open_mode> mode, const iso_fs_node& node, std::shared_ptr<iso_file_decryption> dec)
 	: iso_file(path, mode, node), m_dec(dec)
 {
+	m_process_sectors = true;
 }
 
-u64 iso_file_encrypted::read_at(u64 offset, void* buffer, u64 size)
+void iso_file_encrypted::process_sectors(u64 address, std::span<u8> data)
 {
-	// IMPORTANT NOTES:
-	// - For a raw device, we must use a support buffer aligned (probably enough on multiple of 4), otherwise any read from file will fail.
-	//   For that reason, we don't use directly "buffer" (not guaranteeing any alignment)
-	// - "iso_file_decryption::decrypt()" method requires that offset and size are multiple of 16 bytes (ciphertext block's size)
-	//   and that a previous ciphertext block (used as IV) is read in case offset is not a multiple of ISO_SECTOR_SIZE
-	//
-	//                                                ----------------------------------------------------------------------
-	//                           file on ISO archive: |     '                                           '                  |
-	//                                                ----------------------------------------------------------------------
-	//                                                      '                                           '
-	//                                                      ---------------------------------------------
-	//                                              buffer: |                                           |
-	//                                                      ---------------------------------------------
-	//                                                      '     '                                   ' '
-	//                        -------------------------------------------------------------------------------------------------------------------------------------
-	//           ISO archive: | sec 0     | sec 1     |xxxxx######'###########'###########'###########'##xxxxxxxxx|           | ...       | sec n-1   | sec n     |
-	//                        -------------------------------------------------------------------------------------------------------------------------------------
-	// 16 Bytes x block read: |   |   |   |   |   |   |   '#######'###########'###########'###########'###|   |   |   |   |   |   |   |   |   |   |   |   |   |   |
-	//                                                '           '                                   '           '
-	//                                                | first sec |           inner sec(s)            | last sec  |
-
-	u64 max_size = std::min(size, local_extent_remaining(offset));
-
-	if (max_size == 0)
-	{
-		return 0;
-	}
-
-	const u64 total_size = this->size();
-	const u64 archive_first_offset = file_offset(offset);
-	const u64 archive_last_offset = archive_first_offset + max_size - 1;
-	void* aligned_buf = get_aligned_buf(); // thread-safe buffer
-
-	iso_sector first_sec {};
-	first_sec.lba_address = (archive_first_offset / ISO_SECTOR_SIZE) * ISO_SECTOR_SIZE;
-	first_sec.offset = archive_first_offset % ISO_SECTOR_SIZE;
-	first_sec.size = first_sec.offset + max_size <= ISO_SECTOR_SIZE ? max_size : ISO_SECTOR_SIZE - first_sec.offset;
-
-	iso_sector last_sec {};
-	last_sec.lba_address = last_sec.address_aligned = (archive_last_offset / ISO_SECTOR_SIZE) * ISO_SECTOR_SIZE;
-	// last_sec.offset = last_sec.offset_aligned = 0; // Always 0 so no need to set and use those attributes
-	last_sec.size = (archive_last_offset % ISO_SECTOR_SIZE) + 1;
-
-	//
-	// First sector
-	//
-
-	u64 offset_aligned_first_out = 0;
-
-	if (!m_raw_device)
-	{
-		const u64 offset_aligned = first_sec.offset & ~0xF;
-		offset_aligned_first_out = (first_sec.offset + first_sec.size) & ~0xF;
-
-		first_sec.offset_aligned = offset_aligned != 0 ? offset_aligned - 16 : 0; // Eventually include the previous block (used as IV)
-		first_sec.size_aligned = offset_aligned_first_out != (first_sec.offset + first_sec.size) ?
-			offset_aligned_first_out + 16 - first_sec.offset_aligned :
-			offset_aligned_first_out - first_sec.offset_aligned;
-		first_sec.address_aligned = first_sec.lba_address + first_sec.offset_aligned;
-	}
-	else
-	{
-		first_sec.offset_aligned = 0;
-		first_sec.size_aligned = ISO_SECTOR_SIZE;
-		first_sec.address_aligned = first_sec.lba_address;
-	}
-
-	u64 total_read = m_file.read_at(first_sec.address_aligned, &reinterpret_cast<u8*>(aligned_buf)[first_sec.offset_aligned], first_sec.size_aligned);
-
-	m_dec->decrypt(first_sec.address_aligned, {&reinterpret_cast<u8*>(aligned_buf)[first_sec.offset_aligned], first_sec.size_aligned}, m_meta.name);
-	std::memcpy(buffer, &reinterpret_cast<u8*>(aligned_buf)[first_sec.offset], first_sec.size);
-
-	const u64 sector_count = (last_sec.lba_address - first_sec.lba_address) / ISO_SECTOR_SIZE + 1;
-
-	if (sector_count < 2) // If no more sector(s)
-	{
-		if (total_read != first_sec.size_aligned)
-		{
-			iso_log.error("read_at: %s: Error reading from file - O: %llu (%llu), S: %llu/%llu/%llu (%llu), TR: %llu", m_meta.name,
-				offset, first_sec.address_aligned, first_sec.size_aligned, max_size, size, total_size, total_read);
-
-			return 0;
-		}
-
-		// If present, read the remaining chunk of data on next extent
-		if (size > max_size && (offset + max_size) < total_size)
-		{
-			iso_log.warning("read_at: %s: Extent limit reached reading from file (%llu/%llu)", m_meta.name, max_size, size);
-			max_size += read_at(offset + max_size, &reinterpret_cast<u8*>(buffer)[max_size], size - max_size);
-		}
-
-		return max_size;
-	}
-
-	//
-	// Inner sector(s), if any
-	//
-
-	if (sector_count > 2) // If inner sector(s) are present
-	{
-		if (!m_raw_device)
-		{
-			const u64 inner_sector_size = (sector_count - 2) * ISO_SECTOR_SIZE;
-
-			total_read += m_file.read_at(first_sec.lba_address + ISO_SECTOR_SIZE, &reinterpret_cast<u8*>(buffer)[first_sec.size], inner_sector_size);
-
-			m_dec->decrypt(first_sec.lba_address + ISO_SECTOR_SIZE, {&reinterpret_cast<u8*>(buffer)[first_sec.size], inner_sector_size}, m_meta.name);
-		}
-		else
-		{
-			u64 inner_sector_offset = 0;
-
-			for (u64 i = 0; i < sector_count - 2; i++, inner_sector_offset += ISO_SECTOR_SIZE)
-			{
-				total_read += m_file.read_at(first_sec.lba_address + ISO_SECTOR_SIZE + inner_sector_offset, aligned_buf, ISO_SECTOR_SIZE);
-
-				m_dec->decrypt(first_sec.lba_address + ISO_SECTOR_SIZE + inner_sector_offset, {reinterpret_cast<u8*>(aligned_buf), ISO_SECTOR_SIZE}, m_meta.name);
-				std::memcpy(&reinterpret_cast<u8*>(buffer)[first_sec.size + inner_sector_offset], aligned_buf, ISO_SECTOR_SIZE);
-			}
-		}
-	}
-
-	//
-	// Last sector
-	//
-
-	if (!m_raw_device)
-	{
-		offset_aligned_first_out = last_sec.size & ~0xF;
-
-		last_sec.size_aligned = offset_aligned_first_out != last_sec.size ? offset_aligned_first_out + 16 : offset_aligned_first_out;
-	}
-	else
-	{
-		last_sec.size_aligned = ISO_SECTOR_SIZE;
-	}
-
-	total_read += m_file.read_at(last_sec.address_aligned, aligned_buf, last_sec.size_aligned);
-
-	m_dec->decrypt(last_sec.address_aligned, {reinterpret_cast<u8*>(aligned_buf), last_sec.size_aligned}, m_meta.name);
-	std::memcpy(&reinterpret_cast<u8*>(buffer)[max_size - last_sec.size], aligned_buf, last_sec.size);
-
-	//
-	// As last, check for an unlikely reading error (decoding also failed due to use of partially initialized buffer)
-	//
-
-	if (total_read != first_sec.size_aligned + last_sec.size_aligned + (sector_count - 2) * ISO_SECTOR_SIZE)
-	{
-		iso_log.error("read_at: %s: Error reading from file - O: %llu (%llu), S: %llu/%llu/%llu (%llu), TR: %llu/%llu", m_meta.name,
-			offset, first_sec.address_aligned, last_sec.size_aligned, max_size, size, total_size,
-			total_read, ISO_SECTOR_SIZE + ISO_SECTOR_SIZE + (sector_count - 2) * ISO_SECTOR_SIZE);
-
-		return 0;
-	}
-
-	// If present, read the remaining chunk of data on next extent
-	if (size > max_size && (offset + max_size) < total_size)
-	{
-		iso_log.warning("read_at: %s: Extent limit reached reading from file (%llu/%llu)", m_meta.name, max_size, size);
-		max_size += read_at(offset + max_size, &reinterpret_cast<u8*>(buffer)[max_size], size - max_size);
-	}
-
-	return max_size;
+	m_dec->decrypt(address, data, m_meta.name);
 }
 
 template<typename T>
@@ -1013,21 +843,10 @@ u64 iso_fs_metadata::size() const
 	return total_size;
 }
 
-iso_archive::iso_archive(const std::string& path)
+// Parses the volume descriptors and the whole directory record hierarchy of the image
+static bool iso_read_hierarchy(const std::string& iso_path, const std::string& path, iso_fs_node& root)
 {
-	m_path = path;
-
-	// "m_path" is updated with the raw device path in case "path" points to a BD drive
-	fs::get_optical_raw_device(path, &m_path);
-
-	if (!is_iso_file(m_path))
-	{
-		iso_log.error("iso_archive: Failed to recognize ISO file: '%s'", path);
-		invalidate();
-		return;
-	}
-
-	fs::file iso_file(std::make_unique<iso_file>(m_path));
+	fs::file iso_file(std::make_unique<iso_file>(iso_path));
 
 	u8 descriptor_type = -2;
 	bool use_ucs2_decoding = false;
@@ -1050,7 +869,7 @@ iso_archive::iso_archive(const std::string& path)
 
 			if (node)
 			{
-				m_root = iso_fs_node
+				root = iso_fs_node
 				{
 					.metadata = node.value()
 				};
@@ -1064,17 +883,53 @@ iso_archive::iso_archive(const std::string& path)
 	if (descriptor_type != 255)
 	{
 		iso_log.error("iso_archive: Corrupt ISO file '%s': Volume Descriptor Set Terminator not found", path);
-		invalidate();
-		return;
+		return false;
 	}
 
-	if (!iso_form_hierarchy(iso_file, m_root, use_ucs2_decoding))
+	if (!iso_form_hierarchy(iso_file, root, use_ucs2_decoding))
 	{
 		iso_log.error("iso_archive: Corrupt ISO file '%s': Failed to form hierarchy", path);
+		return false;
+	}
+
+	return true;
+}
+
+iso_archive::iso_archive(const std::string& path)
+{
+	m_path = path;
+
+	// "m_path" is updated with the raw device path in case "path" points to a BD drive
+	fs::get_optical_raw_device(path, &m_path);
+
+	if (!is_iso_file(m_path))
+	{
+		iso_log.error("iso_archive: Failed to recognize ISO file: '%s'", path);
 		invalidate();
 		return;
 	}
 
+	// Raw devices have no stable mtime to validate the cached tree against
+	const bool use_tree_cache = m_path == path;
+
+	if (use_tree_cache && iso_cache::load_tree(m_path, m_root))
+	{
+		iso_log.notice("iso_archive: Loaded directory tree of '%s' from cache", path);
+	}
+	else
+	{
+		if (!iso_read_hierarchy(m_path, path, m_root))
+		{
+			invalidate();
+			return;
+		}
+
+		if (use_tree_cache)
+		{
+			iso_cache::save_tree(m_path, m_root);
+		}
+	}
+
 	// Only when the archive object is fully set, we can finally initialize the decryption object needing the archive object
 	m_dec = std::make_shared<iso_file_decryption>();
 
@@ -1227,7 +1082,7 @@ psf::registry iso_archive::open_psf(const std::string& path)
 
 iso_file::iso_file(const std::string& path, bs_t<fs::open_mode> mode)
 {
-	m_file = fs::file(path, mode);
+	m_file = open_iso_image(path, mode);
 
 	if (!m_file)
 	{
@@ -1247,7 +1102,7 @@ iso_file::iso_file(const std::string& path, bs_t<fs::open_mode> mode)
 iso_file::iso_file(const std::string& path, bs_t<fs::open_mode> mode, const iso_fs_node& node)
 	: m_meta(node.metadata)
 {
-	m_file = fs::file(path, mode);
+	m_file = open_iso_image(path, mode);
 
 	if (!m_file)
 	{
@@ -1325,137 +1180,136 @@ u64 iso_file::read(void* buffer, u64 size)
 	return r;
 }
 
-u64 iso_file::read_at(u64 offset, void* buffer, u64 size)
+u64 iso_file::read_sectors(u64 address, u8* buffer, u64 size)
 {
-	u64 max_size = std::min(size, local_extent_remaining(offset));
+	const u64 total_read = m_file.read_at(address, buffer, size);
 
-	if (max_size == 0)
+	if (m_process_sectors && total_read >= 16)
 	{
-		return 0;
-	}
-
-	const u64 total_size = this->size();
-	const u64 archive_first_offset = file_offset(offset);
-
-	// If it's not a raw device
-	if (!m_raw_device)
-	{
-		u64 total_read = m_file.read_at(archive_first_offset, buffer, max_size);
-
-		if (total_read != max_size)
-		{
-			iso_log.error("read_at: %s: Error reading from file - O: %llu (%llu), S: %llu/%llu (%llu), TR: %llu", m_meta.name,
-				offset, archive_first_offset, max_size, size, total_size, total_read);
-
-			return 0;
-		}
-
-		// If present, read the remaining chunk of data on next extent
-		if (size > max_size && (offset + max_size) < total_size)
-		{
-			iso_log.warning("read_at: %s: Extent limit reached reading from file (%llu/%llu)", m_meta.name, max_size, size);
-			max_size += read_at(offset + max_size, &reinterpret_cast<u8*>(buffer)[max_size], size - max_size);
-		}
-
-		return max_size;
+		// Decryption works on whole ciphertext blocks
+		process_sectors(address, {buffer, total_read & ~15ull});
 	}
 
-	// If it's a raw device
+	return total_read;
+}
 
+u64 iso_file::read_sectors_bounced(u64 address, u8* buffer, u64 size)
+{
 	// IMPORTANT NOTE:
 	//
 	// For a raw device, we must use a support buffer aligned (probably enough on multiple of 4), otherwise any read from file will fail.
-	// For that reason, we don't use directly "buffer" (not guaranteeing any alignment)
+	// For that reason, we don't use directly "buffer" (not guaranteeing any alignment) unless it's a regular file.
+	// Sectors are read and processed in batches of up to ISO_BOUNCE_BUFFER_SIZE bytes instead of one by one.
 	//
-	//                                                ----------------------------------------------------------------------
-	//                           file on ISO archive: |     '                                           '                  |
-	//                                                ----------------------------------------------------------------------
-	//                                                      '                                           '
-	//                                                      ---------------------------------------------
-	//                                              buffer: |                                           |
-	//                                                      ---------------------------------------------
-	//                                                      '     '                                   ' '
 	//                        -------------------------------------------------------------------------------------------------------------------------------------
 	//           ISO archive: | sec 0     | sec 1     |xxxxx######'###########'###########'###########'##xxxxxxxxx|           | ...       | sec n-1   | sec n     |
 	//                        -------------------------------------------------------------------------------------------------------------------------------------
 	//                                                '           '                                   '           '
-	//                                                | first sec |           inner sec(s)            | last sec  |
+	//                                                | bounced   |    direct (regular file only)     | bounced   |
 
-	const u64 archive_last_offset = archive_first_offset + max_size - 1;
-	iso_sector first_sec, last_sec;
-	void* aligned_buf = get_aligned_buf(); // thread-safe buffer
+	u64 done = 0;
 
-	first_sec.lba_address = (archive_first_offset / ISO_SECTOR_SIZE) * ISO_SECTOR_SIZE;
-	first_sec.offset = archive_first_offset % ISO_SECTOR_SIZE;
-	first_sec.size = first_sec.offset + max_size <= ISO_SECTOR_SIZE ? max_size : ISO_SECTOR_SIZE - first_sec.offset;
+	while (done < size)
+	{
+		const u64 pos = address + done;
+		const u64 sector_address = pos - pos % ISO_SECTOR_SIZE;
+		const u64 skip = pos - sector_address;
 
-	last_sec.lba_address = last_sec.address_aligned = (archive_last_offset / ISO_SECTOR_SIZE) * ISO_SECTOR_SIZE;
-	// last_sec.offset = last_sec.offset_aligned = 0; // Always 0 so no need to set and use those attributes
-	last_sec.size = (archive_last_offset % ISO_SECTOR_SIZE) + 1;
+		if (!m_raw_device && !skip && size - done >= ISO_SECTOR_SIZE)
+		{
+			// Whole sectors are read and processed in place
+			const u64 chunk = (size - done) - (size - done) % ISO_SECTOR_SIZE;
 
-	//
-	// First sector
-	//
+			if (read_sectors(sector_address, buffer + done, chunk) != chunk)
+			{
+				break;
+			}
 
-	u64 total_read = m_file.read_at(first_sec.lba_address, aligned_buf, ISO_SECTOR_SIZE);
+			done += chunk;
+			continue;
+		}
 
-	std::memcpy(buffer, &reinterpret_cast<u8*>(aligned_buf)[first_sec.offset], first_sec.size);
+		u8* aligned_buf = get_aligned_buf(); // thread-safe buffer
 
-	const u64 sector_count = (last_sec.lba_address - first_sec.lba_address) / ISO_SECTOR_SIZE + 1;
+		const u64 chunk = std::min<u64>(utils::align<u64>(skip + size - done, ISO_SECTOR_SIZE), ISO_BOUNCE_BUFFER_SIZE);
+		const u64 needed = std::min<u64>(chunk - skip, size - done);
 
-	if (sector_count < 2) // If no more sector(s)
-	{
-		if (total_read != ISO_SECTOR_SIZE)
+		if (read_sectors(sector_address, aligned_buf, chunk) < skip + needed)
 		{
-			iso_log.error("read_at: %s: Error reading from file - O: %llu (%llu), S: %llu/%llu/%llu (%llu), TR: %llu", m_meta.name,
-				offset, first_sec.lba_address, ISO_SECTOR_SIZE, max_size, size, total_size, total_read);
-
-			return 0;
+			break;
 		}
 
-		// If present, read the remaining chunk of data on next extent
-		if (size > max_size && (offset + max_size) < total_size)
-		{
-			iso_log.warning("read_at: %s: Extent limit reached reading from file (%llu/%llu)", m_meta.name, max_size, size);
-			max_size += read_at(offset + max_size, &reinterpret_cast<u8*>(buffer)[max_size], size - max_size);
-		}
+		std::memcpy(buffer + done, aligned_buf + skip, needed);
+		done += needed;
+	}
+
+	return done;
+}
 
-		return max_size;
+u64 iso_file::read_archive(u64 address, u8* buffer, u64 size, u64 limit)
+{
+	if (!m_raw_device && !m_process_sectors)
+	{
+		// The host page cache already handles read-ahead for plain image files, compressed images cache their chunks
+		return m_file.read_at(address, buffer, size);
 	}
 
-	//
-	// Inner sector(s), if any
-	//
+	std::lock_guard lock(m_window_mutex);
+
+	const bool sequential = address == m_last_read_end;
+	m_last_read_end = address + size;
 
-	if (sector_count > 2) // If inner sector(s) are present
+	if (m_window_size && address >= m_window_address && address + size <= m_window_address + m_window_size)
 	{
-		u64 sector_offset = 0;
+		std::memcpy(buffer, &m_window[address - m_window_address], size);
+		return size;
+	}
 
-		for (u64 i = 0; i < sector_count - 2; i++, sector_offset += ISO_SECTOR_SIZE)
+	if (sequential && size <= ISO_READ_AHEAD_SIZE / 2)
+	{
+		// Small sequential reads, fetch and process a larger window at once
+		if (!m_window)
 		{
-			total_read += m_file.read_at(first_sec.lba_address + ISO_SECTOR_SIZE + sector_offset, aligned_buf, ISO_SECTOR_SIZE);
+			m_window.reset(ensure(alloc_aligned_buf(ISO_READ_AHEAD_SIZE)));
+		}
 
-			std::memcpy(&reinterpret_cast<u8*>(buffer)[first_sec.size + sector_offset], aligned_buf, ISO_SECTOR_SIZE);
+		const u64 window_address = address - address % ISO_SECTOR_SIZE;
+		const u64 window_end = std::min<u64>(window_address + ISO_READ_AHEAD_SIZE, utils::align<u64>(limit, ISO_SECTOR_SIZE));
+
+		m_window_address = window_address;
+		m_window_size = read_sectors(window_address, m_window.get(), window_end - window_address) & ~15ull;
+
+		if (address + size <= m_window_address + m_window_size)
+		{
+			std::memcpy(buffer, &m_window[address - m_window_address], size);
+			return size;
 		}
+
+		m_window_size = 0;
 	}
 
-	//
-	// Last sector
-	//
+	return read_sectors_bounced(address, buffer, size);
+}
 
-	total_read += m_file.read_at(last_sec.address_aligned, aligned_buf, ISO_SECTOR_SIZE);
+u64 iso_file::read_at(u64 offset, void* buffer, u64 size)
+{
+	u64 max_size = std::min(size, local_extent_remaining(offset));
 
-	std::memcpy(&reinterpret_cast<u8*>(buffer)[max_size - last_sec.size], aligned_buf, last_sec.size);
+	if (max_size == 0)
+	{
+		return 0;
+	}
 
-	//
-	// As last, check for an unlikely reading error
-	//
+	const u64 total_size = this->size();
+	const u64 archive_first_offset = file_offset(offset);
+
+	// Read-ahead stays within the current extent, so it never crosses into a differently encrypted region
+	const u64 total_read = read_archive(archive_first_offset, static_cast<u8*>(buffer), max_size, archive_first_offset + local_extent_remaining(offset));
 
-	if (total_read != ISO_SECTOR_SIZE + ISO_SECTOR_SIZE + (sector_count - 2) * ISO_SECTOR_SIZE)
+	if (total_read != max_size)
 	{
-		iso_log.error("read_at: %s: Error reading from file - O: %llu (%llu), S: %llu/%llu/%llu (%llu), TR: %llu/%llu", m_meta.name,
-			offset, first_sec.lba_address, ISO_SECTOR_SIZE, max_size, size, total_size,
-			total_read,	ISO_SECTOR_SIZE + ISO_SECTOR_SIZE + (sector_count - 2) * ISO_SECTOR_SIZE);
+		iso_log.error("read_at: %s: Error reading from file - O: %llu (%llu), S: %llu/%llu (%llu), TR: %llu", m_meta.name,
+			offset, archive_first_offset, max_size, size, total_size, total_read);
 
 		return 0;
 	}
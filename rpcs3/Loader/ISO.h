@@ -3,9 +3,11 @@
 #include "PSF.h"
 
 #include "Utilities/File.h"
+#include "Utilities/mutex.h"
 #include "util/types.hpp"
 #include "Crypto/aes.h"
 
+#include <memory>
 #include <span>
 
 bool is_iso_file(const std::string& path, u64* size = nullptr, bool* is_raw_device = nullptr);
@@ -15,6 +17,12 @@ void unload_iso();
 
 constexpr u64 ISO_SECTOR_SIZE = 2048;
 
+// Size of the per-thread bounce buffer used for aligned multi-sector reads
+constexpr u64 ISO_BOUNCE_BUFFER_SIZE = ISO_SECTOR_SIZE * 128;
+
+// Size of the per-file read-ahead window for sequential streams
+constexpr u64 ISO_READ_AHEAD_SIZE = ISO_SECTOR_SIZE * 256;
+
 /*
 - Hijacked the "iso_archive::iso_archive" method to test if the ".iso" file is encrypted and sets a flag.
   The flag is set according to the first matching encryption type found following the order below:
@@ -30,6 +38,8 @@ constexpr u64 ISO_SECTOR_SIZE = 2048;
 
 - Unsupported ISO encryption type:
   - Encrypted split ISO files
+
+- Any of the above can be stored as a compressed image (.rzi), see "iso_compressed.h"
 */
 
 // Struct to store ISO region information (storing addresses instead of LBA since we need to compare
@@ -104,19 +114,43 @@ struct iso_fs_node
 	std::vector<std::unique_ptr<iso_fs_node>> children;
 };
 
+struct iso_aligned_buffer_deleter
+{
+	void operator()(u8* ptr) const;
+};
+
 class iso_file : public fs::file_base
 {
 protected:
 	fs::file m_file;
 	iso_fs_metadata m_meta;
 	bool m_raw_device = false;
+	bool m_process_sectors = false; // Sectors need to be decrypted or patched after reading
 	u64 m_pos = 0;
 
+	// Read-ahead window in archive addresses, holding processed data
+	shared_mutex m_window_mutex;
+	std::unique_ptr<u8[], iso_aligned_buffer_deleter> m_window;
+	u64 m_window_address = 0;
+	u64 m_window_size = 0;
+	u64 m_last_read_end = umax;
+
 	std::pair<u64, iso_extent_info> get_extent_pos(u64 pos) const;
 	u64 local_extent_remaining(u64 pos) const;
 	u64 local_extent_size(u64 pos) const;
 	u64 file_offset(u64 pos) const;
 
+	// Reads whole sectors at a sector-aligned archive address and processes them, the buffer must be aligned for raw devices
+	u64 read_sectors(u64 address, u8* buffer, u64 size);
+
+	// Reads any archive range through aligned multi-sector reads
+	u64 read_sectors_bounced(u64 address, u8* buffer, u64 size);
+
+	// Reads an archive range, serving sequential streams from the read-ahead window. "limit" is the end of the readable range.
+	u64 read_archive(u64 address, u8* buffer, u64 size, u64 limit);
+
+	virtual void process_sectors(u64 /*address*/, std::span<u8> /*data*/) {}
+
 public:
 	iso_file(const std::string& path, bs_t<fs::open_mode> mode = fs::read);
 	iso_file(const std::string& path, bs_t<fs::open_mode> mode, const iso_fs_node& node);
@@ -144,7 +178,8 @@ private:
 public:
 	iso_file_encrypted(const std::string& path, bs_t<fs::open_mode> mode, const iso_fs_node& node, std::shared_ptr<iso_file_decryption> dec);
 
-	u64 read_at(u64 offset, void* buffer, u64 size) override;
+protected:
+	void process_sectors(u64 address, std::span<u8> data) override;
 };
 
 class iso_dir : public fs::dir_base
@@ -2,8 +2,16 @@
 
 #include "Crypto/sha1.h"
 #include "Crypto/key_vault.h"
+#include "Crypto/unself.h"
+#include "Emu/Cell/timers.hpp"
+#include "Utilities/Thread.h"
+#include "util/sysinfo.hpp"
+#include "util/serialization_ext.hpp"
 
 #include "PUP.h"
+#include "TAR.h"
+
+LOG_CHANNEL(pup_log, "PUP");
 
 pup_object::pup_object(fs::file&& file) : m_file(std::move(file))
 {
@@ -113,3 +121,95 @@ pup_error pup_object::validate_hashes()
 
 	return pup_error::ok;
 }
+
+pup_install_result install_dev_flash_packages(tar_object& update_files, std::span<const std::string> packages, pup_install_state& state)
+{
+	const u64 start_time = get_system_time();
+
+	// Resolve all package streams first, tar_object lookups are not thread-safe
+	std::vector<std::unique_ptr<utils::serial>> package_streams;
+	package_streams.reserve(packages.size());
+
+	for (const std::string& package : packages)
+	{
+		package_streams.emplace_back(update_files.get_file(package));
+
+		if (!package_streams.back())
+		{
+			pup_log.error("Firmware package %s was not found", package);
+			return pup_install_result::missing_package;
+		}
+	}
+
+	atomic_t<usz> next_package = 0;
+	atomic_t<pup_install_result> result = pup_install_result::ok;
+
+	// Every worker holds one decrypted package in memory, a handful of them is enough to keep the disk busy
+	const u32 thread_count = std::min<u32>({::size32(packages), utils::get_thread_count(), 8});
+
+	named_thread_group workers("Firmware Installer "sv, thread_count, [&]()
+	{
+		for (usz index = next_package++; index < packages.size(); index = next_package++)
+		{
+			if (state.cancelled || result != pup_install_result::ok)
+			{
+				return;
+			}
+
+			const std::string& package = packages[index];
+			utils::serial& package_stream = *package_streams[index];
+
+			if (package_stream.m_file_handler)
+			{
+				// Forcefully read all the data
+				package_stream.m_file_handler->handle_file_op(package_stream, 0, package_stream.get_size(umax), nullptr);
+			}
+
+			fs::file update_file = fs::make_stream(std::move(package_stream.data));
+
+			SCEDecrypter self_dec(update_file);
+			self_dec.LoadHeaders();
+			self_dec.LoadMetadata(SCEPKG_ERK, SCEPKG_RIV);
+			self_dec.DecryptData();
+
+			const auto dev_flash_tar_f = self_dec.MakeFile();
+
+			if (dev_flash_tar_f.size() < 3)
+			{
+				pup_log.error("Firmware package %s could not be decrypted", package);
+				result.compare_and_swap(pup_install_result::ok, pup_install_result::decrypt_failed);
+				return;
+			}
+
+			// Entries are written to disk in chunks as they are read from the decrypted package
+			tar_object dev_flash_tar(dev_flash_tar_f[2]);
+
+			if (!dev_flash_tar.extract())
+			{
+				pup_log.error("Firmware package %s could not be extracted", package);
+				result.compare_and_swap(pup_install_result::ok, pup_install_result::extract_failed);
+				return;
+			}
+
+			state.written_bytes += dev_flash_tar_f[2].size();
+			state.installed_packages++;
+		}
+	});
+
+	workers.join();
+
+	if (result == pup_install_result::ok && state.cancelled)
+	{
+		return pup_install_result::cancelled;
+	}
+
+	if (result == pup_install_result::ok)
+	{
+		const f64 seconds = std::max<f64>((get_system_time() - start_time) / 1'000'000., 0.001);
+		const f64 mib = state.written_bytes / 1048576.;
+
+		pup_log.success("Installed %u firmware packages (%.1f MiB) in %.2f seconds (%.1f MiB/s, %u threads)", state.installed_packages.load(), mib, seconds, mib / seconds, thread_count);
+	}
+
+	return result;
+}
@@ -2,10 +2,14 @@
 
 #include "util/types.hpp"
 #include "util/endian.hpp"
+#include "util/atomic.hpp"
 #include "../../Utilities/File.h"
 
+#include <span>
 #include <vector>
 
+class tar_object;
+
 struct PUPHeader
 {
 	le_t<u64> magic;
@@ -66,3 +70,24 @@ public:
 
 	fs::file get_file(u64 entry_id) const;
 };
+
+enum class pup_install_result : u32
+{
+	ok,
+
+	cancelled,
+	missing_package,
+	decrypt_failed,
+	extract_failed,
+};
+
+// Shared between the installer workers and the caller's progress display
+struct pup_install_state
+{
+	atomic_t<u32> installed_packages = 0;
+	atomic_t<u64> written_bytes = 0;
+	atomic_t<bool> cancelled = false;
+};
+
+// Decrypt the dev_flash_* packages of the PUP update TAR and extract them to the mounted /dev_flash, several packages at a time
+pup_install_result install_dev_flash_packages(tar_object& update_files, std::span<const std::string> packages, pup_install_state& state);
@@ -8,6 +8,8 @@
 #include "Utilities/rXml.h"
 #include "Crypto/md5.h"
 #include "Crypto/utils.h"
+#include "Utilities/Thread.h"
+#include "util/sysinfo.hpp"
 
 LOG_CHANNEL(sys_log, "VALIDATION");
 
@@ -107,6 +109,118 @@ content_integrity_status content_validation::check_integrity(content_file_type f
 	return content_integrity_status::NO_MATCH;
 }
 
+// Hashes the file in large blocks, the next block is read on a separate thread while the current one is hashed
+static content_hash_status hash_file(const std::string& path, std::string& hash, atomic_t<u64>& bytes_read, const atomic_t<content_hash_status>& status)
+{
+	iso_file file(path);
+
+	// If no file exists
+	if (!file)
+	{
+		sys_log.error("calculate_hash: Failed to open file: %s", path);
+		return content_hash_status::ABORTED;
+	}
+
+	constexpr u64 block_size = 0x100000;
+
+	struct hash_block
+	{
+		std::vector<u8> data = std::vector<u8>(block_size);
+		u64 size = 0;
+		atomic_t<u32> ready = 0; // Filled by the reader, not yet hashed
+	};
+
+	std::array<hash_block, 2> blocks{};
+	atomic_t<bool> stop = false;
+
+	named_thread reader("Hash Reader"sv, [&]()
+	{
+		for (usz i = 0;; i++)
+		{
+			hash_block& block = blocks[i % 2];
+
+			while (block.ready && !stop)
+			{
+				block.ready.wait(1);
+			}
+
+			if (stop)
+			{
+				return;
+			}
+
+			block.size = file.read(block.data.data(), block_size);
+			block.ready = 1;
+			block.ready.notify_one();
+
+			if (block.size != block_size)
+			{
+				return;
+			}
+		}
+	});
+
+	mbedtls_md5_context md5_ctx;
+	unsigned char md5_hash[16];
+
+	mbedtls_md5_starts_ret(&md5_ctx);
+
+	for (usz i = 0; status != content_hash_status::ABORTED; i++)
+	{
+		hash_block& block = blocks[i % 2];
+
+		while (!block.ready && status != content_hash_status::ABORTED)
+		{
+			// Wake up periodically to notice an abort while the reader is stuck on slow media
+			block.ready.wait(0, atomic_wait_timeout{100'000'000});
+		}
+
+		if (status == content_hash_status::ABORTED)
+		{
+			break;
+		}
+
+		const u64 size = block.size;
+
+		mbedtls_md5_update_ret(&md5_ctx, block.data.data(), size);
+		bytes_read += size;
+
+		block.ready = 0;
+		block.ready.notify_one();
+
+		if (size != block_size)
+		{
+			break;
+		}
+	}
+
+	if (status == content_hash_status::ABORTED)
+	{
+		// Unblock the reader
+		stop = true;
+
+		for (hash_block& block : blocks)
+		{
+			block.ready = 0;
+			block.ready.notify_one();
+		}
+
+		sys_log.warning("calculate_hash: MD5 hash calculation aborted by user: %s", path);
+		return content_hash_status::ABORTED;
+	}
+
+	if (mbedtls_md5_finish_ret(&md5_ctx, md5_hash) != 0)
+	{
+		sys_log.error("calculate_hash: Failed to calculate MD5 hash on file: %s", path);
+		return content_hash_status::ABORTED;
+	}
+
+	// Convert the MD5 hash to hex string
+	bytes_to_hex(hash, md5_hash, 16);
+
+	return content_hash_status::COMPLETED;
+}
+
 bool content_validation::init_hash(const std::string& path)
 {
 	std::string new_path = path;
@@ -124,6 +238,8 @@ bool content_validation::init_hash(const std::string& path)
 	}
 
 	m_path = new_path;
+	m_paths.clear();
+	m_open_failed.clear();
 	m_name = new_path.find_last_of(fs::delim) != umax ? new_path.substr(new_path.find_last_of(fs::delim) + 1) : new_path;
 	m_size = file.size();
 	m_bytes_read = 0;
@@ -140,48 +256,101 @@ content_hash_status content_validation::calculate_hash(std::string& hash)
 		return m_status;
 	}
 
-	iso_file file(m_path);
+	const content_hash_status status = hash_file(m_path, hash, m_bytes_read, m_status);
 
-	// If no file exists
-	if (!file)
+	// Keep ABORTED if the user aborted in the meantime
+	m_status.compare_and_swap(content_hash_status::INITIALIZED, status);
+	return m_status;
+}
+
+bool content_validation::init_hashes(const std::vector<std::string>& paths)
+{
+	m_path.clear();
+	m_paths.clear();
+	m_open_failed.clear();
+	m_size = 0;
+	m_bytes_read = 0;
+
+	for (const std::string& path : paths)
 	{
-		sys_log.error("calculate_hash: Failed to open file: %s", m_path);
-		m_status = content_hash_status::ABORTED;
-		return m_status;
-	}
+		std::string new_path = path;
 
-	constexpr u64 block_size = 4096;
-	std::array<u8, block_size> buf;
-	u64 bytes_read;
-	mbedtls_md5_context md5_ctx;
-	unsigned char md5_hash[16];
+		fs::get_optical_raw_device(path, &new_path);
 
-	mbedtls_md5_starts_ret(&md5_ctx);
+		iso_file file(new_path);
 
-	do
-	{
-		bytes_read = file.read(buf.data(), block_size);
-		mbedtls_md5_update_ret(&md5_ctx, buf.data(), bytes_read);
+		// If no file exists, keep it in the batch to report it as failed
+		if (!file)
+		{
+			sys_log.error("init_hashes: Failed to open file: %s", new_path);
+		}
+		else
+		{
+			m_size += file.size();
+		}
 
-		m_bytes_read += bytes_read;
-	} while (bytes_read == block_size && m_status != content_hash_status::ABORTED);
+		m_open_failed.push_back(!file);
+		m_paths.push_back(std::move(new_path));
+	}
 
-	if (m_status == content_hash_status::ABORTED)
+	if (m_paths.size() == 1)
 	{
-		sys_log.warning("calculate_hash: MD5 hash calculation aborted by user: %s", m_path);
-		return m_status;
+		m_name = m_paths[0].find_last_of(fs::delim) != umax ? m_paths[0].substr(m_paths[0].find_last_of(fs::delim) + 1) : m_paths[0];
+	}
+	else
+	{
+		m_name = fmt::format("%u files", m_paths.size());
 	}
 
-	if (mbedtls_md5_finish_ret(&md5_ctx, md5_hash) != 0)
+	m_status = content_hash_status::INITIALIZED;
+	return true;
+}
+
+content_hash_status content_validation::calculate_hashes(std::vector<content_hash_result>& results)
+{
+	results.clear();
+
+	if (m_status != content_hash_status::INITIALIZED || m_paths.empty())
 	{
-		sys_log.error("calculate_hash: Failed to calculate MD5 hash on file: %s", m_path);
+		sys_log.error("calculate_hashes: MD5 hash calculation already performed or not initialized");
 		m_status = content_hash_status::ABORTED;
 		return m_status;
 	}
 
-	// Convert the MD5 hash to hex string
-	bytes_to_hex(hash, md5_hash, 16);
+	results.resize(m_paths.size());
+
+	for (usz i = 0; i < m_paths.size(); i++)
+	{
+		results[i].path = m_paths[i];
+
+		if (m_open_failed[i])
+		{
+			results[i].status = content_hash_status::ABORTED;
+		}
+	}
+
+	atomic_t<usz> next_file = 0;
+
+	// Each worker keeps its own reader thread busy, a few of them are enough to saturate most disks
+	const u32 thread_count = std::min<u32>({::size32(m_paths), std::max<u32>(utils::get_thread_count() / 2, 1), 4});
+
+	named_thread_group workers("Content Hasher "sv, thread_count, [&]()
+	{
+		for (usz index = next_file++; index < results.size() && m_status != content_hash_status::ABORTED; index = next_file++)
+		{
+			content_hash_result& result = results[index];
+
+			if (m_open_failed[index])
+			{
+				continue;
+			}
+
+			result.status = hash_file(result.path, result.hash, m_bytes_read, m_status);
+		}
+	});
+
+	workers.join();
 
-	m_status = content_hash_status::COMPLETED;
+	m_status.compare_and_swap(content_hash_status::INITIALIZED, content_hash_status::COMPLETED);
 	return m_status;
 }
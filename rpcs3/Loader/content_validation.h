@@ -1,6 +1,9 @@
 #pragma once
 
 #include "util/types.hpp"
+#include "util/atomic.hpp"
+
+#include <vector>
 
 // Enum identifying the content file type
 enum class content_file_type
@@ -28,16 +31,26 @@ enum class content_integrity_status
 	ERROR_PARSING_DB
 };
 
+// Hash of a single file of a batch
+struct content_hash_result
+{
+	std::string path;
+	std::string hash;
+	content_hash_status status = content_hash_status::INITIALIZED;
+};
+
 // Content validation class
 class content_validation
 {
 private:
 	std::string m_path;
+	std::vector<std::string> m_paths; // Set only by init_hashes()
+	std::vector<bool> m_open_failed; // Files of m_paths which init_hashes() couldn't open
 	std::string m_name;
 	u64 m_size = 0;
-	u64 m_bytes_read = 0;
+	atomic_t<u64> m_bytes_read = 0; // Read concurrently by the progress dialog
 	u16 m_count = 0; // Set only by set_count()
-	content_hash_status m_status = content_hash_status::INITIALIZED;
+	atomic_t<content_hash_status> m_status = content_hash_status::INITIALIZED;
 
 public:
 	static content_integrity_status check_integrity(content_file_type file_type, std::string_view hash, std::string* game_name = nullptr);
@@ -54,4 +67,9 @@ public:
 
 	bool init_hash(const std::string& path);
 	content_hash_status calculate_hash(std::string& hash);
+
+	// Batch version, the files are hashed concurrently and the progress covers the whole batch.
+	// A file which fails to hash doesn't abort the others, only abort_hash() does.
+	bool init_hashes(const std::vector<std::string>& paths);
+	content_hash_status calculate_hashes(std::vector<content_hash_result>& results);
 };
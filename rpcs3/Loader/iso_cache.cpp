@@ -1,6 +1,7 @@
 #include "stdafx.h"
 
 #include "iso_cache.h"
+#include "Loader/ISO.h"
 #include "Loader/PSF.h"
 #include "util/yaml.hpp"
 #include "util/fnv_hash.hpp"
@@ -36,6 +37,133 @@ namespace
 	{
 		return get_cache_stem(iso_path + "//index");
 	}
+
+	// Separate stem for the per-ISO directory tree entry.
+	std::string get_tree_stem(const std::string& iso_path)
+	{
+		return get_cache_stem(iso_path + "//tree");
+	}
+
+	constexpr u32 tree_magic = "ISOT"_u32;
+	constexpr u32 tree_version = 1;
+
+	struct tree_header
+	{
+		le_t<u32> magic;
+		le_t<u32> version;
+		le_t<s64> mtime;
+		le_t<u64> size;
+	};
+
+	// Appends nodes in pre-order: name, time, flags, extents, then the children
+	void write_tree_node(std::vector<u8>& out, const iso_fs_node& node)
+	{
+		const auto append = [&](const auto& value)
+		{
+			const usz pos = out.size();
+			out.resize(pos + sizeof(value));
+			std::memcpy(out.data() + pos, &value, sizeof(value));
+		};
+
+		const iso_fs_metadata& meta = node.metadata;
+
+		append(le_t<u32>{::size32(meta.name)});
+		out.insert(out.end(), meta.name.begin(), meta.name.end());
+		append(le_t<s64>{meta.time});
+		append(static_cast<u8>((meta.is_directory ? 1 : 0) | (meta.has_multiple_extents ? 2 : 0)));
+		append(le_t<u32>{::size32(meta.extents)});
+
+		for (const iso_extent_info& extent : meta.extents)
+		{
+			append(le_t<u64>{extent.start});
+			append(le_t<u64>{extent.size});
+		}
+
+		append(le_t<u32>{::size32(node.children)});
+
+		for (const auto& child : node.children)
+		{
+			write_tree_node(out, *child);
+		}
+	}
+
+	struct tree_reader
+	{
+		const std::vector<u8>& data;
+		usz pos = 0;
+
+		template <typename T>
+		bool read(T& value)
+		{
+			if (data.size() - pos < sizeof(T))
+			{
+				return false;
+			}
+
+			std::memcpy(&value, data.data() + pos, sizeof(T));
+			pos += sizeof(T);
+			return true;
+		}
+
+		bool read_node(iso_fs_node& node, u32 depth)
+		{
+			le_t<u32> name_size{}, extent_count{}, child_count{};
+			le_t<s64> time{};
+			u8 flags = 0;
+
+			// Every count is checked against the remaining bytes, a damaged file must not cause huge allocations
+			if (depth > 256 || !read(name_size) || name_size > data.size() - pos)
+			{
+				return false;
+			}
+
+			iso_fs_metadata& meta = node.metadata;
+			meta.name.assign(reinterpret_cast<const char*>(data.data() + pos), name_size);
+			pos += name_size;
+
+			if (!read(time) || !read(flags) || !read(extent_count) || extent_count > (data.size() - pos) / 16)
+			{
+				return false;
+			}
+
+			meta.time = time;
+			meta.is_directory = !!(flags & 1);
+			meta.has_multiple_extents = !!(flags & 2);
+			meta.extents.resize(extent_count);
+
+			for (iso_extent_info& extent : meta.extents)
+			{
+				le_t<u64> start{}, size{};
+
+				if (!read(start) || !read(size))
+				{
+					return false;
+				}
+
+				extent.start = start;
+				extent.size = size;
+			}
+
+			if (!read(child_count) || child_count > data.size() - pos)
+			{
+				return false;
+			}
+
+			node.children.resize(child_count);
+
+			for (auto& child : node.children)
+			{
+				child = std::make_unique<iso_fs_node>();
+
+				if (!read_node(*child, depth + 1))
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+	};
 }
 
 namespace iso_cache
@@ -220,6 +348,77 @@ namespace iso_cache
 		}
 	}
 
+	bool load_tree(const std::string& iso_path, iso_fs_node& out_root)
+	{
+		fs::stat_t iso_stat{};
+		if (!fs::get_stat(iso_path, iso_stat) || iso_stat.is_directory)
+		{
+			return false;
+		}
+
+		const fs::file tree_file(get_cache_dir() + get_tree_stem(iso_path) + ".bin");
+		if (!tree_file)
+		{
+			return false;
+		}
+
+		const std::vector<u8> data = tree_file.to_vector<u8>();
+
+		tree_reader reader{data};
+		tree_header header{};
+
+		if (!reader.read(header) || header.magic != tree_magic || header.version != tree_version)
+		{
+			return false;
+		}
+
+		// Reject stale entries.
+		if (header.mtime != iso_stat.mtime || header.size != iso_stat.size)
+		{
+			return false;
+		}
+
+		iso_fs_node root{};
+
+		if (!reader.read_node(root, 0) || reader.pos != data.size())
+		{
+			iso_cache_log.warning("Failed to parse directory tree cache for '%s'", iso_path);
+			return false;
+		}
+
+		out_root = std::move(root);
+		return true;
+	}
+
+	void save_tree(const std::string& iso_path, const iso_fs_node& root)
+	{
+		fs::stat_t iso_stat{};
+		if (!fs::get_stat(iso_path, iso_stat))
+		{
+			return;
+		}
+
+		tree_header header{};
+		header.magic = tree_magic;
+		header.version = tree_version;
+		header.mtime = iso_stat.mtime;
+		header.size = iso_stat.size;
+
+		std::vector<u8> data(sizeof(header));
+		std::memcpy(data.data(), &header, sizeof(header));
+		write_tree_node(data, root);
+
+		if (fs::pending_file tree_file(get_cache_dir() + get_tree_stem(iso_path) + ".bin"); tree_file.file)
+		{
+			tree_file.file.write(data);
+			tree_file.commit();
+		}
+		else
+		{
+			iso_cache_log.warning("Failed to write directory tree cache for '%s'", iso_path);
+		}
+	}
+
 	void cleanup(const std::unordered_set<std::string>& valid_iso_paths)
 	{
 		const std::string dir = get_cache_dir();
@@ -230,6 +429,7 @@ namespace iso_cache
 		{
 			valid_stems.insert(get_cache_stem(path));
 			valid_stems.insert(get_index_stem(path));
+			valid_stems.insert(get_tree_stem(path));
 		}
 
 		// Delete any cache files whose stem is not in the valid set.
@@ -8,6 +8,8 @@
 #include <unordered_set>
 #include <vector>
 
+struct iso_fs_node;
+
 // Cached metadata extracted from an ISO during game list scanning.
 struct iso_metadata_cache_entry
 {
@@ -31,6 +33,11 @@ namespace iso_cache
 	bool load_index(const std::string& iso_path, std::vector<std::string>& out_subdirs);
 	void save_index(const std::string& iso_path, const std::vector<std::string>& subdirs);
 
+	// Full directory tree with file extents, so mounting can skip parsing the ISO9660 directory records.
+	// Returns false if no valid entry exists or the image mtime or size has changed.
+	bool load_tree(const std::string& iso_path, iso_fs_node& out_root);
+	void save_tree(const std::string& iso_path, const iso_fs_node& root);
+
 	// Remove cache entries for ISOs that are no longer in the scanned set.
 	void cleanup(const std::unordered_set<std::string>& valid_iso_paths);
 }
@@ -0,0 +1,633 @@
+#include "stdafx.h"
+
+#include "iso_compressed.h"
+#include "ISO.h"
+#include "Emu/Cell/timers.hpp"
+#include "Utilities/Thread.h"
+#include "Utilities/mutex.h"
+#include "util/sysinfo.hpp"
+#include "util/asm.hpp"
+
+#include <zstd.h>
+#include <unordered_map>
+
+LOG_CHANNEL(iso_log, "ISO");
+
+// Number of decompressed chunks kept per image for small and unaligned reads
+constexpr usz s_chunk_cache_size = 16;
+
+// Offset table entries loaded at once, the table is only read where it is needed
+constexpr u64 s_offset_page_entries = 0x1000;
+
+// Reads covering at least this many whole chunks are decompressed in parallel
+constexpr u64 s_parallel_chunk_count = 8;
+
+constexpr int s_compression_level = 9;
+
+static ZSTD_DCtx* get_dctx()
+{
+	static thread_local const std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> s_dctx{ZSTD_createDCtx(), &ZSTD_freeDCtx};
+
+	return ensure(s_dctx.get());
+}
+
+static ZSTD_CCtx* get_cctx()
+{
+	static thread_local const std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)> s_cctx{ZSTD_createCCtx(), &ZSTD_freeCCtx};
+
+	return ensure(s_cctx.get());
+}
+
+// Compressed image state shared by all open files of the same image
+class iso_compressed_image
+{
+	std::string m_path;
+	fs::file m_file;
+	iso_compressed_header m_header{};
+
+	shared_mutex m_mutex;
+
+	// Offset table pages, entries [page * s_offset_page_entries, (page + 1) * s_offset_page_entries] each
+	std::vector<std::unique_ptr<std::vector<le_t<u64>>>> m_offset_pages;
+
+	// Most recently used first
+	std::vector<std::pair<u64, std::shared_ptr<const std::vector<u8>>>> m_cache;
+
+	// Chunks of a large read, claimed one by one by the reader and the decompression workers
+	struct decompress_job
+	{
+		u64 first;
+		u64 count;
+		u8* buffer;
+		std::vector<u8> failed;
+		atomic_t<u64> next = 0;
+		atomic_t<u64> done = 0;
+	};
+
+	shared_mutex m_job_mutex;
+	std::shared_ptr<decompress_job> m_job;
+	atomic_t<u32> m_job_seq = 0;
+
+	// Created on the first large read, destroyed (joined) first
+	std::unique_ptr<named_thread_group<std::function<void()>>> m_workers;
+
+	u64 chunk_length(u64 index) const
+	{
+		return std::min<u64>(m_header.chunk_size, m_header.image_size - index * m_header.chunk_size);
+	}
+
+	// Returns the file range of a chunk, loading and validating its offset table page on first use
+	bool get_chunk_range(u64 index, u64& start, u64& end)
+	{
+		const u64 page = index / s_offset_page_entries;
+		const u64 first = page * s_offset_page_entries;
+
+		std::lock_guard lock(m_mutex);
+
+		auto& entries = m_offset_pages[page];
+
+		if (!entries)
+		{
+			const u64 count = std::min<u64>(s_offset_page_entries, m_header.chunk_count - first) + 1;
+			auto loaded = std::make_unique<std::vector<le_t<u64>>>(count);
+
+			if (m_file.read_at(sizeof(m_header) + first * sizeof(u64), loaded->data(), count * sizeof(u64)) != count * sizeof(u64))
+			{
+				iso_log.error("Corrupt compressed image '%s': Failed to read offset table", m_path);
+				return false;
+			}
+
+			for (u64 i = 0; i + 1 < count; i++)
+			{
+				const u64 stored_start = (*loaded)[i];
+				const u64 stored_end = (*loaded)[i + 1];
+
+				if (stored_start >= stored_end || stored_end - stored_start > chunk_length(first + i) || stored_end > m_file.size())
+				{
+					iso_log.error("Corrupt compressed image '%s': Invalid chunk %u", m_path, first + i);
+					return false;
+				}
+			}
+
+			entries = std::move(loaded);
+		}
+
+		start = (*entries)[index - first];
+		end = (*entries)[index - first + 1];
+		return true;
+	}
+
+	bool decompress_chunk(u64 index, u8* out)
+	{
+		u64 start = 0, end = 0;
+
+		if (!get_chunk_range(index, start, end))
+		{
+			return false;
+		}
+
+		const u64 length = chunk_length(index);
+		const u64 stored = end - start;
+
+		if (stored == length)
+		{
+			// Stored uncompressed
+			return m_file.read_at(start, out, length) == length;
+		}
+
+		static thread_local std::vector<u8> s_compressed;
+		s_compressed.resize(stored);
+
+		if (m_file.read_at(start, s_compressed.data(), stored) != stored)
+		{
+			return false;
+		}
+
+		const usz result = ZSTD_decompressDCtx(get_dctx(), out, length, s_compressed.data(), stored);
+
+		if (ZSTD_isError(result) || result != length)
+		{
+			iso_log.error("Failed to decompress chunk %u of '%s': %s", index, m_path, ZSTD_isError(result) ? ZSTD_getErrorName(result) : "size mismatch");
+			return false;
+		}
+
+		return true;
+	}
+
+	std::shared_ptr<const std::vector<u8>> get_chunk(u64 index)
+	{
+		{
+			std::lock_guard lock(m_mutex);
+
+			for (auto it = m_cache.begin(); it != m_cache.end(); it++)
+			{
+				if (it->first == index)
+				{
+					std::rotate(m_cache.begin(), it, it + 1);
+					return m_cache.front().second;
+				}
+			}
+		}
+
+		auto data = std::make_shared<std::vector<u8>>(chunk_length(index));
+
+		if (!decompress_chunk(index, data->data()))
+		{
+			return nullptr;
+		}
+
+		std::lock_guard lock(m_mutex);
+
+		// Another reader may have decompressed the same chunk meanwhile
+		for (auto it = m_cache.begin(); it != m_cache.end(); it++)
+		{
+			if (it->first == index)
+			{
+				std::rotate(m_cache.begin(), it, it + 1);
+				return m_cache.front().second;
+			}
+		}
+
+		m_cache.emplace(m_cache.begin(), index, data);
+
+		if (m_cache.size() > s_chunk_cache_size)
+		{
+			m_cache.pop_back();
+		}
+
+		return data;
+	}
+
+public:
+	bool open(const std::string& path)
+	{
+		m_path = path;
+		m_file = fs::file(path);
+
+		if (!m_file || !m_file.read(m_header) || m_header.magic != ISO_COMPRESSED_MAGIC)
+		{
+			return false;
+		}
+
+		const u64 chunk_size = m_header.chunk_size;
+
+		if (m_header.version != ISO_COMPRESSED_VERSION || !chunk_size || chunk_size % ISO_SECTOR_SIZE || chunk_size > 0x100'0000)
+		{
+			iso_log.error("Unsupported compressed image '%s' (version=%u, chunk_size=0x%x)", path, m_header.version, chunk_size);
+			return false;
+		}
+
+		const u64 data_start = sizeof(m_header) + (m_header.chunk_count + 1) * sizeof(u64);
+		le_t<u64> first_offset{};
+
+		if (m_header.chunk_count != utils::aligned_div<u64>(m_header.image_size, chunk_size) || data_start > m_file.size() ||
+			!m_file.read(first_offset) || first_offset != data_start)
+		{
+			iso_log.error("Corrupt compressed image '%s': Invalid offset table", path);
+			return false;
+		}
+
+		m_offset_pages.resize(utils::aligned_div<u64>(m_header.chunk_count, s_offset_page_entries));
+		return true;
+	}
+
+	u64 size() const
+	{
+		return m_header.image_size;
+	}
+
+	fs::stat_t get_stat() const
+	{
+		fs::stat_t stat = m_file.get_stat();
+		stat.size = m_header.image_size;
+		stat.is_writable = false;
+		return stat;
+	}
+
+	u64 read_at(u64 offset, u8* buffer, u64 size)
+	{
+		if (offset >= m_header.image_size)
+		{
+			return 0;
+		}
+
+		size = std::min<u64>(size, m_header.image_size - offset);
+
+		const u64 chunk_size = m_header.chunk_size;
+		const u64 end = offset + size;
+
+		// Range of chunks fully covered by the request, decompressed straight into the output buffer
+		const u64 first_whole = utils::aligned_div<u64>(offset, chunk_size);
+		const u64 last_whole = end == m_header.image_size ? u64{m_header.chunk_count} : end / chunk_size;
+		const u64 whole_count = last_whole > first_whole ? last_whole - first_whole : 0;
+
+		u64 done = 0;
+
+		while (done < size)
+		{
+			const u64 pos = offset + done;
+			const u64 index = pos / chunk_size;
+			const u64 skip = pos % chunk_size;
+
+			if (!skip && index >= first_whole && index < last_whole && whole_count >= s_parallel_chunk_count)
+			{
+				const u64 expected = std::min<u64>(last_whole * chunk_size, m_header.image_size) - pos;
+				const u64 read = read_whole_chunks(index, last_whole, buffer + done);
+				done += read;
+
+				if (read != expected)
+				{
+					break;
+				}
+
+				continue;
+			}
+
+			const u64 needed = std::min<u64>(chunk_length(index) - skip, size - done);
+
+			if (!skip && needed == chunk_length(index))
+			{
+				// Whole chunk, bypass the cache
+				if (!decompress_chunk(index, buffer + done))
+				{
+					break;
+				}
+			}
+			else
+			{
+				const auto chunk = get_chunk(index);
+
+				if (!chunk)
+				{
+					break;
+				}
+
+				std::memcpy(buffer + done, chunk->data() + skip, needed);
+			}
+
+			done += needed;
+		}
+
+		return done;
+	}
+
+	void run_job(decompress_job& job)
+	{
+		for (u64 i = job.next++; i < job.count; i = job.next++)
+		{
+			job.failed[i] = !decompress_chunk(job.first + i, job.buffer + i * m_header.chunk_size);
+
+			if (++job.done == job.count)
+			{
+				job.done.notify_all();
+			}
+		}
+	}
+
+	// Decompresses chunks [first, last) in parallel, returns the number of bytes written before the first failure
+	u64 read_whole_chunks(u64 first, u64 last, u8* buffer)
+	{
+		const auto job = std::make_shared<decompress_job>();
+		job->first = first;
+		job->count = last - first;
+		job->buffer = buffer;
+		job->failed.resize(job->count);
+
+		{
+			std::lock_guard lock(m_job_mutex);
+
+			if (!m_workers)
+			{
+				// The reading thread takes part as well
+				const u32 thread_count = std::clamp<u32>(utils::get_thread_count(), 2, 8) - 1;
+
+				m_workers = std::make_unique<named_thread_group<std::function<void()>>>("ISO Decompressor "sv, thread_count, [this]()
+				{
+					for (u32 seen = 0; thread_ctrl::state() != thread_state::aborting;)
+					{
+						if (const u32 seq = m_job_seq; seq == seen)
+						{
+							thread_ctrl::wait_on(m_job_seq, seq);
+							continue;
+						}
+						else
+						{
+							seen = seq;
+						}
+
+						std::shared_ptr<decompress_job> job;
+						{
+							reader_lock lock(m_job_mutex);
+							job = m_job;
+						}
+
+						// Workers only leave a job once every chunk has been claimed, so the buffer is never touched afterwards
+						if (job)
+						{
+							run_job(*job);
+						}
+					}
+				});
+			}
+
+			m_job = job;
+		}
+
+		m_job_seq++;
+		m_job_seq.notify_all();
+
+		run_job(*job);
+
+		for (u64 done = job->done; done < job->count; done = job->done)
+		{
+			job->done.wait(done);
+		}
+
+		{
+			std::lock_guard lock(m_job_mutex);
+
+			if (m_job == job)
+			{
+				m_job.reset();
+			}
+		}
+
+		u64 read = 0;
+
+		for (u64 i = 0; i < job->count && !job->failed[i]; i++)
+		{
+			read += chunk_length(first + i);
+		}
+
+		return read;
+	}
+};
+
+// Read-only view of the uncompressed image
+class iso_compressed_file final : public fs::file_base
+{
+	std::shared_ptr<iso_compressed_image> m_image;
+	u64 m_pos = 0;
+
+public:
+	iso_compressed_file(std::shared_ptr<iso_compressed_image> image)
+		: m_image(std::move(image))
+	{
+	}
+
+	fs::stat_t get_stat() override
+	{
+		return m_image->get_stat();
+	}
+
+	bool trunc(u64 /*length*/) override
+	{
+		fs::g_tls_error = fs::error::readonly;
+		return false;
+	}
+
+	u64 read(void* buffer, u64 size) override
+	{
+		const u64 result = read_at(m_pos, buffer, size);
+		m_pos += result;
+		return result;
+	}
+
+	u64 read_at(u64 offset, void* buffer, u64 size) override
+	{
+		return m_image->read_at(offset, static_cast<u8*>(buffer), size);
+	}
+
+	u64 write(const void* /*buffer*/, u64 /*size*/) override
+	{
+		fs::g_tls_error = fs::error::readonly;
+		return 0;
+	}
+
+	u64 seek(s64 offset, fs::seek_mode whence) override
+	{
+		const s64 new_pos =
+			whence == fs::seek_set ? offset :
+			whence == fs::seek_cur ? offset + m_pos :
+			whence == fs::seek_end ? offset + size() : -1;
+
+		if (new_pos < 0)
+		{
+			fs::g_tls_error = fs::error::inval;
+			return -1;
+		}
+
+		m_pos = new_pos;
+		return m_pos;
+	}
+
+	u64 size() override
+	{
+		return m_image->size();
+	}
+};
+
+bool is_iso_compressed(const fs::file& file)
+{
+	le_t<u32> magic{};
+
+	return file && file.read_at(0, &magic, sizeof(magic)) == sizeof(magic) && magic == ISO_COMPRESSED_MAGIC;
+}
+
+fs::file open_iso_image(const std::string& path, bs_t<fs::open_mode> mode)
+{
+	fs::file file(path, mode);
+
+	if (fs::is_optical_raw_device(path) || !is_iso_compressed(file))
+	{
+		return file;
+	}
+
+	// The offset table and the chunk cache are shared by every file opened from the same image
+	static shared_mutex s_mutex;
+	static std::unordered_map<std::string, std::weak_ptr<iso_compressed_image>> s_images;
+
+	std::lock_guard lock(s_mutex);
+
+	std::shared_ptr<iso_compressed_image> image = s_images[path].lock();
+
+	if (!image)
+	{
+		std::erase_if(s_images, [](const auto& entry) { return entry.second.expired(); });
+
+		image = std::make_shared<iso_compressed_image>();
+
+		if (!image->open(path))
+		{
+			fs::g_tls_error = fs::error::unknown;
+			return {};
+		}
+
+		s_images[path] = image;
+	}
+
+	return fs::file(std::make_unique<iso_compressed_file>(std::move(image)));
+}
+
+bool compress_iso(const std::string& src_path, const std::string& dst_path, iso_compress_state& state)
+{
+	if (!is_iso_file(src_path))
+	{
+		iso_log.error("compress_iso: Failed to recognize ISO file: '%s'", src_path);
+		return false;
+	}
+
+	const fs::file src = open_iso_image(src_path);
+	fs::pending_file dst(dst_path);
+
+	if (!src || !dst.file)
+	{
+		iso_log.error("compress_iso: Failed to open files: '%s' -> '%s' (%s)", src_path, dst_path, fs::g_tls_error);
+		return false;
+	}
+
+	const u64 start_time = get_system_time();
+	const u64 chunk_size = ISO_COMPRESSED_CHUNK_SIZE;
+
+	iso_compressed_header header{};
+	header.magic = ISO_COMPRESSED_MAGIC;
+	header.version = ISO_COMPRESSED_VERSION;
+	header.chunk_size = ISO_COMPRESSED_CHUNK_SIZE;
+	header.image_size = src.size();
+	header.chunk_count = utils::aligned_div<u64>(header.image_size, chunk_size);
+
+	state.total_bytes = header.image_size;
+	state.processed_bytes = 0;
+
+	std::vector<le_t<u64>> offsets(header.chunk_count + 1);
+	offsets[0] = sizeof(header) + offsets.size() * sizeof(u64);
+
+	// The offset table is rewritten once all chunk sizes are known
+	if (dst.file.write(&header, sizeof(header)) != sizeof(header) || dst.file.write(offsets.data(), offsets.size() * sizeof(u64)) != offsets.size() * sizeof(u64))
+	{
+		iso_log.error("compress_iso: Failed to write '%s' (%s)", dst_path, fs::g_tls_error);
+		return false;
+	}
+
+	// Chunks are read and written in order, and compressed in parallel in between
+	const u32 thread_count = std::min<u32>(utils::get_thread_count(), 16);
+	const u64 batch_chunks = thread_count * 16ull;
+
+	std::vector<u8> input(batch_chunks * chunk_size);
+	std::vector<std::vector<u8>> output(batch_chunks);
+
+	for (u64 first = 0; first < header.chunk_count; first += batch_chunks)
+	{
+		if (state.cancelled)
+		{
+			iso_log.notice("compress_iso: Cancelled");
+			return false;
+		}
+
+		const u64 count = std::min<u64>(batch_chunks, header.chunk_count - first);
+		const u64 input_size = std::min<u64>(count * chunk_size, header.image_size - first * chunk_size);
+
+		if (src.read_at(first * chunk_size, input.data(), input_size) != input_size)
+		{
+			iso_log.error("compress_iso: Failed to read '%s' at 0x%llx", src_path, first * chunk_size);
+			return false;
+		}
+
+		atomic_t<u64> next_chunk = 0;
+
+		named_thread_group workers("ISO Compressor"sv, static_cast<u32>(std::min<u64>(thread_count, count)), [&]()
+		{
+			for (u64 i = next_chunk++; i < count; i = next_chunk++)
+			{
+				const u8* data = input.data() + i * chunk_size;
+				const u64 length = std::min<u64>(chunk_size, input_size - i * chunk_size);
+
+				std::vector<u8>& out = output[i];
+				out.resize(ZSTD_compressBound(length));
+
+				const usz result = ZSTD_compressCCtx(get_cctx(), out.data(), out.size(), data, length, s_compression_level);
+
+				if (ZSTD_isError(result) || result >= length)
+				{
+					// Incompressible (e.g. encrypted regions), store as is
+					out.assign(data, data + length);
+				}
+				else
+				{
+					out.resize(result);
+				}
+			}
+		});
+
+		workers.join();
+
+		for (u64 i = 0; i < count; i++)
+		{
+			if (dst.file.write(output[i].data(), output[i].size()) != output[i].size())
+			{
+				iso_log.error("compress_iso: Failed to write '%s' (%s)", dst_path, fs::g_tls_error);
+				return false;
+			}
+
+			offsets[first + i + 1] = offsets[first + i] + output[i].size();
+		}
+
+		state.processed_bytes += input_size;
+	}
+
+	dst.file.seek(sizeof(header));
+
+	if (dst.file.write(offsets.data(), offsets.size() * sizeof(u64)) != offsets.size() * sizeof(u64) || !dst.commit())
+	{
+		iso_log.error("compress_iso: Failed to write '%s' (%s)", dst_path, fs::g_tls_error);
+		return false;
+	}
+
+	const f64 seconds = std::max<f64>((get_system_time() - start_time) / 1'000'000., 0.001);
+	const u64 compressed_size = offsets.back();
+
+	iso_log.success("Compressed '%s' to '%s': %u MiB -> %u MiB (%.1f%%) in %.2f seconds", src_path, dst_path,
+		header.image_size / 0x100000, compressed_size / 0x100000, compressed_size * 100. / std::max<u64>(header.image_size, 1), seconds);
+
+	return true;
+}
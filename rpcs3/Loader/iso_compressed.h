@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Utilities/File.h"
+#include "util/types.hpp"
+#include "util/endian.hpp"
+#include "util/atomic.hpp"
+
+/*
+- Seekable block-compressed disc image (".rzi")
+  The image is split into fixed-size chunks which are compressed independently with zstd, so any range can be read
+  by decompressing only the chunks covering it. Chunks which do not shrink (e.g. encrypted regions) are stored as is.
+
+  Layout:
+  - iso_compressed_header
+  - Offset table: chunk_count + 1 little-endian u64 file offsets, chunk N is stored in [offset[N], offset[N + 1])
+  - Chunk data
+
+- The uncompressed image is exposed as a regular read-only file, so the ISO9660 parser, the encrypted region map in
+  sector 0 and the Redump/3k3y decryption all work the same as with a plain ".iso" file.
+*/
+
+constexpr u32 ISO_COMPRESSED_MAGIC = "RZI\0"_u32;
+constexpr u32 ISO_COMPRESSED_VERSION = 1;
+
+// Default uncompressed chunk size, a multiple of the ISO sector size
+constexpr u32 ISO_COMPRESSED_CHUNK_SIZE = 0x10000;
+
+struct iso_compressed_header
+{
+	le_t<u32> magic;
+	le_t<u32> version;
+	le_t<u32> chunk_size;
+	le_t<u32> reserved;
+	le_t<u64> image_size;
+	le_t<u64> chunk_count;
+};
+
+// Progress of compress_iso, can be read from another thread
+struct iso_compress_state
+{
+	atomic_t<u64> processed_bytes = 0;
+	atomic_t<u64> total_bytes = 0;
+	atomic_t<bool> cancelled = false;
+};
+
+// Checks the file header for the compressed image format
+bool is_iso_compressed(const fs::file& file);
+
+// Opens a disc image. Compressed images are returned as a read-only view of the uncompressed image.
+fs::file open_iso_image(const std::string& path, bs_t<fs::open_mode> mode = fs::read);
+
+// Converts a plain ISO image into the compressed image format
+bool compress_iso(const std::string& src_path, const std::string& dst_path, iso_compress_state& state);
@@ -0,0 +1,860 @@
+#include "stdafx.h"
+
+#include "pkg_device.h"
+#include "Crypto/unedat.h"
+#include "Crypto/key_vault.h"
+#include "Emu/VFS.h"
+#include "Emu/system_utils.hpp"
+#include "Utilities/Thread.h"
+
+#include <array>
+
+LOG_CHANNEL(sys_log, "SYS");
+LOG_CHANNEL(pkg_log, "PKG");
+
+// Entries are decrypted in blocks of this size, games tend to read small pieces of the same block
+constexpr u64 PKG_CACHE_BLOCK_SIZE = 0x10000;
+constexpr usz PKG_CACHE_BLOCK_COUNT = 32;
+
+// Larger reads are decrypted directly into the destination
+constexpr u64 PKG_CACHE_BYPASS_SIZE = 0x40000;
+
+struct pkg_data
+{
+	struct cached_block
+	{
+		u64 key = umax;
+		u64 size = 0;
+		u64 last_use = 0;
+		std::vector<u8> data;
+	};
+
+	package_reader reader;
+
+	shared_mutex mutex;
+	std::array<cached_block, PKG_CACHE_BLOCK_COUNT> cache{};
+	u64 use_counter = 0;
+
+	pkg_data(const std::string& path)
+		: reader(path)
+	{
+	}
+
+	u64 read(const package_reader::entry_info& entry, u64 pos, void* buffer, u64 size);
+};
+
+u64 pkg_data::read(const package_reader::entry_info& entry, u64 pos, void* buffer, u64 size)
+{
+	if (pos >= entry.file_size)
+	{
+		return 0;
+	}
+
+	size = std::min<u64>(size, entry.file_size - pos);
+
+	const bool is_psp = (entry.type & PKG_FILE_ENTRY_PSP) != 0u;
+
+	if (size >= PKG_CACHE_BYPASS_SIZE)
+	{
+		return reader.read_data(entry.file_offset + pos, buffer, size, is_psp);
+	}
+
+	u64 done = 0;
+
+	while (done < size)
+	{
+		const u64 address = entry.file_offset + pos + done;
+		const u64 block = address / PKG_CACHE_BLOCK_SIZE;
+		const u64 key = (block << 1) | (is_psp ? 1 : 0);
+		const u64 offset = address % PKG_CACHE_BLOCK_SIZE;
+		const u64 to_copy = std::min<u64>(PKG_CACHE_BLOCK_SIZE - offset, size - done);
+
+		bool found = false;
+
+		{
+			std::lock_guard lock(mutex);
+
+			for (cached_block& cached : cache)
+			{
+				if (cached.key == key)
+				{
+					cached.last_use = ++use_counter;
+
+					if (offset < cached.size)
+					{
+						const u64 copied = std::min<u64>(to_copy, cached.size - offset);
+						std::memcpy(static_cast<u8*>(buffer) + done, cached.data.data() + offset, copied);
+						done += copied;
+
+						if (copied != to_copy)
+						{
+							// End of the package
+							return done;
+						}
+					}
+
+					found = true;
+					break;
+				}
+			}
+		}
+
+		if (found)
+		{
+			continue;
+		}
+
+		// Decrypt outside of the lock, another thread may race for the same block which is harmless
+		std::vector<u8> data(PKG_CACHE_BLOCK_SIZE);
+		const u64 block_size = reader.read_data(block * PKG_CACHE_BLOCK_SIZE, data.data(), PKG_CACHE_BLOCK_SIZE, is_psp);
+
+		if (block_size <= offset)
+		{
+			break;
+		}
+
+		const u64 copied = std::min<u64>(to_copy, block_size - offset);
+		std::memcpy(static_cast<u8*>(buffer) + done, data.data() + offset, copied);
+		done += copied;
+
+		{
+			std::lock_guard lock(mutex);
+
+			cached_block& victim = *std::min_element(cache.begin(), cache.end(), [](const cached_block& a, const cached_block& b)
+			{
+				return a.last_use < b.last_use;
+			});
+
+			victim.key = key;
+			victim.size = block_size;
+			victim.last_use = ++use_counter;
+			victim.data = std::move(data);
+		}
+
+		if (copied != to_copy)
+		{
+			break;
+		}
+	}
+
+	return done;
+}
+
+// Read-only view of a single package entry
+class pkg_entry_file : public fs::file_base
+{
+	std::shared_ptr<pkg_data> m_data;
+	package_reader::entry_info m_entry;
+	s64 m_mtime = 0;
+	u64 m_pos = 0;
+
+public:
+	pkg_entry_file(std::shared_ptr<pkg_data> data, package_reader::entry_info entry, s64 mtime)
+		: m_data(std::move(data))
+		, m_entry(std::move(entry))
+		, m_mtime(mtime)
+	{
+	}
+
+	fs::stat_t get_stat() override
+	{
+		return fs::stat_t
+		{
+			.is_directory = false,
+			.is_symlink = false,
+			.is_writable = false,
+			.size = m_entry.file_size,
+			.atime = m_mtime,
+			.mtime = m_mtime,
+			.ctime = m_mtime
+		};
+	}
+
+	bool trunc(u64) override
+	{
+		fs::g_tls_error = fs::error::readonly;
+		return false;
+	}
+
+	u64 read(void* buffer, u64 size) override
+	{
+		const u64 result = read_at(m_pos, buffer, size);
+		m_pos += result;
+		return result;
+	}
+
+	u64 read_at(u64 offset, void* buffer, u64 size) override
+	{
+		return m_data->read(m_entry, offset, buffer, size);
+	}
+
+	u64 write(const void*, u64) override
+	{
+		fs::g_tls_error = fs::error::readonly;
+		return 0;
+	}
+
+	u64 seek(s64 offset, fs::seek_mode whence) override
+	{
+		const s64 new_pos =
+			whence == fs::seek_set ? offset :
+			whence == fs::seek_cur ? offset + m_pos :
+			whence == fs::seek_end ? offset + size() : -1;
+
+		if (new_pos < 0)
+		{
+			fs::g_tls_error = fs::error::inval;
+			return -1;
+		}
+
+		m_pos = new_pos;
+		return m_pos;
+	}
+
+	u64 size() override
+	{
+		return m_entry.file_size;
+	}
+
+	fs::file_id get_id() override
+	{
+		fs::file_id id{};
+
+		id.type.insert(0, "pkg_entry_file: "sv);
+		return id;
+	}
+};
+
+// Directory listing merged from the package and the host overlay
+class pkg_dir : public fs::dir_base
+{
+	std::vector<fs::dir_entry> m_entries;
+	usz m_pos = 0;
+
+public:
+	pkg_dir(std::vector<fs::dir_entry> entries)
+		: m_entries(std::move(entries))
+	{
+	}
+
+	bool read(fs::dir_entry& entry) override
+	{
+		if (m_pos < m_entries.size())
+		{
+			entry = m_entries[m_pos++];
+			return true;
+		}
+
+		return false;
+	}
+
+	void rewind() override
+	{
+		m_pos = 0;
+	}
+};
+
+pkg_device::pkg_device(const std::string& pkg_path, const std::string& device_name)
+	: m_path(pkg_path)
+	, m_data(std::make_shared<pkg_data>(pkg_path))
+{
+	fs_prefix = device_name;
+
+	package_reader& reader = m_data->reader;
+
+	if (!reader.is_valid())
+	{
+		return;
+	}
+
+	switch (reader.get_metadata().content_type)
+	{
+	case PKG_CONTENT_TYPE_THEME:
+	case PKG_CONTENT_TYPE_WIDGET:
+	case PKG_CONTENT_TYPE_LICENSE:
+	case PKG_CONTENT_TYPE_VSH_MODULE:
+	case PKG_CONTENT_TYPE_PSN_AVATAR:
+	case PKG_CONTENT_TYPE_VMC:
+	{
+		pkg_log.error("Packages of content type 0x%x cannot be mounted: '%s'", reader.get_metadata().content_type, pkg_path);
+		return;
+	}
+	default:
+	{
+		break;
+	}
+	}
+
+	m_install_dir = reader.get_install_dir();
+
+	if (m_install_dir.empty() || m_install_dir == "." || m_install_dir == ".." || m_install_dir.find_first_of("/\\") != umax)
+	{
+		pkg_log.error("Invalid installation directory '%s': '%s'", m_install_dir, pkg_path);
+		return;
+	}
+
+	if (!reader.get_entries(m_entries))
+	{
+		pkg_log.error("Failed to read the package entries: '%s'", pkg_path);
+		return;
+	}
+
+	m_nodes[""].children.push_back(m_install_dir);
+	m_nodes[m_install_dir];
+
+	for (usz i = 0; i < m_entries.size(); i++)
+	{
+		const auto& entry = m_entries[i];
+
+		std::string path = m_install_dir;
+		bool is_valid_path = true;
+
+		for (std::string_view name = entry.name; is_valid_path && !name.empty();)
+		{
+			const usz pos = name.find_first_of('/');
+			const std::string_view component = name.substr(0, pos);
+			name = pos == umax ? std::string_view{} : name.substr(pos + 1);
+
+			if (component.empty() || component == ".")
+			{
+				continue;
+			}
+
+			pkg_node& parent = ::at32(m_nodes, path);
+
+			if (component == ".." || parent.entry != umax)
+			{
+				is_valid_path = false;
+				break;
+			}
+
+			path += '/';
+			path += component;
+
+			if (m_nodes.try_emplace(path).second)
+			{
+				parent.children.emplace_back(component);
+			}
+		}
+
+		if (!is_valid_path)
+		{
+			pkg_log.error("Skipped entry with invalid path: '%s'", entry.name);
+			continue;
+		}
+
+		const u8 entry_type = entry.type & 0xff;
+
+		if (entry_type == PKG_FILE_ENTRY_FOLDER || entry_type == 0x12)
+		{
+			continue;
+		}
+
+		pkg_node& node = ::at32(m_nodes, path);
+
+		if (path == m_install_dir || !node.children.empty())
+		{
+			pkg_log.error("Skipped file entry conflicting with a directory: '%s'", entry.name);
+			continue;
+		}
+
+		node.entry = i;
+	}
+
+	m_overlay_dir = rpcs3::utils::get_hdd0_dir() + "game/";
+
+	fs::stat_t info{};
+
+	if (fs::get_stat(pkg_path, info))
+	{
+		m_mtime = info.mtime;
+	}
+
+	m_is_valid = true;
+}
+
+pkg_device::~pkg_device()
+{
+}
+
+std::string pkg_device::get_relative_path(std::string_view path) const
+{
+	if (path.starts_with(fs_prefix))
+	{
+		path.remove_prefix(fs_prefix.size());
+	}
+
+	std::vector<std::string_view> components;
+
+	while (!path.empty())
+	{
+		const usz pos = path.find_first_of("/\\");
+		const std::string_view component = path.substr(0, pos);
+		path = pos == umax ? std::string_view{} : path.substr(pos + 1);
+
+		if (component.empty() || component == ".")
+		{
+			continue;
+		}
+
+		if (component == "..")
+		{
+			if (!components.empty())
+			{
+				components.pop_back();
+			}
+
+			continue;
+		}
+
+		components.push_back(component);
+	}
+
+	return fmt::merge(components, "/");
+}
+
+std::string pkg_device::get_host_path(std::string_view relative_path) const
+{
+	return m_overlay_dir + vfs::escape(relative_path);
+}
+
+bool pkg_device::is_writable_path(std::string_view relative_path) const
+{
+	// Only the contents of the installation directory can be modified
+	return relative_path.size() > m_install_dir.size() && relative_path.starts_with(m_install_dir) && relative_path[m_install_dir.size()] == '/';
+}
+
+const pkg_device::pkg_node* pkg_device::find_node(std::string_view relative_path) const
+{
+	const auto found = m_nodes.find(relative_path);
+
+	return found != m_nodes.end() ? &found->second : nullptr;
+}
+
+fs::file pkg_device::open_entry(const package_reader::entry_info& entry) const
+{
+	fs::file result;
+	result.reset(std::make_unique<pkg_entry_file>(m_data, entry, m_mtime));
+
+	if ((entry.type & 0xff) == PKG_FILE_ENTRY_SDAT)
+	{
+		// Same key selection as DecryptEDAT() during installation
+		u128 devklic{};
+		std::memcpy(&devklic, NP_KLIC_FREE, sizeof(devklic));
+
+		auto sdat = std::make_unique<EDATADecrypter>(std::move(result), devklic, entry.name, false);
+
+		if (!sdat->ReadHeader())
+		{
+			pkg_log.error("Failed to decrypt SDAT entry '%s'", entry.name);
+			fs::g_tls_error = fs::error::inval;
+			return {};
+		}
+
+		result.reset(std::move(sdat));
+	}
+
+	return result;
+}
+
+bool pkg_device::materialize(const std::string& relative_path)
+{
+	const std::string host_path = get_host_path(relative_path);
+
+	std::lock_guard lock(m_overlay_mutex);
+
+	if (fs::is_file(host_path))
+	{
+		return true;
+	}
+
+	const pkg_node* node = find_node(relative_path);
+
+	if (!node || node->entry == umax)
+	{
+		fs::g_tls_error = fs::error::noent;
+		return false;
+	}
+
+	fs::file in = open_entry(::at32(m_entries, node->entry));
+
+	if (!in)
+	{
+		return false;
+	}
+
+	if (!fs::create_path(fs::get_parent_dir(host_path)))
+	{
+		pkg_log.error("Failed to create the overlay directory for '%s' (error=%s)", host_path, fs::g_tls_error);
+		return false;
+	}
+
+	fs::pending_file out(host_path);
+
+	if (!out.file)
+	{
+		pkg_log.error("Failed to create overlay file '%s' (error=%s)", host_path, fs::g_tls_error);
+		return false;
+	}
+
+	std::vector<u8> buffer(PKG_CACHE_BYPASS_SIZE * 16);
+
+	while (const u64 read_size = in.read(buffer.data(), buffer.size()))
+	{
+		if (out.file.write(buffer.data(), read_size) != read_size)
+		{
+			pkg_log.error("Failed to write overlay file '%s' (error=%s)", host_path, fs::g_tls_error);
+			return false;
+		}
+	}
+
+	if (!out.commit())
+	{
+		pkg_log.error("Failed to commit overlay file '%s' (error=%s)", host_path, fs::g_tls_error);
+		return false;
+	}
+
+	pkg_log.notice("Copied '%s' to the overlay", relative_path);
+	return true;
+}
+
+bool pkg_device::stat(const std::string& path, fs::stat_t& info)
+{
+	const std::string relative_path = get_relative_path(path);
+
+	if (is_writable_path(relative_path) && fs::get_stat(get_host_path(relative_path), info))
+	{
+		return true;
+	}
+
+	const pkg_node* node = find_node(relative_path);
+
+	if (!node)
+	{
+		fs::g_tls_error = fs::error::noent;
+		return false;
+	}
+
+	u64 size = 0;
+
+	if (node->entry != umax)
+	{
+		// SDAT entries are exposed decrypted
+		fs::file file = open_entry(::at32(m_entries, node->entry));
+
+		if (!file)
+		{
+			return false;
+		}
+
+		size = file.size();
+	}
+
+	info = fs::stat_t
+	{
+		.is_directory = node->entry == umax,
+		.is_symlink = false,
+		.is_writable = false,
+		.size = size,
+		.atime = m_mtime,
+		.mtime = m_mtime,
+		.ctime = m_mtime
+	};
+
+	return true;
+}
+
+bool pkg_device::statfs(const std::string& path, fs::device_stat& info)
+{
+	const std::string relative_path = get_relative_path(path);
+
+	if (!find_node(relative_path) && !(is_writable_path(relative_path) && fs::exists(get_host_path(relative_path))))
+	{
+		fs::g_tls_error = fs::error::noent;
+		return false;
+	}
+
+	// Free space is the free space of the overlay
+	return fs::statfs(m_overlay_dir, info);
+}
+
+bool pkg_device::remove_dir(const std::string& path)
+{
+	const std::string relative_path = get_relative_path(path);
+
+	if (find_node(relative_path) || !is_writable_path(relative_path))
+	{
+		fs::g_tls_error = fs::error::readonly;
+		return false;
+	}
+
+	return fs::remove_dir(get_host_path(relative_path));
+}
+
+bool pkg_device::create_dir(const std::string& path)
+{
+	const std::string relative_path = get_relative_path(path);
+
+	if (find_node(relative_path))
+	{
+		fs::g_tls_error = fs::error::exist;
+		return false;
+	}
+
+	if (!is_writable_path(relative_path))
+	{
+		fs::g_tls_error = fs::error::readonly;
+		return false;
+	}
+
+	// Parent directories which only exist in the package are created on the host
+	const std::string host_path = get_host_path(relative_path);
+	const std::string parent = get_relative_path(fs::get_parent_dir(relative_path));
+
+	if (const pkg_node* node = find_node(parent); node && node->entry == umax && !fs::create_path(fs::get_parent_dir(host_path)))
+	{
+		return false;
+	}
+
+	return fs::create_dir(host_path);
+}
+
+bool pkg_device::rename(const std::string& from, const std::string& to)
+{
+	const std::string relative_from = get_relative_path(from);
+	const std::string relative_to = get_relative_path(to);
+
+	// Files from the package cannot be moved, there is no way to hide the original
+	if (find_node(relative_from) || find_node(relative_to) || !is_writable_path(relative_from) || !is_writable_path(relative_to))
+	{
+		fs::g_tls_error = fs::error::readonly;
+		return false;
+	}
+
+	return fs::rename(get_host_path(relative_from), get_host_path(relative_to), true);
+}
+
+bool pkg_device::remove(const std::string& path)
+{
+	const std::string relative_path = get_relative_path(path);
+
+	if (find_node(relative_path) || !is_writable_path(relative_path))
+	{
+		fs::g_tls_error = fs::error::readonly;
+		return false;
+	}
+
+	return fs::remove_file(get_host_path(relative_path));
+}
+
+bool pkg_device::trunc(const std::string& path, u64 length)
+{
+	const std::string relative_path = get_relative_path(path);
+
+	if (!is_writable_path(relative_path))
+	{
+		fs::g_tls_error = fs::error::readonly;
+		return false;
+	}
+
+	if (const pkg_node* node = find_node(relative_path); node && node->entry != umax && !materialize(relative_path))
+	{
+		return false;
+	}
+
+	return fs::truncate_file(get_host_path(relative_path), length);
+}
+
+bool pkg_device::utime(const std::string& path, s64 atime, s64 mtime)
+{
+	const std::string relative_path = get_relative_path(path);
+
+	if (!is_writable_path(relative_path))
+	{
+		fs::g_tls_error = fs::error::readonly;
+		return false;
+	}
+
+	if (const pkg_node* node = find_node(relative_path); node && node->entry != umax && !materialize(relative_path))
+	{
+		return false;
+	}
+
+	return fs::utime(get_host_path(relative_path), atime, mtime);
+}
+
+std::unique_ptr<fs::file_base> pkg_device::open(const std::string& path, bs_t<fs::open_mode> mode)
+{
+	const std::string relative_path = get_relative_path(path);
+	const pkg_node* node = find_node(relative_path);
+
+	if (node && node->entry == umax)
+	{
+		fs::g_tls_error = fs::error::isdir;
+		return nullptr;
+	}
+
+	const bool is_writable = is_writable_path(relative_path);
+	const std::string host_path = is_writable ? get_host_path(relative_path) : std::string{};
+
+	if (!(mode & fs::write) || !is_writable)
+	{
+		if (is_writable && fs::is_file(host_path))
+		{
+			return fs::file(host_path, mode).release();
+		}
+
+		if (mode & fs::write)
+		{
+			fs::g_tls_error = fs::error::readonly;
+			return nullptr;
+		}
+
+		if (!node)
+		{
+			fs::g_tls_error = fs::error::noent;
+			return nullptr;
+		}
+
+		return open_entry(::at32(m_entries, node->entry)).release();
+	}
+
+	if (node)
+	{
+		if (mode & fs::excl)
+		{
+			fs::g_tls_error = fs::error::exist;
+			return nullptr;
+		}
+
+		// Copy-on-write, skipped when the contents are discarded anyway
+		if (!(mode & fs::trunc) && !materialize(relative_path))
+		{
+			return nullptr;
+		}
+	}
+
+	if (!fs::create_path(fs::get_parent_dir(host_path)))
+	{
+		return nullptr;
+	}
+
+	return fs::file(host_path, node ? mode + fs::create : mode).release();
+}
+
+std::unique_ptr<fs::dir_base> pkg_device::open_dir(const std::string& path)
+{
+	const std::string relative_path = get_relative_path(path);
+	const pkg_node* node = find_node(relative_path);
+
+	if (node && node->entry != umax)
+	{
+		// fs::dir_base should return ENOTDIR when path is pointing to a file instead of a folder.
+		fs::g_tls_error = fs::error::notdir;
+		return nullptr;
+	}
+
+	std::vector<fs::dir_entry> entries;
+
+	if (is_writable_path(relative_path) || relative_path == m_install_dir)
+	{
+		// Overlay entries take precedence
+		if (fs::dir host_dir{get_host_path(relative_path)})
+		{
+			for (const fs::dir_entry& entry : host_dir)
+			{
+				if (entry.name != "." && entry.name != "..")
+				{
+					entries.push_back(entry);
+				}
+			}
+		}
+		else if (!node)
+		{
+			return nullptr;
+		}
+	}
+	else if (!node)
+	{
+		fs::g_tls_error = fs::error::noent;
+		return nullptr;
+	}
+
+	if (node)
+	{
+		const usz overlay_count = entries.size();
+
+		for (const std::string& name : node->children)
+		{
+			if (std::any_of(entries.begin(), entries.begin() + overlay_count, [&](const fs::dir_entry& entry) { return entry.name == name; }))
+			{
+				continue;
+			}
+
+			fs::dir_entry entry{};
+
+			if (!stat(fs_prefix + "/" + (relative_path.empty() ? name : relative_path + "/" + name), entry))
+			{
+				continue;
+			}
+
+			entry.name = name;
+			entries.push_back(std::move(entry));
+		}
+	}
+
+	return std::make_unique<pkg_dir>(std::move(entries));
+}
+
+bool is_pkg_file(const std::string& path)
+{
+	fs::file file(path);
+
+	if (!file)
+	{
+		return false;
+	}
+
+	le_t<u32> magic{};
+
+	return file.read(magic) && magic == std::bit_cast<le_t<u32>>("\x7FPKG"_u32);
+}
+
+bool load_pkg(const std::string& path, std::string& boot_path)
+{
+	sys_log.notice("Loading PKG '%s'", path);
+
+	unload_pkg();
+
+	const auto device = stx::make_shared<pkg_device>(path);
+
+	if (!device->is_valid())
+	{
+		sys_log.error("Failed to mount PKG '%s'", path);
+		return false;
+	}
+
+	boot_path = pkg_device::virtual_device_name + "/" + device->get_install_dir() + "/USRDIR/EBOOT.BIN";
+
+	if (!fs::set_virtual_device("pkg_overlay_fs_dev", device))
+	{
+		return false;
+	}
+
+	if (!fs::is_file(boot_path))
+	{
+		sys_log.error("PKG '%s' does not contain an executable", path);
+		unload_pkg();
+		return false;
+	}
+
+	return true;
+}
+
+void unload_pkg()
+{
+	if (fs::set_virtual_device("pkg_overlay_fs_dev", stx::shared_ptr<pkg_device>()))
+	{
+		sys_log.notice("Unloading PKG");
+	}
+}
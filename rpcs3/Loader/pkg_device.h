@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Crypto/unpkg.h"
+#include "Utilities/File.h"
+#include "Utilities/mutex.h"
+
+#include <map>
+
+/*
+- Mounts a game package as /dev_hdd0/game/<INSTALL_DIR>/ without installing it.
+  Entries are decrypted on demand through a small block cache, SDAT entries are decrypted when opened.
+
+- The package is read-only. Anything the game writes goes to the real installation directory on the host,
+  which overlays the package: files are copied out of the package the first time they are opened for writing.
+*/
+
+struct pkg_data;
+
+class pkg_device : public fs::device_base
+{
+	struct pkg_node
+	{
+		usz entry = umax; // Index in m_entries, umax for directories
+		std::vector<std::string> children;
+	};
+
+	std::string m_path;
+
+	// Package reader and block cache, shared with the files opened from the device
+	std::shared_ptr<pkg_data> m_data;
+	std::vector<package_reader::entry_info> m_entries;
+	std::string m_install_dir;
+
+	// Keyed by the path relative to the device root, which starts with the installation directory ("" is the root)
+	std::map<std::string, pkg_node, std::less<>> m_nodes;
+
+	// Host directory overlaying the device root, the parent of the real installation directory
+	std::string m_overlay_dir;
+	shared_mutex m_overlay_mutex;
+
+	s64 m_mtime = 0;
+	bool m_is_valid = false;
+
+	std::string get_relative_path(std::string_view path) const;
+	std::string get_host_path(std::string_view relative_path) const;
+	bool is_writable_path(std::string_view relative_path) const;
+	const pkg_node* find_node(std::string_view relative_path) const;
+	fs::file open_entry(const package_reader::entry_info& entry) const;
+	bool materialize(const std::string& relative_path);
+
+public:
+	inline static std::string virtual_device_name = "/vfsv0_virtual_pkg_overlay_fs_dev";
+
+	pkg_device(const std::string& pkg_path, const std::string& device_name = virtual_device_name);
+	~pkg_device() override;
+
+	bool is_valid() const { return m_is_valid; }
+	const std::string& get_loaded_pkg() const { return m_path; }
+	const std::string& get_install_dir() const { return m_install_dir; }
+
+	bool stat(const std::string& path, fs::stat_t& info) override;
+	bool statfs(const std::string& path, fs::device_stat& info) override;
+	bool remove_dir(const std::string& path) override;
+	bool create_dir(const std::string& path) override;
+	bool rename(const std::string& from, const std::string& to) override;
+	bool remove(const std::string& path) override;
+	bool trunc(const std::string& path, u64 length) override;
+	bool utime(const std::string& path, s64 atime, s64 mtime) override;
+
+	std::unique_ptr<fs::file_base> open(const std::string& path, bs_t<fs::open_mode> mode) override;
+	std::unique_ptr<fs::dir_base> open_dir(const std::string& path) override;
+};
+
+bool is_pkg_file(const std::string& path);
+
+// Mounts the package and returns the path of its executable on the virtual device
+bool load_pkg(const std::string& path, std::string& boot_path);
+void unload_pkg();
@@ -28,6 +28,7 @@
 #include "util/console.h"
 #include "util/asm.hpp"
 #include "Crypto/decrypt_binaries.h"
+#include "Loader/iso_compressed.h"
 #ifdef _WIN32
 #include "module_verifier.hpp"
 #include "util/dyn_lib.hpp"
@@ -390,6 +391,8 @@ private:
 // Arguments that force a headless application (need to be checked in create_application)
 constexpr auto arg_headless       = "headless";
 constexpr auto arg_decrypt        = "decrypt";
+constexpr auto arg_compress_iso   = "compress-iso";
+constexpr auto arg_rsx_benchmark  = "rsx-benchmark";
 
 // Arguments that can be used with a gui application
 constexpr auto arg_no_gui         = "no-gui";
@@ -445,7 +448,9 @@ QCoreApplication* create_application(std::span<char* const> qt_argv)
 	static char** const s_argv = const_cast<char**>(qt_argv.data());
 
 	if (find_arg(arg_headless, qt_argv) != -1 ||
-		find_arg(arg_decrypt, qt_argv) != -1)
+		find_arg(arg_decrypt, qt_argv) != -1 ||
+		find_arg(arg_compress_iso, qt_argv) != -1 ||
+		find_arg(arg_rsx_benchmark, qt_argv) != -1)
 	{
 		return new headless_application(s_argc, s_argv);
 	}
@@ -840,6 +845,8 @@ int run_rpcs3(int argc, char** argv)
 	parser.addOption(installpkg_option);
 	const QCommandLineOption decrypt_option(arg_decrypt, "Decrypt PS3 binaries.", "path(s)", "");
 	parser.addOption(decrypt_option);
+	const QCommandLineOption compress_iso_option(arg_compress_iso, "Convert ISO images into the compressed .rzi format.", "path(s)", "");
+	parser.addOption(compress_iso_option);
 	const QCommandLineOption user_id_option(arg_user_id, "Start RPCS3 as this user.", "user id", "");
 	parser.addOption(user_id_option);
 	const QCommandLineOption savestate_option(arg_savestate, "Path for directly loading a savestate.", "path", "");
@@ -848,6 +855,8 @@ int run_rpcs3(int argc, char** argv)
 	parser.addOption(last_savestate_option);
 	const QCommandLineOption rsx_capture_option(arg_rsx_capture, "Path for directly loading an rsx capture.", "path", "");
 	parser.addOption(rsx_capture_option);
+	const QCommandLineOption rsx_benchmark_option(arg_rsx_benchmark, "Replay the rsx capture this many times on the null renderer and report CPU timings.", "loops", "");
+	parser.addOption(rsx_benchmark_option);
 	parser.addOption(QCommandLineOption(arg_q_debug, "Log qDebug to RPCS3.log."));
 	parser.addOption(QCommandLineOption(arg_error, "For internal usage."));
 	parser.addOption(QCommandLineOption(arg_updating, "For internal usage."));
@@ -1148,6 +1157,61 @@ int run_rpcs3(int argc, char** argv)
 		return 0;
 	}
 
+	if (parser.isSet(arg_compress_iso))
+	{
+		utils::attach_console(utils::console_stream::std_out, true);
+
+		for (const QString& iso : parser.values(compress_iso_option))
+		{
+			const QFileInfo fi(iso);
+			if (!fi.isFile())
+			{
+				std::cout << "Not a file: " << iso.toStdString() << std::endl;
+				return 1;
+			}
+
+			const std::string src_path = fi.absoluteFilePath().toStdString();
+			const std::string dst_path = (fi.absolutePath() + "/" + fi.completeBaseName() + ".rzi").toStdString();
+
+			if (fs::is_file(dst_path))
+			{
+				std::cout << "File already exists: " << dst_path << std::endl;
+				return 1;
+			}
+
+			std::cout << "Compressing " << src_path << " to " << dst_path << std::endl;
+
+			iso_compress_state state;
+			atomic_t<bool> finished = false;
+			bool success = false;
+
+			named_thread worker("ISO Compression"sv, [&]()
+			{
+				success = compress_iso(src_path, dst_path, state);
+				finished = true;
+			});
+
+			while (!finished)
+			{
+				const u64 total = state.total_bytes;
+				std::cout << "\r" << (total ? state.processed_bytes * 100 / total : 0) << "%" << std::flush;
+				std::this_thread::sleep_for(500ms);
+			}
+
+			std::cout << "\r";
+
+			if (!success)
+			{
+				std::cout << "Failed to compress " << src_path << ", see the log for details." << std::endl;
+				return 1;
+			}
+
+			std::cout << "Done." << std::endl;
+		}
+
+		return 0;
+	}
+
 	// Force install firmware or pkg first if specified through command-line
 	if (parser.isSet(arg_installfw) || parser.isSet(arg_installpkg))
 	{
@@ -1194,6 +1258,11 @@ int run_rpcs3(int argc, char** argv)
 		}
 	}
 
+	if (parser.isSet(arg_rsx_benchmark) && !parser.isSet(arg_rsx_capture))
+	{
+		report_fatal_error(fmt::format("The option '%s' can only be used in combination with '%s'.", arg_rsx_benchmark, arg_rsx_capture));
+	}
+
 	if (parser.isSet(arg_savestate) || parser.isSet(arg_last_savestate))
 	{
 		std::string savestate_path;
@@ -1241,9 +1310,22 @@ int run_rpcs3(int argc, char** argv)
 			report_fatal_error(fmt::format("No rsx capture file found: %s", rsx_capture_path));
 		}
 
-		Emu.CallFromMainThread([path = rsx_capture_path]()
+		u32 benchmark_loops = 0;
+
+		if (parser.isSet(arg_rsx_benchmark))
+		{
+			bool ok = false;
+			benchmark_loops = parser.value(rsx_benchmark_option).toUInt(&ok);
+
+			if (!ok || benchmark_loops == 0)
+			{
+				report_fatal_error(fmt::format("Invalid rsx benchmark loop count: %s", parser.value(rsx_benchmark_option)));
+			}
+		}
+
+		Emu.CallFromMainThread([path = rsx_capture_path, benchmark_loops]()
 		{
-			if (!Emu.BootRsxCapture(path))
+			if (!Emu.BootRsxCapture(path, benchmark_loops))
 			{
 				sys_log.error("Booting rsx capture '%s' failed", path);
 
@@ -403,26 +403,35 @@ void game_list_actions::ShowGameIntegrityDialog(content_file_type file_type, con
 	{
 		thread_base::set_name("Game Integrity");
 
-		content_file_type file_type = type;
 		QString text_result;
-		std::string db_id, hash, game_name;
+		std::string game_name;
 		bool info_dialog = true;
 
-		for (int i = 0; i < path_list.size(); i++)
+		struct check_entry
 		{
+			content_file_type file_type = content_file_type::ISO;
+			std::string db_id;
 			bool use_fallback_db = false; // Set to "true" only for ".rap" and ".edat"
+		};
+
+		std::vector<check_entry> entries(path_list.size());
+		std::vector<std::string> paths;
 
-			if (file_type == content_file_type::ISO)
+		for (int i = 0; i < path_list.size(); i++)
+		{
+			check_entry& entry = entries[i];
+
+			if (type == content_file_type::ISO)
 			{
-				db_id = "REDUMP";
+				entry.db_id = "REDUMP";
 			}
 			else if (path_list[i].endsWith(".rap", Qt::CaseInsensitive) || path_list[i].endsWith(".edat", Qt::CaseInsensitive))
 			{
 				// NOTE: This is the default type for any ".rap" and ".edat" due to it's not possible to detect the type by file parsing.
 				//       If no match for ".rap" or ".edat" will be found on default "PSN Content" DB, we will try on "PSN DLC" DB
-				file_type = content_file_type::PSN_CONTENT;
-				db_id = "PSN CONTENT";
-				use_fallback_db = true;
+				entry.file_type = content_file_type::PSN_CONTENT;
+				entry.db_id = "PSN CONTENT";
+				entry.use_fallback_db = true;
 			}
 			else
 			{
@@ -431,32 +440,53 @@ void game_list_actions::ShowGameIntegrityDialog(content_file_type file_type, con
 				switch (info.type)
 				{
 				case compat::package_type::update:
-					file_type = content_file_type::PSN_UPDATE;
-					db_id = "PSN UPDATE";
+					entry.file_type = content_file_type::PSN_UPDATE;
+					entry.db_id = "PSN UPDATE";
 					break;
 				case compat::package_type::dlc:
-					file_type = content_file_type::PSN_DLC;
-					db_id = "PSN DLC";
+					entry.file_type = content_file_type::PSN_DLC;
+					entry.db_id = "PSN DLC";
 					break;
 				case compat::package_type::other:
-					file_type = content_file_type::PSN_CONTENT;
-					db_id = "PSN CONTENT";
+					entry.file_type = content_file_type::PSN_CONTENT;
+					entry.db_id = "PSN CONTENT";
 					break;
 				}
 			}
 
-			// Initialize the validator (set also file size etc.)
-			m_game_validator->init_hash(path_list[i].toStdString());
+			paths.push_back(path_list[i].toStdString());
+		}
+
+		// Initialize the validator (set also total size etc.) and hash all the files concurrently
+		std::vector<content_hash_result> results;
 
-			if (m_game_validator->calculate_hash(hash) == content_hash_status::COMPLETED)
+		if (m_game_validator->init_hashes(paths))
+		{
+			m_game_validator->calculate_hashes(results);
+		}
+
+		for (usz i = 0; i < results.size() && m_game_validator->get_status() != content_hash_status::ABORTED; i++)
+		{
+			const content_hash_result& result = results[i];
+
+			if (result.status != content_hash_status::COMPLETED)
 			{
-				content_integrity_status integrity_status = m_game_validator->check_integrity(file_type, hash, &game_name);
+				text_result += tr("Hash calculation failed:\n - File: %0").arg(QString::fromStdString(result.path));
+				info_dialog = false;
+			}
+			else
+			{
+				const check_entry& entry = entries[i];
+				const QString file_name = QString::fromStdString(result.path.substr(result.path.find_last_of(fs::delim) + 1));
+				std::string db_id = entry.db_id;
+
+				content_integrity_status integrity_status = m_game_validator->check_integrity(entry.file_type, result.hash, &game_name);
 
 				// If no match for ".rap" or ".edat" is found on default "PSN Content" DB, try on "PSN DLC" DB
-				if (integrity_status == content_integrity_status::NO_MATCH && use_fallback_db)
+				if (integrity_status == content_integrity_status::NO_MATCH && entry.use_fallback_db)
 				{
 					db_id += " -> PSN DLC";
-					integrity_status = m_game_validator->check_integrity(content_file_type::PSN_DLC, hash, &game_name);
+					integrity_status = m_game_validator->check_integrity(content_file_type::PSN_DLC, result.hash, &game_name);
 				}
 
 				switch (integrity_status)
@@ -464,37 +494,32 @@ void game_list_actions::ShowGameIntegrityDialog(content_file_type file_type, con
 				case content_integrity_status::NO_MATCH:
 					text_result += tr("Game check NOT PASSED\n\nNo match found on '%0' DB or game corrupted:\n - File: %1\n - Hash: %2")
 						.arg(QString::fromStdString(db_id))
-						.arg(QString::fromStdString(m_game_validator->get_name()))
-						.arg(QString::fromStdString(hash));
+						.arg(file_name)
+						.arg(QString::fromStdString(result.hash));
 
 					info_dialog = false;
 					break;
 				case content_integrity_status::FOUND_MATCH:
 					text_result += tr("Game check PASSED\n\nMatch found on '%0' DB:\n - File: %1\n - Hash: %2\n - Game: %3")
 						.arg(QString::fromStdString(db_id))
-						.arg(QString::fromStdString(m_game_validator->get_name()))
-						.arg(QString::fromStdString(hash))
+						.arg(file_name)
+						.arg(QString::fromStdString(result.hash))
 						.arg(QString::fromStdString(game_name));
 					break;
 				default:
 					text_result += tr("Error parsing '%0' DB or DB not existing:\n - File: %1\n - Hash: %2")
 						.arg(QString::fromStdString(db_id))
-						.arg(QString::fromStdString(m_game_validator->get_name()))
-						.arg(QString::fromStdString(hash));
+						.arg(file_name)
+						.arg(QString::fromStdString(result.hash));
 
 					info_dialog = false;
 					break;
 				}
-
-				if (i < path_list.size() - 1) // If it's not the last processed entry, add empty lines as separator
-				{
-					text_result += "\n\n\n";
-				}
 			}
 
-			if (m_game_validator->get_status() == content_hash_status::ABORTED)
+			if (i < results.size() - 1) // If it's not the last processed entry, add empty lines as separator
 			{
-				break;
+				text_result += "\n\n\n";
 			}
 		}
 
@@ -1478,6 +1503,12 @@ void game_list_actions::BatchRemovePPUCaches(const std::vector<game_info>& games
 
 	const u32 total = ::size32(serials);
 
+	if (games.empty())
+	{
+		// Decrypted executables are not stored per title
+		RemoveContentPath(rpcs3::utils::get_self_cache_dir(), "SELF cache");
+	}
+
 	if (total == 0)
 	{
 		QMessageBox::information(m_game_list_frame, tr("PPU Cache Batch Removal"), tr("No files found"), QMessageBox::Ok);
@@ -1607,6 +1638,12 @@ void game_list_actions::BatchRemoveAllCaches(const std::vector<game_info>& games
 
 	const u32 total = ::size32(serials);
 
+	if (games.empty())
+	{
+		// Decrypted executables are not stored per title
+		RemoveContentPath(rpcs3::utils::get_self_cache_dir(), "SELF cache");
+	}
+
 	if (total == 0)
 	{
 		QMessageBox::information(m_game_list_frame, tr("Cache Batch Removal"), tr("No files found"), QMessageBox::Ok);
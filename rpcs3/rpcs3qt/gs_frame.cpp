@@ -11,6 +11,7 @@
 #include "Emu/system_progress.hpp"
 #include "Emu/savestate_utils.hpp"
 #include "Emu/IdManager.h"
+#include "Emu/perf_meter.hpp"
 #include "Emu/Audio/audio_utils.h"
 #include "Emu/Cell/Modules/cellScreenshot.h"
 #include "Emu/Cell/Modules/cellAudio.h"
@@ -429,6 +430,23 @@ void gs_frame::handle_shortcut(gui::shortcuts::shortcut shortcut_key, const QKey
 		}
 		break;
 	}
+	case gui::shortcuts::shortcut::gw_perf_trace:
+	{
+		if (m_perf_trace_thread && *m_perf_trace_thread != thread_state::finished)
+		{
+			gui_log.warning("A timeline trace is already being saved");
+			break;
+		}
+
+		m_perf_trace_thread = std::make_unique<named_thread<std::function<void()>>>("Timeline Trace", []()
+		{
+			if (const std::string path = perf_trace::capture(g_cfg.core.perf_trace_capture_length); !path.empty() && g_cfg.misc.show_capture_hints)
+			{
+				rsx::overlays::queue_message(tr("Timeline trace saved: %0").arg(QString::fromStdString(path)).toStdString());
+			}
+		});
+		break;
+	}
 	default:
 	{
 		break;
@@ -6,11 +6,13 @@
 #include "util/atomic.hpp"
 #include "util/media_utils.h"
 #include "Emu/RSX/GSFrameBase.h"
+#include "Utilities/Thread.h"
 
 #include <QWindow>
 #include <QPaintEvent>
 #include <QTimer>
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -51,6 +53,9 @@ private:
 
 	std::shared_ptr<utils::video_encoder> m_video_encoder{};
 
+	// Writes the timeline trace requested by the shortcut
+	std::unique_ptr<named_thread<std::function<void()>>> m_perf_trace_thread;
+
 public:
 	explicit gs_frame(QScreen* screen, const QRect& geometry, const QIcon& appIcon, std::shared_ptr<gui_settings> gui_settings, bool force_fullscreen);
 	~gs_frame();
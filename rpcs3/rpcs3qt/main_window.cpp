@@ -637,7 +637,8 @@ void main_window::BootElf()
 		"SELF files (EBOOT.BIN *.self);;"
 		"BOOT files (*BOOT.BIN);;"
 		"BIN files (*.bin);;"
-		"ISO files (*.iso);;"
+		"ISO files (*.iso *.rzi);;"
+		"Package files (*.pkg *.PKG);;"
 		"All executable files (*.SAVESTAT.zst *.SAVESTAT.gz *.SAVESTAT *.sprx *.SPRX *.self *.SELF *.bin *.BIN *.prx *.PRX *.elf *.ELF *.o *.O);;"
 		"All files (*.*)"),
 		Q_NULLPTR, QFileDialog::DontResolveSymlinks);
@@ -770,7 +771,7 @@ void main_window::BootISO()
 	}
 
 	const QString path_last_game = m_gui_settings->GetValue(gui::fd_boot_game).toString();
-	const QString path = QFileDialog::getOpenFileName(this, tr("Select ISO"), path_last_game, tr("ISO files (*.iso);;All files (*.*)"));
+	const QString path = QFileDialog::getOpenFileName(this, tr("Select ISO"), path_last_game, tr("ISO files (*.iso *.rzi);;All files (*.*)"));
 
 	if (path.isEmpty())
 	{
@@ -1732,64 +1733,40 @@ void main_window::HandlePupInstallation(main_window* mw, const QString& file_pat
 	// Used by tar_object::extract() as destination directory
 	vfs::mount("/dev_flash", g_cfg_vfs.get_dev_flash());
 
-	// Synchronization variable
-	atomic_t<uint> progress(0);
+	pup_install_state state{};
+	pup_install_result result = pup_install_result::ok;
+	atomic_t<bool> finished = false;
 	{
 		// Run asynchronously
 		named_thread worker("Firmware Installer", [&]
 		{
-			for (const auto& update_filename : update_filenames)
-			{
-				auto update_file_stream = update_files.get_file(update_filename);
-
-				if (update_file_stream->m_file_handler)
-				{
-					// Forcefully read all the data
-					update_file_stream->m_file_handler->handle_file_op(*update_file_stream, 0, update_file_stream->get_size(umax), nullptr);
-				}
-
-				fs::file update_file = fs::make_stream(std::move(update_file_stream->data));
-
-				SCEDecrypter self_dec(update_file);
-				self_dec.LoadHeaders();
-				self_dec.LoadMetadata(SCEPKG_ERK, SCEPKG_RIV);
-				self_dec.DecryptData();
-
-				auto dev_flash_tar_f = self_dec.MakeFile();
-				if (dev_flash_tar_f.size() < 3)
-				{
-					gui_log.error("Error while installing firmware: PUP contents are invalid.");
-					critical(tr("Firmware installation failed: Firmware could not be decompressed"));
-					progress = -1;
-					return;
-				}
-
-				tar_object dev_flash_tar(dev_flash_tar_f[2]);
-				if (!dev_flash_tar.extract())
-				{
-					gui_log.error("Error while installing firmware: TAR contents are invalid. (package=%s)", update_filename);
-					critical(tr("The firmware contents could not be extracted."
-						"\nThis is very likely caused by external interference from a faulty anti-virus software."
-						"\nPlease add RPCS3 to your anti-virus\' whitelist or use better anti-virus software."));
+			result = install_dev_flash_packages(update_files, update_filenames, state);
 
-					progress = -1;
-					return;
-				}
-
-				if (!progress.try_inc(::narrow<uint>(update_filenames.size())))
-				{
-					// Installation was cancelled
-					return;
-				}
+			switch (result)
+			{
+			case pup_install_result::ok:
+			case pup_install_result::cancelled:
+				break;
+			case pup_install_result::missing_package:
+			case pup_install_result::decrypt_failed:
+				gui_log.error("Error while installing firmware: PUP contents are invalid.");
+				critical(tr("Firmware installation failed: Firmware could not be decompressed"));
+				break;
+			case pup_install_result::extract_failed:
+				gui_log.error("Error while installing firmware: TAR contents are invalid.");
+				critical(tr("The firmware contents could not be extracted."
+					"\nThis is very likely caused by external interference from a faulty anti-virus software."
+					"\nPlease add RPCS3 to your anti-virus\' whitelist or use better anti-virus software."));
+				break;
 			}
+
+			finished = true;
 		});
 
 		// Wait for the completion
 		qt_events_aware_op(5, [&]()
 		{
-			const uint value = progress.load();
-
-			if (value >= update_filenames.size())
+			if (finished)
 			{
 				return true;
 			}
@@ -1798,12 +1775,12 @@ void main_window::HandlePupInstallation(main_window* mw, const QString& file_pat
 			{
 				if (pdlg->wasCanceled())
 				{
-					progress = -1;
+					state.cancelled = true;
 					return true;
 				}
 
 				// Update progress window
-				pdlg->SetValue(static_cast<int>(value));
+				pdlg->SetValue(static_cast<int>(state.installed_packages.load()));
 			}
 
 			return false;
@@ -1815,7 +1792,7 @@ void main_window::HandlePupInstallation(main_window* mw, const QString& file_pat
 
 	update_files_f.close();
 
-	if (progress == update_filenames.size())
+	if (result == pup_install_result::ok)
 	{
 		if (pdlg)
 		{
@@ -1833,7 +1810,7 @@ void main_window::HandlePupInstallation(main_window* mw, const QString& file_pat
 	// Unmount
 	Emu.Init();
 
-	if (progress == update_filenames.size())
+	if (result == pup_install_result::ok)
 	{
 		gui_log.success("Successfully installed PS3 firmware version %s.", version_string);
 
@@ -2761,7 +2738,7 @@ void main_window::CreateConnects()
 		}
 
 		const QString path_last_add_iso = m_gui_settings->GetValue(gui::fd_add_iso).toString();
-		QStringList paths = QFileDialog::getOpenFileNames(this, tr("Select ISO files to add"), path_last_add_iso, tr("ISO files (*.iso);;All files (*.*)"));
+		QStringList paths = QFileDialog::getOpenFileNames(this, tr("Select ISO files to add"), path_last_add_iso, tr("ISO files (*.iso *.rzi);;All files (*.*)"));
 		if (paths.isEmpty())
 		{
 			return;
@@ -39,6 +39,7 @@ void fmt_class_string<shortcut>::format(std::string& out, u64 arg)
 		case shortcut::gw_volume_up: return "gw_volume_up";
 		case shortcut::gw_volume_down: return "gw_volume_down";
 		case shortcut::gw_toggle_mouse_gyro: return "gw_toggle_mouse_gyro";
+		case shortcut::gw_perf_trace: return "gw_perf_trace";
 		case shortcut::count: return "count";
 		}
 
@@ -92,6 +93,7 @@ shortcut_settings::shortcut_settings()
 		{ shortcut::gw_volume_up, shortcut_info{ "gw_volume_up", tr("Volume Up"), "Ctrl+Shift++", shortcut_handler_id::game_window, true } },
 		{ shortcut::gw_volume_down, shortcut_info{ "gw_volume_down", tr("Volume Down"), "Ctrl+Shift+-", shortcut_handler_id::game_window, true } },
 		{ shortcut::gw_toggle_mouse_gyro, shortcut_info{ "gw_toggle_mouse_gyro", tr("Toggle Mouse-based Gyro"), "Ctrl+G", shortcut_handler_id::game_window, false } },
+		{ shortcut::gw_perf_trace, shortcut_info{ "gw_perf_trace", tr("Capture Timeline Trace"), "Alt+T", shortcut_handler_id::game_window, false } },
 	})
 {
 }
@@ -48,6 +48,7 @@ namespace gui
 			gw_volume_up,
 			gw_volume_down,
 			gw_toggle_mouse_gyro,
+			gw_perf_trace,
 
 			count
 		};
@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+
+#include "Crypto/aes.h"
+#include "Crypto/aesni.h"
+
+#include <string>
+#include <vector>
+
+namespace utils
+{
+	static std::vector<unsigned char> make_pattern(usz size, u32 seed)
+	{
+		std::vector<unsigned char> data(size);
+
+		for (unsigned char& byte : data)
+		{
+			seed = seed * 1103515245 + 12345;
+			byte = static_cast<unsigned char>(seed >> 16);
+		}
+
+		return data;
+	}
+
+	// Plain CBC decryption, one ECB block at a time
+	static std::vector<unsigned char> cbc_decrypt_reference(aes_context& ctx, std::vector<unsigned char> iv, const std::vector<unsigned char>& input)
+	{
+		std::vector<unsigned char> output(input.size());
+
+		for (usz pos = 0; pos < input.size(); pos += 16)
+		{
+			aes_crypt_ecb(&ctx, AES_DECRYPT, &input[pos], &output[pos]);
+
+			for (usz i = 0; i < 16; i++)
+			{
+				output[pos + i] ^= iv[i];
+			}
+
+			std::copy_n(&input[pos], 16, iv.begin());
+		}
+
+		return output;
+	}
+
+	static std::vector<unsigned char> from_hex(std::string_view hex)
+	{
+		std::vector<unsigned char> data(hex.size() / 2);
+
+		for (usz i = 0; i < data.size(); i++)
+		{
+			data[i] = static_cast<unsigned char>(std::stoi(std::string(hex.substr(i * 2, 2)), nullptr, 16));
+		}
+
+		return data;
+	}
+
+	TEST(AES, CBCDecryptKnownAnswer)
+	{
+		// NIST SP 800-38A, F.2.2 CBC-AES128.Decrypt
+		const auto key = from_hex("2b7e151628aed2a6abf7158809cf4f3c");
+		const auto iv = from_hex("000102030405060708090a0b0c0d0e0f");
+		const auto cipher = from_hex(
+			"7649abac8119b246cee98e9b12e9197d5086cb9b507219ee95db113a917678b2"
+			"73bed6b8e3c1743b7116e69e222295163ff1caa1681fac09120eca307586e1a7");
+		const auto plain = from_hex(
+			"6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+			"30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710");
+
+		aes_context dec{};
+		aes_setkey_dec(&dec, key.data(), 128);
+
+		// All four blocks (one 4-block group) and the first three (tail only)
+		for (usz size : {usz{64}, usz{48}})
+		{
+			std::vector<unsigned char> output(size);
+			std::vector<unsigned char> cur_iv = iv;
+			ASSERT_EQ(aes_crypt_cbc(&dec, AES_DECRYPT, size, cur_iv.data(), cipher.data(), output.data()), 0);
+			EXPECT_TRUE(std::equal(output.begin(), output.end(), plain.begin())) << "size=" << size;
+		}
+	}
+
+	TEST(AES, CBCDecryptMatchesReference)
+	{
+		const auto key = make_pattern(16, 1);
+		const auto iv = make_pattern(16, 2);
+
+		aes_context dec{};
+		aes_setkey_dec(&dec, key.data(), 128);
+
+		// Cover whole 4-block groups as well as 1 to 3 trailing blocks
+		for (usz blocks = 1; blocks <= 11; blocks++)
+		{
+			const auto input = make_pattern(blocks * 16, static_cast<u32>(blocks));
+			const auto expected = cbc_decrypt_reference(dec, iv, input);
+
+			std::vector<unsigned char> output(input.size());
+			std::vector<unsigned char> cur_iv = iv;
+			ASSERT_EQ(aes_crypt_cbc(&dec, AES_DECRYPT, input.size(), cur_iv.data(), input.data(), output.data()), 0);
+			EXPECT_EQ(output, expected) << "blocks=" << blocks;
+
+			// The IV must end up as the last ciphertext block
+			EXPECT_TRUE(std::equal(cur_iv.begin(), cur_iv.end(), input.end() - 16)) << "blocks=" << blocks;
+
+			// In-place decryption
+			std::vector<unsigned char> in_place = input;
+			cur_iv = iv;
+			ASSERT_EQ(aes_crypt_cbc(&dec, AES_DECRYPT, in_place.size(), cur_iv.data(), in_place.data(), in_place.data()), 0);
+			EXPECT_EQ(in_place, expected) << "blocks=" << blocks;
+		}
+	}
+
+#if defined(__SSE2__) || defined(_M_X64)
+	TEST(AES, AESNICBCDecrypt4MatchesSoftware)
+	{
+		if (!aesni_supports(POLARSSL_AESNI_AES))
+		{
+			GTEST_SKIP() << "AES-NI is not supported";
+		}
+
+		const auto key = make_pattern(32, 3);
+		const auto iv = make_pattern(16, 4);
+
+		for (unsigned int keysize : {128u, 192u, 256u})
+		{
+			aes_context dec{};
+			aes_setkey_dec(&dec, key.data(), keysize);
+
+			for (usz blocks = 1; blocks <= 11; blocks++)
+			{
+				const auto input = make_pattern(blocks * 16, static_cast<u32>(blocks + keysize));
+
+				// Reference: CBC built from single ECB blocks
+				const auto expected = cbc_decrypt_reference(dec, iv, input);
+
+				std::vector<unsigned char> output(input.size());
+				std::vector<unsigned char> cur_iv = iv;
+				const usz done = aesni_crypt_cbc_dec4(&dec, input.size(), cur_iv.data(), input.data(), output.data());
+
+				// Only whole 4-block groups are processed, the tail is left to the caller
+				ASSERT_EQ(done, blocks / 4 * 64) << "blocks=" << blocks << " keysize=" << keysize;
+				EXPECT_TRUE(std::equal(output.begin(), output.begin() + done, expected.begin())) << "blocks=" << blocks << " keysize=" << keysize;
+
+				if (done)
+				{
+					EXPECT_TRUE(std::equal(cur_iv.begin(), cur_iv.end(), input.begin() + done - 16)) << "blocks=" << blocks << " keysize=" << keysize;
+				}
+				else
+				{
+					EXPECT_EQ(cur_iv, iv);
+				}
+			}
+		}
+	}
+#endif
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include "Loader/iso_compressed.h"
+
+namespace utils
+{
+	// Builds a synthetic image recognized as ISO9660, mixing compressible and incompressible chunks
+	static std::vector<u8> make_test_image(u64 size)
+	{
+		std::vector<u8> image(size);
+		u32 seed = 1;
+
+		for (u64 i = 0; i < size; i++)
+		{
+			if ((i / ISO_COMPRESSED_CHUNK_SIZE) % 3 == 2)
+			{
+				// Random data, stored uncompressed
+				seed = seed * 1103515245 + 12345;
+				image[i] = static_cast<u8>(seed >> 16);
+			}
+			else
+			{
+				image[i] = static_cast<u8>(i / 2048 + i % 7);
+			}
+		}
+
+		// Primary volume descriptor
+		std::memcpy(image.data() + 32768 + 1, "CD001", 5);
+		return image;
+	}
+
+	TEST(ISOCompressed, RoundTrip)
+	{
+		// Enough chunks for parallel decompression, the last one is partial
+		const u64 image_size = 40 * u64{ISO_COMPRESSED_CHUNK_SIZE} + 3 * 2048;
+		const std::vector<u8> source = make_test_image(image_size);
+
+		const std::string src_path = fs::get_temp_dir() + "rpcs3_test_rzi_source.iso";
+		const std::string dst_path = fs::get_temp_dir() + "rpcs3_test_rzi_image.rzi";
+
+		ASSERT_TRUE(fs::write_file(src_path, fs::rewrite, source));
+
+		iso_compress_state state;
+		ASSERT_TRUE(compress_iso(src_path, dst_path, state));
+		EXPECT_EQ(state.processed_bytes, image_size);
+
+		{
+			const fs::file image = open_iso_image(dst_path);
+			ASSERT_TRUE(image);
+			EXPECT_TRUE(is_iso_compressed(fs::file(dst_path)));
+			EXPECT_EQ(image.size(), image_size);
+			EXPECT_LT(fs::file(dst_path).size(), image_size);
+
+			const std::pair<u64, u64> ranges[] =
+			{
+				{0, image_size}, // Everything
+				{1, 100}, // Unaligned, inside the first chunk
+				{ISO_COMPRESSED_CHUNK_SIZE - 5, 10}, // Across a chunk boundary
+				{2 * u64{ISO_COMPRESSED_CHUNK_SIZE} + 17, 3 * u64{ISO_COMPRESSED_CHUNK_SIZE}}, // Stored chunk, partial chunks on both ends
+				{777, 20 * u64{ISO_COMPRESSED_CHUNK_SIZE}}, // Many whole chunks between partial ones
+				{image_size - 4097, 4097}, // Tail
+				{image_size - 10, 100}, // Past the end
+			};
+
+			for (const auto& [offset, size] : ranges)
+			{
+				std::vector<u8> data(size);
+				const u64 expected = std::min<u64>(size, image_size - offset);
+
+				ASSERT_EQ(image.read_at(offset, data.data(), size), expected) << "offset=" << offset << " size=" << size;
+				EXPECT_TRUE(std::equal(data.begin(), data.begin() + expected, source.begin() + offset)) << "offset=" << offset << " size=" << size;
+			}
+
+			std::vector<u8> data(16);
+			EXPECT_EQ(image.read_at(image_size, data.data(), data.size()), 0u);
+		}
+
+		fs::remove_file(src_path);
+		fs::remove_file(dst_path);
+	}
+}
@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+
+#include "Emu/RSX/RSXFIFO.h"
+#include "Emu/RSX/Core/RSXIOMap.hpp"
+#include "Emu/Cell/lv2/sys_rsx.h"
+#include "Emu/Memory/vm.h"
+#include "Emu/system_config.h"
+#include "util/vm.hpp"
+
+#include <vector>
+
+namespace rsx::FIFO
+{
+	// Command buffer at IO offset 0, backed by guest memory
+	constexpr u32 test_fifo_addr = 0x30000000;
+	constexpr u32 test_fifo_size = 0x10000;
+
+	struct test_command_buffer
+	{
+		std::vector<u32> words = std::vector<u32>(test_fifo_size / 4);
+		u32 pos = 0;
+
+		void emit(u32 word)
+		{
+			words[pos / 4] = word;
+			pos += 4;
+		}
+
+		void method(u32 reg, std::initializer_list<u32> args, bool increment = true)
+		{
+			emit((::size32(args) << 18) | (reg << 2) | (increment ? 0 : RSX_METHOD_NON_INCREMENT_CMD));
+
+			for (u32 arg : args)
+			{
+				emit(arg);
+			}
+		}
+	};
+
+	// Runs the stream like thread::run_FIFO until it runs dry, flow control is executed by the caller
+	static void drain(FIFO_control& fifo, u32& ret_addr, std::vector<std::pair<u32, u32>>& out)
+	{
+		for (u32 i = 0; i < 10000; i++)
+		{
+			register_pair command{};
+			fifo.read(command);
+
+			switch (command.reg)
+			{
+			case FIFO_NOP:
+				continue;
+			case FIFO_EMPTY:
+				return;
+			case FIFO_ERROR:
+				FAIL() << "FIFO error at 0x" << std::hex << fifo.get_pos();
+			default:
+				break;
+			}
+
+			if (const u32 cmd = command.reg; cmd & RSX_METHOD_NON_METHOD_CMD_MASK)
+			{
+				if ((cmd & RSX_METHOD_OLD_JUMP_CMD_MASK) == RSX_METHOD_OLD_JUMP_CMD)
+				{
+					fifo.set_get(cmd & RSX_METHOD_OLD_JUMP_OFFSET_MASK);
+				}
+				else if ((cmd & RSX_METHOD_NEW_JUMP_CMD_MASK) == RSX_METHOD_NEW_JUMP_CMD)
+				{
+					fifo.set_get(cmd & RSX_METHOD_NEW_JUMP_OFFSET_MASK);
+				}
+				else if ((cmd & RSX_METHOD_CALL_CMD_MASK) == RSX_METHOD_CALL_CMD)
+				{
+					ASSERT_EQ(ret_addr, RSX_CALL_STACK_EMPTY);
+					ret_addr = fifo.get_pos() + 4;
+					fifo.set_get(cmd & RSX_METHOD_CALL_OFFSET_MASK);
+				}
+				else
+				{
+					ASSERT_EQ(cmd & RSX_METHOD_RETURN_MASK, u32{RSX_METHOD_RETURN_CMD});
+					ASSERT_NE(ret_addr, RSX_CALL_STACK_EMPTY);
+					fifo.set_get(std::exchange(ret_addr, RSX_CALL_STACK_EMPTY));
+				}
+
+				continue;
+			}
+
+			do
+			{
+				out.emplace_back(command.reg, command.value);
+			}
+			while (fifo.read_unsafe(command));
+		}
+
+		FAIL() << "The FIFO did not run dry";
+	}
+
+	static std::vector<std::pair<u32, u32>> run_stream(bool predecode)
+	{
+		test_command_buffer buf;
+
+		// Main stream
+		buf.method(NV4097_SET_SURFACE_PITCH_Z, { 0x40 });
+		buf.emit(RSX_METHOD_NOP_CMD);
+		buf.method(NV4097_SET_SURFACE_CLIP_HORIZONTAL, { 1, 2, 3 });
+		buf.emit(RSX_METHOD_NEW_JUMP_CMD | 0x400);
+
+		// Jump target, calls a subroutine then hits a sync method
+		buf.pos = 0x400;
+		buf.emit(RSX_METHOD_CALL_CMD | 0x800);
+		buf.method(NV4097_SET_COLOR_MASK, { 4, 5 }, false);
+		buf.method(NV4097_WAIT_FOR_IDLE, { 0 });
+		buf.method(NV4097_SET_SURFACE_PITCH_Z, { 6 });
+
+		// PUT is first stopped here
+		const u32 first_put = buf.pos;
+		buf.method(NV4097_SET_SURFACE_CLIP_HORIZONTAL, { 7, 8 });
+		buf.emit(RSX_METHOD_OLD_JUMP_CMD | 0xc00);
+
+		// Subroutine
+		buf.pos = 0x800;
+		buf.method(NV4097_SET_SURFACE_CLIP_HORIZONTAL, { 9, 10, 11, 12 });
+		buf.emit(RSX_METHOD_RETURN_CMD);
+
+		buf.pos = 0xc00;
+		buf.method(NV4097_SET_COLOR_MASK, { 13 });
+		const u32 final_put = buf.pos;
+
+		utils::memory_commit(vm::g_base_addr + test_fifo_addr, test_fifo_size);
+
+		for (u32 i = 0; i < buf.words.size(); i++)
+		{
+			vm::write32(test_fifo_addr + i * 4, buf.words[i]);
+		}
+
+		const auto iotable = std::make_unique<rsx_iomap_table>();
+		iotable->ea[0] = test_fifo_addr;
+
+		RsxDmaControl ctrl{};
+		ctrl.get = 0;
+		ctrl.put = first_put;
+
+		u32 ret_addr = RSX_CALL_STACK_EMPTY;
+		std::vector<std::pair<u32, u32>> result;
+
+		{
+			FIFO_control fifo(&ctrl, iotable.get(), &ret_addr, predecode);
+			drain(fifo, ret_addr, result);
+			EXPECT_EQ(fifo.get_pos(), first_put);
+
+			// Move PUT while the decoder may be sleeping on it
+			ctrl.put = final_put;
+			drain(fifo, ret_addr, result);
+			EXPECT_EQ(fifo.get_pos(), final_put);
+		}
+
+		EXPECT_EQ(ret_addr, RSX_CALL_STACK_EMPTY);
+
+		utils::memory_decommit(vm::g_base_addr + test_fifo_addr, test_fifo_size);
+		return result;
+	}
+
+	TEST(RSXFIFO, PredecoderMatchesSerialDecode)
+	{
+		const auto saved = g_cfg.core.rsx_fifo_accuracy.get();
+		g_cfg.core.rsx_fifo_accuracy.set(rsx_fifo_mode::fast);
+
+		const auto serial = run_stream(false);
+
+		const std::vector<std::pair<u32, u32>> expected =
+		{
+			{ NV4097_SET_SURFACE_PITCH_Z << 2, 0x40 },
+			{ NV4097_SET_SURFACE_CLIP_HORIZONTAL << 2, 1 },
+			{ (NV4097_SET_SURFACE_CLIP_HORIZONTAL + 1) << 2, 2 },
+			{ (NV4097_SET_SURFACE_CLIP_HORIZONTAL + 2) << 2, 3 },
+			{ NV4097_SET_SURFACE_CLIP_HORIZONTAL << 2, 9 },
+			{ (NV4097_SET_SURFACE_CLIP_HORIZONTAL + 1) << 2, 10 },
+			{ (NV4097_SET_SURFACE_CLIP_HORIZONTAL + 2) << 2, 11 },
+			{ (NV4097_SET_SURFACE_CLIP_HORIZONTAL + 3) << 2, 12 },
+			{ NV4097_SET_COLOR_MASK << 2, 4 },
+			{ NV4097_SET_COLOR_MASK << 2, 5 },
+			{ NV4097_WAIT_FOR_IDLE << 2, 0 },
+			{ NV4097_SET_SURFACE_PITCH_Z << 2, 6 },
+			{ NV4097_SET_SURFACE_CLIP_HORIZONTAL << 2, 7 },
+			{ (NV4097_SET_SURFACE_CLIP_HORIZONTAL + 1) << 2, 8 },
+			{ NV4097_SET_COLOR_MASK << 2, 13 },
+		};
+
+		EXPECT_EQ(serial, expected);
+
+		// The decoder runs concurrently, repeat to go through different interleavings with the consumer
+		for (u32 i = 0; i < 20; i++)
+		{
+			EXPECT_EQ(run_stream(true), serial) << "iteration " << i;
+		}
+
+		g_cfg.core.rsx_fifo_accuracy.set(saved);
+	}
+}
@@ -2,6 +2,8 @@
 
 #include "Emu/RSX/Common/simple_array.hpp"
 #include "Emu/RSX/Program/Assembler/FPASM.h"
+#include "Emu/RSX/Program/Assembler/Passes/FP/CopyPropagationPass.h"
+#include "Emu/RSX/Program/Assembler/Passes/FP/DeadCodeEliminationPass.h"
 #include "Emu/RSX/Program/Assembler/Passes/FP/RegisterAnnotationPass.h"
 #include "Emu/RSX/Program/Assembler/Passes/FP/RegisterDependencyPass.h"
 #include "Emu/RSX/Program/RSXFragmentProgram.h"
@@ -758,4 +760,71 @@ namespace rsx::assembler
 		EXPECT_EQ(get_graph_block(graph, 0)->instructions.size(), 6);
 		EXPECT_EQ(get_graph_block(graph, 0)->epilogue.size(), 0);
 	}
+
+	TEST(TestFPIR, CopyPropagationPass_ForwardsMove)
+	{
+		// R1 is a plain copy of R0. After forwarding, the copy is overwritten without being read and becomes dead.
+		auto graph = CFG_from_source(R"(
+			MOV R1, R0;
+			ADD R2, R1, R3;
+			MOV R1, R2;
+		)");
+
+		auto& block = graph.blocks.front();
+
+		FP::CopyPropagationPass copy_propagation_pass{};
+		FP::DeadCodeEliminationPass dce_pass{};
+
+		copy_propagation_pass.run(graph);
+		EXPECT_EQ(SRC0{ .HEX = block.instructions[1].bytecode[1] }.tmp_reg_index, 0);
+		EXPECT_EQ(SRC1{ .HEX = block.instructions[1].bytecode[2] }.tmp_reg_index, 3);
+
+		dce_pass.run(graph);
+		ASSERT_EQ(block.instructions.size(), 2);
+		EXPECT_EQ(block.instructions[0].opcode, RSX_FP_OPCODE_ADD);
+		EXPECT_EQ(block.instructions[1].opcode, RSX_FP_OPCODE_MOV);
+	}
+
+	TEST(TestFPIR, CopyPropagationPass_AliasedWrite)
+	{
+		// H2 aliases R1.x, so the ADD must keep reading R1.
+		// The first MOV is only partially overwritten and has to stay.
+		auto graph = CFG_from_source(R"(
+			MOV R1, R0;
+			MOV H2.xy, H4;
+			ADD R2, R1, R3;
+			MOV R1.xy, R2;
+		)");
+
+		auto& block = graph.blocks.front();
+
+		FP::CopyPropagationPass copy_propagation_pass{};
+		FP::DeadCodeEliminationPass dce_pass{};
+
+		copy_propagation_pass.run(graph);
+		dce_pass.run(graph);
+
+		ASSERT_EQ(block.instructions.size(), 4);
+		EXPECT_EQ(SRC0{ .HEX = block.instructions[2].bytecode[1] }.tmp_reg_index, 1);
+	}
+
+	TEST(TestFPIR, DeadCodeEliminationPass_SelfMovesAndSideEffects)
+	{
+		// Self-moves at native precision are no-ops. SLT updates the condition register and must survive even though R1 is overwritten.
+		auto graph = CFG_from_source(R"(
+			MOV R0, R0;
+			MOV H1, H1;
+			SLT R1, R0, R2;
+			MOV R1, R3;
+		)");
+
+		auto& block = graph.blocks.front();
+
+		FP::DeadCodeEliminationPass dce_pass{};
+		dce_pass.run(graph);
+
+		ASSERT_EQ(block.instructions.size(), 2);
+		EXPECT_EQ(block.instructions[0].opcode, RSX_FP_OPCODE_SLT);
+		EXPECT_EQ(block.instructions[1].opcode, RSX_FP_OPCODE_MOV);
+	}
 }
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include "Emu/RSX/Common/BufferUtils.h"
+#include "util/endian.hpp"
+
+namespace rsx
+{
+	static const auto expand_all = [](primitive_type mode)
+	{
+		return mode == primitive_type::quads || mode == primitive_type::triangle_fan || mode == primitive_type::polygon;
+	};
+
+	template <typename T>
+	static std::vector<be_t<T>> to_be(const std::vector<T>& values)
+	{
+		return { values.begin(), values.end() };
+	}
+
+	template <typename T>
+	static std::tuple<u32, u32, u32> write_indices(std::vector<T>& dst, const std::vector<be_t<T>>& src, primitive_type mode,
+		bool restart, u32 restart_index, bool cached = true)
+	{
+		constexpr auto type = sizeof(T) == 2 ? index_array_type::u16 : index_array_type::u32;
+
+		// Worst case is a fan, 3 indices per input index
+		dst.assign(src.size() * 3, 0);
+
+		const std::span<std::byte> dst_bytes{ reinterpret_cast<std::byte*>(dst.data()), dst.size() * sizeof(T) };
+		const std::span<const std::byte> src_bytes{ reinterpret_cast<const std::byte*>(src.data()), src.size() * sizeof(T) };
+
+		const auto result = cached
+			? write_index_array_data_to_buffer(dst_bytes, src_bytes, type, mode, restart, restart_index, expand_all)
+			: write_index_array_data_to_buffer_untracked(dst_bytes, src_bytes, type, mode, restart, restart_index, expand_all);
+
+		dst.resize(std::get<2>(result));
+		return result;
+	}
+
+	TEST(RSXIndexBuffer, ExpandQuads)
+	{
+		const auto src = to_be<u16>({ 4, 5, 6, 7, 8, 9, 10, 11, 3 });
+
+		std::vector<u16> dst;
+		const auto [min_index, max_index, count] = write_indices(dst, src, primitive_type::quads, false, 0);
+
+		// The trailing index does not form a quad but still counts towards the range
+		EXPECT_EQ(dst, (std::vector<u16>{ 4, 5, 6, 6, 7, 4, 8, 9, 10, 10, 11, 8 }));
+		EXPECT_EQ(min_index, 3u);
+		EXPECT_EQ(max_index, 11u);
+		EXPECT_EQ(count, 12u);
+	}
+
+	TEST(RSXIndexBuffer, ExpandTriangleFan)
+	{
+		const auto src = to_be<u32>({ 10, 11, 12, 13, 0x10000 });
+
+		std::vector<u32> dst;
+		const auto [min_index, max_index, count] = write_indices(dst, src, primitive_type::triangle_fan, false, 0);
+
+		EXPECT_EQ(dst, (std::vector<u32>{ 10, 11, 12, 10, 12, 13, 10, 13, 0x10000 }));
+		EXPECT_EQ(min_index, 10u);
+		EXPECT_EQ(max_index, 0x10000u);
+		EXPECT_EQ(count, 9u);
+
+		// A u16 restart index above the type range can never trigger, the fast path must be identical to the scalar walk
+		const auto src16 = to_be<u16>({ 1, 2, 3, 4 });
+		std::vector<u16> dst16;
+		write_indices(dst16, src16, primitive_type::polygon, true, 0x10000);
+		EXPECT_EQ(dst16, (std::vector<u16>{ 1, 2, 3, 1, 3, 4 }));
+	}
+
+	TEST(RSXIndexBuffer, CachedExpansionTracksSource)
+	{
+		// Large enough to be cached
+		std::vector<u16> values;
+		for (u16 i = 0; i < 256; i++)
+		{
+			values.push_back(i % 17 == 16 ? 0xffff : i);
+		}
+
+		auto src = to_be<u16>(values);
+
+		std::vector<u16> expected, first, second;
+		const auto expected_result = write_indices(expected, src, primitive_type::quads, true, 0xffff, false);
+		EXPECT_EQ(write_indices(first, src, primitive_type::quads, true, 0xffff), expected_result);
+		EXPECT_EQ(write_indices(second, src, primitive_type::quads, true, 0xffff), expected_result);
+		EXPECT_EQ(first, expected);
+		EXPECT_EQ(second, expected);
+
+		// Same address, different contents
+		src[1] = 0x1234;
+		const auto modified_result = write_indices(expected, src, primitive_type::quads, true, 0xffff, false);
+		EXPECT_EQ(write_indices(second, src, primitive_type::quads, true, 0xffff), modified_result);
+		EXPECT_EQ(second, expected);
+		EXPECT_EQ(std::get<1>(modified_result), 0x1234u);
+	}
+}
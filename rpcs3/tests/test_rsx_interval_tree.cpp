@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+#include "Emu/RSX/Common/interval_tree.hpp"
+
+#include <algorithm>
+#include <random>
+
+using namespace utils;
+
+namespace rsx
+{
+	// Address layout loosely following a real capture: a few framebuffer-sized surfaces in local memory,
+	// thousands of small glyph and tile sections packed next to each other in main memory, and some mid-sized textures.
+	static std::vector<address_range32> make_section_distribution(std::mt19937& rng)
+	{
+		std::vector<address_range32> result;
+
+		for (u32 i = 0; i < 16; i++)
+		{
+			result.push_back(address_range32::start_length(0xC0000000 + i * 0x400000, 1280 * 720 * 4));
+		}
+
+		std::uniform_int_distribution<u32> glyph_size(256, 4096);
+		for (u32 i = 0, addr = 0x30000000; i < 8192; i++)
+		{
+			const u32 size = glyph_size(rng);
+			result.push_back(address_range32::start_length(addr, size));
+			addr += size + (i % 7) * 64;
+		}
+
+		std::uniform_int_distribution<u32> tex_addr(0x20000000, 0x2FFFFFFF);
+		std::uniform_int_distribution<u32> tex_size(0x4000, 0x100000);
+		for (u32 i = 0; i < 1024; i++)
+		{
+			result.push_back(address_range32::start_length(tex_addr(rng) & ~0xFF, tex_size(rng)));
+		}
+
+		return result;
+	}
+
+	static std::vector<u32> brute_force_overlaps(const std::vector<address_range32>& sections, const address_range32& range)
+	{
+		std::vector<u32> result;
+		for (u32 i = 0; i < sections.size(); i++)
+		{
+			if (sections[i].overlaps(range))
+			{
+				result.push_back(i);
+			}
+		}
+		return result;
+	}
+
+	TEST(RSXIntervalTree, MatchesBruteForce)
+	{
+		std::mt19937 rng(1234);
+		const auto sections = make_section_distribution(rng);
+
+		interval_tree<u32> tree;
+		for (u32 i = 0; i < sections.size(); i++)
+		{
+			tree.insert(sections[i], i);
+		}
+
+		EXPECT_EQ(tree.size(), sections.size());
+
+		std::uniform_int_distribution<u32> query_addr(0x1F000000, 0x32000000);
+		std::uniform_int_distribution<u32> query_size(1, 0x20000);
+
+		for (u32 n = 0; n < 2000; n++)
+		{
+			const auto range = address_range32::start_length(query_addr(rng), query_size(rng));
+
+			std::vector<u32> found;
+			u32 last_start = 0;
+			tree.for_each_overlapping(range, [&](u32 id)
+			{
+				// Results come out in ascending start order
+				EXPECT_LE(last_start, sections[id].start);
+				last_start = sections[id].start;
+				found.push_back(id);
+			});
+
+			std::sort(found.begin(), found.end());
+			EXPECT_EQ(found, brute_force_overlaps(sections, range));
+		}
+	}
+
+	TEST(RSXIntervalTree, EraseAndReinsert)
+	{
+		interval_tree<u32> tree;
+		tree.insert(address_range32::start_length(0x1000, 0x1000), 1);
+		tree.insert(address_range32::start_length(0x1800, 0x100), 2);
+		tree.insert(address_range32::start_length(0x8000, 0x1000), 3);
+
+		const auto collect = [&](const address_range32& range)
+		{
+			std::vector<u32> ids;
+			tree.for_each_overlapping(range, [&](u32 id) { ids.push_back(id); });
+			return ids;
+		};
+
+		EXPECT_EQ(collect(address_range32::start_length(0x1850, 1)), (std::vector<u32>{ 1, 2 }));
+		EXPECT_EQ(collect(address_range32::start_end(0x2000, 0x7FFF)), std::vector<u32>{});
+
+		// Moving a value replaces its old range
+		tree.insert(address_range32::start_length(0x4000, 0x4000), 1);
+		EXPECT_EQ(tree.size(), 3);
+		EXPECT_EQ(collect(address_range32::start_end(0x2000, 0x7FFF)), std::vector<u32>{ 1 });
+
+		EXPECT_TRUE(tree.erase(2));
+		EXPECT_FALSE(tree.erase(2));
+		EXPECT_FALSE(tree.contains(2));
+		EXPECT_EQ(collect(address_range32::start_length(0, 0x10000)), (std::vector<u32>{ 1, 3 }));
+
+		tree.clear();
+		EXPECT_TRUE(tree.empty());
+		EXPECT_EQ(collect(address_range32::start_length(0, 0x10000)), std::vector<u32>{});
+	}
+}
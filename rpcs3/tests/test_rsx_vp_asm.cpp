@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+
+#include "Emu/RSX/Program/Assembler/CFG.h"
+#include "Emu/RSX/Program/Assembler/VPOpcodes.h"
+#include "Emu/RSX/Program/Assembler/Passes/VP/DeadOutputEliminationPass.h"
+#include "Emu/RSX/Program/RSXVertexProgram.h"
+#include "Emu/RSX/gcm_enums.h"
+
+namespace rsx::assembler
+{
+	static SRC make_src(u32 reg_type, u32 tmp = 0)
+	{
+		SRC src{};
+		src.reg_type = reg_type;
+		src.tmp_src = tmp;
+		src.swz_x = 0;
+		src.swz_y = 1;
+		src.swz_z = 2;
+		src.swz_w = 3;
+		return src;
+	}
+
+	struct vp_instruction_t
+	{
+		u32 vec_opcode = RSX_VEC_OPCODE_NOP;
+		u32 sca_opcode = RSX_SCA_OPCODE_NOP;
+		u32 dst_tmp = 0x3f;
+		u32 sca_dst_tmp = 0x3f;
+		u32 dst = 0x1f;
+		bool vec_result = true;
+		SRC src0 = make_src(RSX_VP_REGISTER_TYPE_INPUT);
+		SRC src2 = make_src(RSX_VP_REGISTER_TYPE_INPUT);
+		bool end = false;
+		u32 branch_target = 0;
+	};
+
+	static RSXVertexProgram make_program(const std::vector<vp_instruction_t>& instructions, std::set<u32> jump_table = {})
+	{
+		RSXVertexProgram prog{};
+		const SRC src1 = make_src(RSX_VP_REGISTER_TYPE_INPUT);
+
+		for (u32 i = 0; i < instructions.size(); ++i)
+		{
+			const auto& inst = instructions[i];
+			D0 d0{}; D1 d1{}; D2 d2{}; D3 d3{};
+
+			d0.cond = 7;
+			d0.dst_tmp = inst.dst_tmp;
+			d0.vec_result = inst.vec_result;
+			d1.vec_opcode = inst.vec_opcode;
+			d1.sca_opcode = inst.sca_opcode;
+			d1.src0h = inst.src0.src0h;
+			d2.src0l = inst.src0.src0l;
+			d2.src1 = src1.src1;
+			d2.src2h = inst.src2.src2h;
+			d3.src2l = inst.src2.src2l;
+			d3.end = inst.end;
+			d3.dst = inst.dst;
+			d3.sca_dst_tmp = inst.sca_dst_tmp;
+			d3.vec_writemask_x = d3.vec_writemask_y = d3.vec_writemask_z = d3.vec_writemask_w = 1;
+			d3.sca_writemask_x = d3.sca_writemask_y = d3.sca_writemask_z = d3.sca_writemask_w = 1;
+
+			if (inst.branch_target)
+			{
+				d0.iaddrh2 = inst.branch_target >> 9;
+				d2.iaddrh = inst.branch_target >> 3;
+				d3.iaddrl = inst.branch_target;
+			}
+
+			prog.data.insert(prog.data.end(), { d0.HEX, d1.HEX, d2.HEX, d3.HEX });
+			prog.instruction_mask.set(i);
+		}
+
+		prog.jump_table = std::move(jump_table);
+		return prog;
+	}
+
+	static std::vector<std::pair<u32, u32>> get_opcodes(const FlowGraph& graph)
+	{
+		std::vector<std::pair<u32, u32>> result;
+		for (const auto& block : graph.blocks)
+		{
+			for (const auto& instruction : block.instructions)
+			{
+				result.push_back({ VP::get_vec_opcode(&instruction), VP::get_sca_opcode(&instruction) });
+			}
+		}
+		return result;
+	}
+
+	TEST(TestVPIR, DeadOutputElimination_OutputMask)
+	{
+		const auto prog = make_program(
+		{
+			{ .vec_opcode = RSX_VEC_OPCODE_MUL, .sca_opcode = RSX_SCA_OPCODE_RCP, .dst_tmp = 0, .sca_dst_tmp = 1 }, // MUL R0, v, v; RCP R1, v
+			{ .vec_opcode = RSX_VEC_OPCODE_MOV, .dst = 7, .src0 = make_src(RSX_VP_REGISTER_TYPE_TEMP, 0) },         // MOV o[7], R0
+			{ .vec_opcode = RSX_VEC_OPCODE_MOV, .dst = 0, .src0 = make_src(RSX_VP_REGISTER_TYPE_TEMP, 1), .end = true }, // MOV o[0], R1
+		});
+
+		// TEX0 is read by the fragment program, nothing changes
+		auto graph = deconstruct_vertex_program(prog);
+		EXPECT_TRUE(VP::DeadOutputEliminationPass{ CELL_GCM_ATTRIB_OUTPUT_MASK_TEX0 }.run(graph));
+		EXPECT_EQ(get_opcodes(graph), (std::vector<std::pair<u32, u32>>
+		{
+			{ RSX_VEC_OPCODE_MUL, RSX_SCA_OPCODE_RCP },
+			{ RSX_VEC_OPCODE_MOV, RSX_SCA_OPCODE_NOP },
+			{ RSX_VEC_OPCODE_MOV, RSX_SCA_OPCODE_NOP },
+		}));
+
+		// Without TEX0 the texture coordinate and the vector half feeding it are dead. The scalar half still feeds the position.
+		graph = deconstruct_vertex_program(prog);
+		EXPECT_TRUE(VP::DeadOutputEliminationPass{ 0 }.run(graph));
+		EXPECT_EQ(get_opcodes(graph), (std::vector<std::pair<u32, u32>>
+		{
+			{ RSX_VEC_OPCODE_NOP, RSX_SCA_OPCODE_RCP },
+			{ RSX_VEC_OPCODE_NOP, RSX_SCA_OPCODE_NOP },
+			{ RSX_VEC_OPCODE_MOV, RSX_SCA_OPCODE_NOP },
+		}));
+	}
+
+	TEST(TestVPIR, DeadOutputElimination_Branches)
+	{
+		const auto prog = make_program(
+		{
+			{ .vec_opcode = RSX_VEC_OPCODE_MOV, .dst_tmp = 2 },                                                  // MOV R2, v
+			{ .sca_opcode = RSX_SCA_OPCODE_BRB, .branch_target = 3 },                                            // BRB L3
+			{ .vec_opcode = RSX_VEC_OPCODE_MOV, .dst = 0, .end = true },                                         // MOV o[0], v
+			{ .vec_opcode = RSX_VEC_OPCODE_MOV, .dst = 7, .src0 = make_src(RSX_VP_REGISTER_TYPE_TEMP, 2) },     // L3: MOV o[7], R2
+			{ .vec_opcode = RSX_VEC_OPCODE_MOV, .dst = 0, .end = true },                                         // MOV o[0], v
+		}, { 3 });
+
+		auto graph = deconstruct_vertex_program(prog);
+
+		// Head, fallthrough path, branch target and the exit node
+		ASSERT_EQ(graph.blocks.size(), 4);
+		const auto& head = graph.blocks.front();
+		EXPECT_EQ(head.instructions.size(), 2);
+		ASSERT_EQ(head.succ.size(), 2);
+		EXPECT_EQ(head.succ[0].to->id, 2);
+		EXPECT_EQ(head.succ[1].to->id, 3);
+		EXPECT_EQ(head.succ[1].type, EdgeType::BRANCH);
+		EXPECT_TRUE(graph.blocks.back().instructions.empty());
+		EXPECT_EQ(graph.blocks.back().pred.size(), 2);
+
+		// R2 is only read on the branch path, it stays live across the jump
+		EXPECT_TRUE(VP::DeadOutputEliminationPass{ CELL_GCM_ATTRIB_OUTPUT_MASK_TEX0 }.run(graph));
+		EXPECT_EQ(get_opcodes(graph)[0].first, RSX_VEC_OPCODE_MOV);
+		EXPECT_EQ(get_opcodes(graph)[3].first, RSX_VEC_OPCODE_MOV);
+
+		graph = deconstruct_vertex_program(prog);
+		EXPECT_TRUE(VP::DeadOutputEliminationPass{ 0 }.run(graph));
+		EXPECT_EQ(get_opcodes(graph), (std::vector<std::pair<u32, u32>>
+		{
+			{ RSX_VEC_OPCODE_NOP, RSX_SCA_OPCODE_NOP },
+			{ RSX_VEC_OPCODE_NOP, RSX_SCA_OPCODE_BRB },
+			{ RSX_VEC_OPCODE_MOV, RSX_SCA_OPCODE_NOP },
+			{ RSX_VEC_OPCODE_NOP, RSX_SCA_OPCODE_NOP },
+			{ RSX_VEC_OPCODE_MOV, RSX_SCA_OPCODE_NOP },
+		}));
+	}
+
+	TEST(TestVPIR, DeadOutputElimination_LiveLanes)
+	{
+		using pass = VP::DeadOutputEliminationPass;
+
+		// Position only
+		EXPECT_EQ(pass::get_live_output_lanes(0), 0xFull);
+
+		// Fog shares O5 with three of the clip distances, only its lane is live
+		EXPECT_EQ(pass::get_live_output_lanes(CELL_GCM_ATTRIB_OUTPUT_MASK_FOG), 0xFull | (0x1ull << 20));
+
+		// Either face of the diffuse color keeps both color registers
+		EXPECT_EQ(pass::get_live_output_lanes(CELL_GCM_ATTRIB_OUTPUT_MASK_BACKDIFFUSE), 0xFull | (0xFull << 4) | (0xFull << 12));
+
+		// TEX8 lives in the last register
+		EXPECT_EQ(pass::get_live_output_lanes(CELL_GCM_ATTRIB_OUTPUT_MASK_TEX8), 0xFull | (0xFull << 60));
+	}
+}
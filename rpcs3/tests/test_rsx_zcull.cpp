@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include "Emu/RSX/RSXZCULL.h"
+#include "Emu/system_config.h"
+
+namespace rsx::reports
+{
+	static queued_report_write make_write(u32 sink, occlusion_query_info* query, u32 type = CELL_GCM_ZPASS_PIXEL_CNT)
+	{
+		queued_report_write writer{};
+		writer.type = type;
+		writer.query = query;
+		writer.sink = vm::addr_t{ sink };
+		return writer;
+	}
+
+	TEST(RSXZCULL, CollectPendingQueries_AllClaimed)
+	{
+		occlusion_query_info queries[4]{};
+		queries[0].num_draws = 1;
+		queries[1].num_draws = 0; // Nothing was drawn, the result is known without a readback
+		queries[2].num_draws = 3;
+		queries[3].num_draws = 2;
+
+		std::vector<queued_report_write> writes =
+		{
+			make_write(0x100, &queries[0]),
+			make_write(0x110, &queries[1]),
+			make_write(0x120, nullptr),                                 // Null query copying the last result
+			make_write(0x130, &queries[2], CELL_GCM_ZCULL_STATS),        // Not implemented, never read back
+			make_write(0x140, &queries[3], CELL_GCM_ZCULL_STATS3),
+			make_write(0, nullptr),                                     // Unclaimed, ends the batch
+		};
+
+		const query_stat_counter counters[1]{};
+
+		std::vector<occlusion_query_info*> batch;
+		collect_pending_queries(writes, counters, 0, batch);
+		EXPECT_EQ(batch, (std::vector<occlusion_query_info*>{ &queries[0], &queries[3] }));
+	}
+
+	TEST(RSXZCULL, CollectPendingQueries_StopAddress)
+	{
+		occlusion_query_info queries[3]{};
+		queries[0].num_draws = 1;
+		queries[1].num_draws = 1;
+		queries[2].num_draws = 1;
+
+		std::vector<queued_report_write> writes =
+		{
+			make_write(0x200, &queries[0]),
+			make_write(0x200, &queries[1]),
+			make_write(0x210, &queries[2]),
+		};
+
+		// The first write is forwarded to the second, collection continues until the final write to the address
+		writes[0].forwarder = &writes[1];
+
+		const query_stat_counter counters[1]{};
+
+		std::vector<occlusion_query_info*> batch = { &queries[2] };
+		collect_pending_queries(writes, counters, 0x200, batch);
+		EXPECT_EQ(batch, (std::vector<occlusion_query_info*>{ &queries[0], &queries[1] }));
+
+		collect_pending_queries(writes, counters, 0x210, batch);
+		EXPECT_EQ(batch.size(), 3u);
+	}
+
+	TEST(RSXZCULL, CollectPendingQueries_CounterHasResult)
+	{
+		occlusion_query_info queries[2]{};
+		queries[0].num_draws = 1;
+		queries[1].num_draws = 1;
+
+		std::vector<queued_report_write> writes =
+		{
+			make_write(0x300, &queries[0]),
+			make_write(0x310, &queries[1]),
+		};
+
+		// The first counter already has a hit, its query is discarded on retire and must not be waited on
+		writes[1].counter_tag = 1;
+		const query_stat_counter counters[2] = { { .result = 1 }, {} };
+
+		std::vector<occlusion_query_info*> batch;
+		collect_pending_queries(writes, counters, 0, batch);
+
+		if (g_cfg.video.precise_zpass_count)
+		{
+			EXPECT_EQ(batch, (std::vector<occlusion_query_info*>{ &queries[0], &queries[1] }));
+		}
+		else
+		{
+			EXPECT_EQ(batch, (std::vector<occlusion_query_info*>{ &queries[1] }));
+		}
+	}
+}
@@ -4,6 +4,10 @@
 #include "Emu/Cell/lv2/sys_fs.h"
 #undef private
 
+#include "Emu/IdManager.h"
+#include "Emu/VFS.h"
+#include "Emu/VFS_host_cache.h"
+
 using namespace utils;
 
 namespace utils
@@ -48,4 +52,82 @@ namespace utils
 		EXPECT_EQ(root, "dev_hdd0"sv);
 		EXPECT_EQ(trail, "NP1234568"sv);
 	}
+
+	// Virtual device with a single file which may or may not exist
+	struct stat_test_device final : fs::device_base
+	{
+		bool exists = false;
+		std::function<void()> on_stat;
+
+		bool stat(const std::string&, fs::stat_t& info) override
+		{
+			const bool existed = exists;
+
+			if (on_stat)
+			{
+				std::exchange(on_stat, nullptr)();
+			}
+
+			if (!existed)
+			{
+				fs::g_tls_error = fs::error::noent;
+				return false;
+			}
+
+			info = {};
+			info.size = 1;
+			return true;
+		}
+
+		bool statfs(const std::string&, fs::device_stat&) override { return false; }
+		std::unique_ptr<fs::file_base> open(const std::string&, bs_t<fs::open_mode>) override { return {}; }
+		std::unique_ptr<fs::dir_base> open_dir(const std::string&) override { return {}; }
+	};
+
+	TEST(cellFs, StatCacheInvalidation)
+	{
+		g_fxo->reset();
+		ensure(g_fxo->init<vfs_host_cache>());
+
+		const auto device = stx::make_shared<stat_test_device>();
+		fs::set_virtual_device("stat_test_dev", device);
+		const std::string path = device->fs_prefix + "stat_test_dev/file";
+
+		fs::stat_t info{};
+
+		// A lookup made while a modification is in progress sees the old state, it must not outlive the modification
+		{
+			const vfs::host_cache_guard cache_guard;
+			EXPECT_FALSE(vfs::get_stat_cached(path, info));
+			device->exists = true;
+		}
+
+		EXPECT_TRUE(vfs::get_stat_cached(path, info));
+		EXPECT_EQ(info.size, 1u);
+
+		// A modification made while a lookup is in progress
+		{
+			const vfs::host_cache_guard cache_guard;
+			device->exists = false;
+		}
+
+		device->on_stat = [&]()
+		{
+			const vfs::host_cache_guard cache_guard;
+			device->exists = true;
+		};
+
+		EXPECT_FALSE(vfs::get_stat_cached(path, info));
+		EXPECT_TRUE(vfs::get_stat_cached(path, info));
+
+		// Results are cached until the next modification
+		device->exists = false;
+		EXPECT_TRUE(vfs::get_stat_cached(path, info));
+
+		vfs::invalidate_host_cache();
+		EXPECT_FALSE(vfs::get_stat_cached(path, info));
+
+		fs::set_virtual_device("stat_test_dev", stx::shared_ptr<stat_test_device>());
+		g_fxo->clear();
+	}
 }